@@ -166,6 +166,40 @@ endif()
 # todo: detect Accelerate
 # todo: detect Cray libsci
 
+#---------------------------------------- OpenBLAS thread control
+# Batch routines set OpenBLAS's thread-local thread count (OpenBLAS >= 0.3.27)
+# for nested parallelism.
+if ("${blaspp_defs_}" MATCHES "HAVE_OPENBLAS")
+    message( STATUS "Checking for openblas_set_num_threads_local" )
+
+    try_run(
+        run_result compile_result ${CMAKE_CURRENT_BINARY_DIR}
+        SOURCES
+            "${CMAKE_CURRENT_SOURCE_DIR}/config/openblas_threads_local.cc"
+        LINK_LIBRARIES
+            ${BLAS_LIBRARIES} ${openmp_lib} # not "..." quoted; screws up OpenMP
+        COMPILE_DEFINITIONS
+            ${blaspp_defs_}
+        COMPILE_OUTPUT_VARIABLE
+            compile_output
+        RUN_OUTPUT_VARIABLE
+            run_output
+    )
+    # For cross-compiling, if it links, assume the run is okay.
+    if (CMAKE_CROSSCOMPILING AND compile_result)
+        message( DEBUG "cross: openblas_threads_local" )
+        set( run_result "0"  CACHE STRING "" FORCE )
+        set( run_output "ok" CACHE STRING "" FORCE )
+    endif()
+    debug_try_run( "openblas_threads_local.cc" "${compile_result}" "${compile_output}"
+                                               "${run_result}" "${run_output}" )
+
+    if (compile_result AND "${run_output}" MATCHES "ok")
+        message( "${blue}   Found openblas_set_num_threads_local${plain}" )
+        list( APPEND blaspp_defs_ "-DBLAS_HAVE_OPENBLAS_THREADS_LOCAL" )
+    endif()
+endif()
+
 #-------------------------------------------------------------------------------
 message( STATUS "Checking BLAS complex return type" )
 
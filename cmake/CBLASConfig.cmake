@@ -74,6 +74,47 @@ foreach (lib IN LISTS lib_list)
     endif()
 endforeach()
 
+#-------------------------------------------------------------------------------
+# Vendor batch entry points, used by CPU batch routines. Checked only in
+# MKL and OpenBLAS, and only when CBLAS is in the BLAS library itself,
+# since the BLAS++ library links with BLAS_LIBRARIES.
+if (blaspp_cblas_found AND "${blaspp_cblas_libraries}" STREQUAL ""
+    AND "${blaspp_defs_}" MATCHES "HAVE_MKL|HAVE_OPENBLAS")
+
+    foreach (routine IN ITEMS "gemm" "trsm")
+        message( STATUS "Checking for CBLAS ${routine}_batch" )
+
+        try_run(
+            run_result compile_result ${CMAKE_CURRENT_BINARY_DIR}
+            SOURCES
+                "${CMAKE_CURRENT_SOURCE_DIR}/config/cblas_${routine}_batch.cc"
+            LINK_LIBRARIES
+                ${BLAS_LIBRARIES} ${openmp_lib} # not "..." quoted; screws up OpenMP
+            COMPILE_DEFINITIONS
+                ${blaspp_defs_}
+            COMPILE_OUTPUT_VARIABLE
+                compile_output
+            RUN_OUTPUT_VARIABLE
+                run_output
+        )
+        # For cross-compiling, assume if it links, the run is okay.
+        if (CMAKE_CROSSCOMPILING AND compile_result)
+            message( DEBUG "cross: cblas_${routine}_batch" )
+            set( run_result "0"  CACHE STRING "" FORCE )
+            set( run_output "ok" CACHE STRING "" FORCE )
+        endif()
+        debug_try_run( "cblas_${routine}_batch.cc"
+                       "${compile_result}" "${compile_output}"
+                       "${run_result}" "${run_output}" )
+
+        if (compile_result AND "${run_output}" MATCHES "ok")
+            string( TOUPPER "${routine}" ROUTINE )
+            message( "${blue}   Found CBLAS ${routine}_batch${plain}" )
+            list( APPEND blaspp_defs_ "-DBLAS_HAVE_CBLAS_${ROUTINE}_BATCH" )
+        endif()
+    endforeach()
+endif()
+
 endif() # run_
 #===============================================================================
 
@@ -0,0 +1,40 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include <stdio.h>
+
+// Batch entry points are checked only in MKL and OpenBLAS,
+// using the same headers and integer type as src/cblas_internal.hh.
+#if defined(BLAS_HAVE_MKL)
+    #if defined(BLAS_ILP64) && ! defined(MKL_ILP64)
+        #define MKL_ILP64
+    #endif
+    #include <mkl_cblas.h>
+    typedef MKL_INT cblas_int;
+
+#elif defined(BLAS_HAVE_OPENBLAS)
+    extern "C" {
+    #include <cblas.h>
+    }
+    typedef blasint cblas_int;
+#endif
+
+int main()
+{
+    // C_i = A_i B_i for two 1x1 problems in one group.
+    double a[] = { 2, 3 }, b[] = { 5, 7 }, c[] = { 0, 0 };
+    const double* Aarray[] = { &a[0], &a[1] };
+    const double* Barray[] = { &b[0], &b[1] };
+    double*       Carray[] = { &c[0], &c[1] };
+    CBLAS_TRANSPOSE trans = CblasNoTrans;
+    cblas_int one = 1, group_size = 2;
+    double alpha = 1, beta = 0;
+    cblas_dgemm_batch( CblasColMajor, &trans, &trans, &one, &one, &one,
+                       &alpha, Aarray, &one, Barray, &one,
+                       &beta, Carray, &one, 1, &group_size );
+    bool okay = (c[0] == 10 && c[1] == 21);
+    printf( "%s\n", okay ? "ok" : "failed" );
+    return ! okay;
+}
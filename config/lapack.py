@@ -439,6 +439,25 @@ def cblas():
     config.environ.append( 'CXXFLAGS', define('HAVE_CBLAS') )
 # end cblas
 
+#-------------------------------------------------------------------------------
+def cblas_batch():
+    '''
+    Checks for vendor batch entry points, cblas_dgemm_batch and
+    cblas_dtrsm_batch, in MKL or OpenBLAS. Use cblas() first to find CBLAS.
+    '''
+    CXXFLAGS = config.environ['CXXFLAGS']
+    if (not re.search( r'HAVE_(MKL|OPENBLAS)\b', CXXFLAGS )):
+        return
+    for routine in ('gemm', 'trsm'):
+        (rc, out, err) = config.compile_run(
+            'config/cblas_' + routine + '_batch.cc', {},
+            'CBLAS ' + routine + '_batch in BLAS library' )
+        if (rc == 0):
+            config.environ.append(
+                'CXXFLAGS', define('HAVE_CBLAS_' + routine.upper() + '_BATCH') )
+    # end
+# end
+
 #-------------------------------------------------------------------------------
 # This code is structured similarly to blas().
 def lapack():
@@ -692,6 +711,23 @@ def openblas_version():
         config.print_result( 'OpenBLAS', rc )
 # end
 
+#-------------------------------------------------------------------------------
+def openblas_threads_local():
+    '''
+    Checks for openblas_set_num_threads_local (OpenBLAS >= 0.3.27),
+    used to set up nested parallelism in batch routines.
+    Use vendor_version() first to define HAVE_OPENBLAS.
+    '''
+    CXXFLAGS = config.environ['CXXFLAGS']
+    if (not re.search( r'HAVE_OPENBLAS\b', CXXFLAGS )):
+        return
+    (rc, out, err) = config.compile_run(
+        'config/openblas_threads_local.cc', {},
+        'openblas_set_num_threads_local in BLAS library' )
+    if (rc == 0):
+        config.environ.append( 'CXXFLAGS', define('HAVE_OPENBLAS_THREADS_LOCAL') )
+# end
+
 #-------------------------------------------------------------------------------
 def vendor_version():
     '''
@@ -0,0 +1,21 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include <stdio.h>
+
+// Same header as src/parallel.cc.
+extern "C" {
+#include <cblas.h> // openblas_set_num_threads_local
+}
+
+int main()
+{
+    // Sets the calling thread's count, returning its previous count.
+    int nt = openblas_set_num_threads_local( 1 );
+    openblas_set_num_threads_local( nt );
+    bool okay = (nt >= 0);
+    printf( "%s\n", okay ? "ok" : "failed" );
+    return ! okay;
+}
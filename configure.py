@@ -64,12 +64,16 @@ def main():
     config.lapack.blas_float_return()
     config.lapack.blas_complex_return()
     config.lapack.vendor_version()
+    config.lapack.openblas_threads_local()
 
     # Must test mkl_version before cblas and lapacke, to define HAVE_MKL.
     try:
         config.lapack.cblas()
+        config.lapack.cblas_batch()
+        if (config.environ['use_cblas'] in ('1', 'y', 'yes', 'true', 'on')):
+            config.environ.append( 'CXXFLAGS', config.define('USE_CBLAS') )
     except Error:
-        print_warn( 'BLAS++ needs CBLAS for testers.' )
+        print_warn( 'BLAS++ needs CBLAS for testers and use_cblas.' )
 
     try:
         config.lapack.lapack()
@@ -47,6 +47,7 @@ const char* blaspp_id();
 #include "blas/hemv.hh"
 #include "blas/her.hh"
 #include "blas/her2.hh"
+#include "blas/rot_sequence.hh"
 #include "blas/symv.hh"
 #include "blas/syr.hh"
 #include "blas/syr2.hh"
@@ -66,6 +67,11 @@ const char* blaspp_id();
 #include "blas/trmm.hh"
 #include "blas/trsm.hh"
 
+// =============================================================================
+// Compact batch template implementations
+
+#include "blas/batch_compact.hh"
+
 // =============================================================================
 // Device BLAS
 
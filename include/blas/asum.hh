@@ -12,12 +12,56 @@
 
 namespace blas {
 
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return sum of |Re(x_i)| + |Im(x_i)| over the n-element vector x.
+/// Uses independent accumulators per lane, reduced pairwise,
+/// so the loop vectorizes.
+///
+template <typename T>
+real_type<T> asum_sum(
+    int64_t n,
+    T const* x, int64_t incx )
+{
+    typedef real_type<T> real_t;
+
+    const int lanes = 8;
+    real_t sum_[ lanes ] = {};
+
+    int64_t i = 0;
+    if (incx == 1) {
+        // unit stride
+        for (; i + lanes <= n; i += lanes) {
+            for (int l = 0; l < lanes; ++l) {
+                sum_[ l ] += real_t( abs1( x[ i + l ] ) );
+            }
+        }
+    }
+    // remainder, or non-unit stride
+    for (; i < n; ++i) {
+        sum_[ 0 ] += real_t( abs1( x[ i*incx ] ) );
+    }
+
+    // pairwise reduction of lanes
+    for (int w = lanes/2; w > 0; w /= 2) {
+        for (int l = 0; l < w; ++l) {
+            sum_[ l ] += sum_[ l + w ];
+        }
+    }
+    return sum_[ 0 ];
+}
+
+}  // namespace internal
+
 // =============================================================================
 /// @return 1-norm of vector,
 ///     $|| Re(x) ||_1 + || Im(x) ||_1
 ///         = \sum_{i=0}^{n-1} |Re(x_i)| + |Im(x_i)|$.
 ///
 /// Generic implementation for arbitrary data types.
+/// Accumulates in independent lanes, reduced pairwise, so it vectorizes;
+/// long vectors are split across OpenMP threads.
 ///
 /// @param[in] n
 ///     Number of elements in x. n >= 0.
@@ -43,19 +87,15 @@ asum(
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
     real_t result = 0;
-    if (incx == 1) {
-        // unit stride
-        for (int64_t i = 0; i < n; ++i) {
-            result += abs1( x[i] );
-        }
-    }
-    else {
-        // non-unit stride
-        int64_t ix = 0;
-        for (int64_t i = 0; i < n; ++i) {
-            result += abs1( x[ix] );
-            ix += incx;
-        }
+
+    // blocks of x, each summed by asum_sum
+    const int64_t nb = 4096;
+
+    #pragma omp parallel for schedule(static) reduction(+:result) \
+                if (n >= internal::level1_omp_threshold)
+    for (int64_t i = 0; i < n; i += nb) {
+        result += internal::asum_sum( blas::min( nb, n - i ), &x[ i*incx ],
+                                      incx );
     }
     return result;
 }
@@ -0,0 +1,726 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_BATCH_COMPACT_HH
+#define BLAS_BATCH_COMPACT_HH
+
+#include "blas/util.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace blas {
+
+// =============================================================================
+// Compact batch format, for large batches of tiny (e.g., 4x4 to 16x16)
+// matrices of the same size, similar to MKL's compact API.
+//
+// Matrices are interleaved in groups of V = compact_width<scalar_t>():
+// element (i, j) of the V matrices in a group is stored contiguously,
+// so the kernels compute V problems at once, one per SIMD lane, with no
+// per-problem argument checks or calls. For complex, the V real parts
+// of an element are followed by its V imaginary parts. Within a group,
+// elements are ordered column-major, (i, j) at i + j*m for an m-by-n
+// matrix, regardless of the layout of the pointer-array batch it was
+// packed from. The last group is padded with copies of the last matrix,
+// so padding lanes stay finite.
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Lane operations on one element of a compact group: V reals, or for
+/// complex V real parts followed by V imaginary parts. The loops have
+/// compile-time extent V, so they vectorize across the batch.
+///
+template <typename scalar_t>
+struct CompactLanes {
+    using real_t = real_type<scalar_t>;
+
+    /// Matrices per group: one 512-bit register of reals.
+    static constexpr int64_t V = 64 / sizeof( real_t );
+
+    /// Reals per element of a group.
+    static constexpr int64_t S = (is_complex< scalar_t >::value ? 2*V : V);
+
+    /// acc += op(a) op(b), where op conjugates if conj_a or conj_b.
+    static void mul_add(
+        real_t* acc, real_t const* a, bool conj_a,
+        real_t const* b, bool conj_b )
+    {
+        if constexpr (is_complex< scalar_t >::value) {
+            real_t sa = (conj_a ? -1 : 1);
+            real_t sb = (conj_b ? -1 : 1);
+            for (int64_t v = 0; v < V; ++v) {
+                real_t ai = sa*a[ v+V ];
+                real_t bi = sb*b[ v+V ];
+                acc[ v   ] += a[ v ]*b[ v ] - ai*bi;
+                acc[ v+V ] += a[ v ]*bi + ai*b[ v ];
+            }
+        }
+        else {
+            for (int64_t v = 0; v < V; ++v)
+                acc[ v ] += a[ v ]*b[ v ];
+        }
+    }
+
+    /// x -= op(a) b, where op conjugates if conj_a.
+    static void mul_sub( real_t* x, real_t const* a, bool conj_a,
+                         real_t const* b )
+    {
+        if constexpr (is_complex< scalar_t >::value) {
+            real_t sa = (conj_a ? -1 : 1);
+            real_t t[ S ];
+            for (int64_t v = 0; v < V; ++v) {
+                real_t ai = sa*a[ v+V ];
+                t[ v   ] = x[ v   ] - (a[ v ]*b[ v ] - ai*b[ v+V ]);
+                t[ v+V ] = x[ v+V ] - (a[ v ]*b[ v+V ] + ai*b[ v ]);
+            }
+            for (int64_t v = 0; v < S; ++v)
+                x[ v ] = t[ v ];
+        }
+        else {
+            // x may alias a or b; loads precede stores, so this vectorizes
+            real_t t[ S ];
+            for (int64_t v = 0; v < V; ++v)
+                t[ v ] = x[ v ] - a[ v ]*b[ v ];
+            for (int64_t v = 0; v < S; ++v)
+                x[ v ] = t[ v ];
+        }
+    }
+
+    /// x /= op(d), where op conjugates if conj_d.
+    /// Complex division uses Smith's method, scaling by the larger of
+    /// |Re(d)| and |Im(d)|, so |d|^2 doesn't overflow or underflow.
+    static void div( real_t* x, real_t const* d, bool conj_d )
+    {
+        if constexpr (is_complex< scalar_t >::value) {
+            real_t sd = (conj_d ? -1 : 1);
+            for (int64_t v = 0; v < V; ++v) {
+                real_t dr = d[ v ], di = sd*d[ v+V ];
+                real_t xr = x[ v ], xi = x[ v+V ];
+                bool big_r = std::abs( dr ) >= std::abs( di );
+                real_t r   = (big_r ? di / dr : dr / di);
+                real_t den = (big_r ? dr + di*r : di + dr*r);
+                real_t pr  = (big_r ? xr + xi*r : xr*r + xi);
+                real_t pi  = (big_r ? xi - xr*r : xi*r - xr);
+                x[ v   ] = pr / den;
+                x[ v+V ] = pi / den;
+            }
+        }
+        else {
+            real_t t[ S ];
+            for (int64_t v = 0; v < V; ++v)
+                t[ v ] = x[ v ] / d[ v ];
+            for (int64_t v = 0; v < S; ++v)
+                x[ v ] = t[ v ];
+        }
+    }
+
+    /// x = alpha acc + beta x; if beta = 0, x is not read.
+    static void update( real_t* x, scalar_t alpha, real_t const* acc,
+                        scalar_t beta )
+    {
+        real_t ar = real( alpha ), ai = imag( alpha );
+        real_t br = real( beta ),  bi = imag( beta );
+        if constexpr (is_complex< scalar_t >::value) {
+            for (int64_t v = 0; v < V; ++v) {
+                real_t sr = ar*acc[ v ] - ai*acc[ v+V ];
+                real_t si = ar*acc[ v+V ] + ai*acc[ v ];
+                if (beta != scalar_t( 0 )) {
+                    sr += br*x[ v ] - bi*x[ v+V ];
+                    si += br*x[ v+V ] + bi*x[ v ];
+                }
+                x[ v   ] = sr;
+                x[ v+V ] = si;
+            }
+        }
+        else {
+            if (beta == scalar_t( 0 )) {
+                for (int64_t v = 0; v < V; ++v)
+                    x[ v ] = ar*acc[ v ];
+            }
+            else {
+                for (int64_t v = 0; v < V; ++v)
+                    x[ v ] = ar*acc[ v ] + br*x[ v ];
+            }
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+/// Whether a compact routine with the given total work, in multiply-adds,
+/// splits its groups across OpenMP threads.
+inline bool compact_parallel( int64_t groups, int64_t work )
+{
+    return groups > 1 && work >= level2_omp_threshold;
+}
+
+//------------------------------------------------------------------------------
+/// gemm on one compact group; see batch::gemm_compact.
+template <typename scalar_t>
+void gemm_compact_group(
+    blas::Op transA, blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha,
+    real_type<scalar_t> const* A,
+    real_type<scalar_t> const* B,
+    scalar_t beta,
+    real_type<scalar_t>*       C )
+{
+    using lanes = CompactLanes<scalar_t>;
+    using real_t = real_type<scalar_t>;
+    constexpr int64_t S = lanes::S;
+
+    // alpha = 0: C = beta C, without reading A or B
+    if (alpha == scalar_t( 0 )) {
+        real_t zero[ S ] = {};
+        for (int64_t e = 0; e < m*n; ++e)
+            lanes::update( &C[ e*S ], alpha, zero, beta );
+        return;
+    }
+
+    bool conjA = (transA == Op::ConjTrans);
+    bool conjB = (transB == Op::ConjTrans);
+    auto Ail = [&]( int64_t i, int64_t l ) {
+        return &A[ (transA == Op::NoTrans ? i + l*m : l + i*k)*S ];
+    };
+    auto Blj = [&]( int64_t l, int64_t j ) {
+        return &B[ (transB == Op::NoTrans ? l + j*k : j + l*n)*S ];
+    };
+
+    // two columns of C at a time, so each element of A is loaded once
+    // for both
+    real_t acc0[ S ], acc1[ S ];
+    int64_t j = 0;
+    for (; j + 2 <= n; j += 2) {
+        for (int64_t i = 0; i < m; ++i) {
+            for (int64_t v = 0; v < S; ++v) {
+                acc0[ v ] = 0;
+                acc1[ v ] = 0;
+            }
+            for (int64_t l = 0; l < k; ++l) {
+                real_t const* a = Ail( i, l );
+                lanes::mul_add( acc0, a, conjA, Blj( l, j   ), conjB );
+                lanes::mul_add( acc1, a, conjA, Blj( l, j+1 ), conjB );
+            }
+            lanes::update( &C[ (i + j*m)*S ],     alpha, acc0, beta );
+            lanes::update( &C[ (i + (j+1)*m)*S ], alpha, acc1, beta );
+        }
+    }
+    for (; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            for (int64_t v = 0; v < S; ++v)
+                acc0[ v ] = 0;
+            for (int64_t l = 0; l < k; ++l)
+                lanes::mul_add( acc0, Ail( i, l ), conjA, Blj( l, j ), conjB );
+            lanes::update( &C[ (i + j*m)*S ], alpha, acc0, beta );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// trsm on one compact group; see batch::trsm_compact.
+/// A is na-by-na, with na = m if side = Left, else n.
+template <typename scalar_t>
+void trsm_compact_group(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    real_type<scalar_t> const* A,
+    real_type<scalar_t>*       B )
+{
+    using lanes = CompactLanes<scalar_t>;
+    constexpr int64_t S = lanes::S;
+
+    int64_t na = (side == Side::Left ? m : n);
+    bool lower_op = ((uplo == Uplo::Lower) == (trans == Op::NoTrans));
+    bool conjA = (trans == Op::ConjTrans);
+    bool unit  = (diag == Diag::Unit);
+    // element (i, l) of op(A), element (i, j) of B
+    auto opA = [&]( int64_t i, int64_t l ) {
+        return &A[ (trans == Op::NoTrans ? i + l*na : l + i*na)*S ];
+    };
+    auto Bij = [&]( int64_t i, int64_t j ) {
+        return &B[ (i + j*m)*S ];
+    };
+
+    // alpha = 0: B = 0, without reading A; scaling B by 0 would keep
+    // NaN or Inf in B
+    if (alpha == scalar_t( 0 )) {
+        std::fill( B, B + m*n*S, real_type<scalar_t>( 0 ) );
+        return;
+    }
+
+    if (alpha != scalar_t( 1 )) {
+        for (int64_t e = 0; e < m*n; ++e)
+            lanes::update( &B[ e*S ], alpha, &B[ e*S ], scalar_t( 0 ) );
+    }
+
+    if (side == Side::Left) {
+        // op(A) X = B, by columns of B
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t q = 0; q < m; ++q) {
+                int64_t i = (lower_op ? q : m-1 - q);
+                int64_t l0 = (lower_op ? 0 : i+1);
+                int64_t l1 = (lower_op ? i : m);
+                for (int64_t l = l0; l < l1; ++l)
+                    lanes::mul_sub( Bij( i, j ), opA( i, l ), conjA, Bij( l, j ) );
+                if (! unit)
+                    lanes::div( Bij( i, j ), opA( i, i ), conjA );
+            }
+        }
+    }
+    else {
+        // X op(A) = B, by columns of X: forward if op(A) is upper
+        for (int64_t q = 0; q < n; ++q) {
+            int64_t j = (lower_op ? n-1 - q : q);
+            int64_t l0 = (lower_op ? j+1 : 0);
+            int64_t l1 = (lower_op ? n : j);
+            for (int64_t l = l0; l < l1; ++l) {
+                for (int64_t i = 0; i < m; ++i)
+                    lanes::mul_sub( Bij( i, j ), opA( l, j ), conjA, Bij( i, l ) );
+            }
+            if (! unit) {
+                for (int64_t i = 0; i < m; ++i)
+                    lanes::div( Bij( i, j ), opA( j, j ), conjA );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// trmm on one compact group; see batch::trmm_compact.
+/// A is na-by-na, with na = m if side = Left, else n.
+/// B is overwritten in an order such that each element is read by
+/// all its products before it is overwritten.
+template <typename scalar_t>
+void trmm_compact_group(
+    blas::Side side, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    real_type<scalar_t> const* A,
+    real_type<scalar_t>*       B )
+{
+    using lanes = CompactLanes<scalar_t>;
+    using real_t = real_type<scalar_t>;
+    constexpr int64_t V = lanes::V;
+    constexpr int64_t S = lanes::S;
+
+    int64_t na = (side == Side::Left ? m : n);
+    bool lower_op = ((uplo == Uplo::Lower) == (trans == Op::NoTrans));
+    bool conjA = (trans == Op::ConjTrans);
+    bool unit  = (diag == Diag::Unit);
+    auto opA = [&]( int64_t i, int64_t l ) {
+        return &A[ (trans == Op::NoTrans ? i + l*na : l + i*na)*S ];
+    };
+    auto Bij = [&]( int64_t i, int64_t j ) {
+        return &B[ (i + j*m)*S ];
+    };
+
+    // alpha = 0: B = 0, without reading A
+    if (alpha == scalar_t( 0 )) {
+        std::fill( B, B + m*n*S, real_t( 0 ) );
+        return;
+    }
+
+    // lanes of the real constant 1, for the unit diagonal
+    real_t one[ S ] = {};
+    for (int64_t v = 0; v < V; ++v)
+        one[ v ] = 1;
+
+    real_t acc[ S ];
+    if (side == Side::Left) {
+        // B = alpha op(A) B: row i uses rows l >= i if op(A) is upper,
+        // so go down; l <= i if lower, so go up.
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t q = 0; q < m; ++q) {
+                int64_t i = (lower_op ? m-1 - q : q);
+                for (int64_t v = 0; v < S; ++v)
+                    acc[ v ] = 0;
+                lanes::mul_add( acc, (unit ? one : opA( i, i )), conjA,
+                                Bij( i, j ), false );
+                int64_t l0 = (lower_op ? 0 : i+1);
+                int64_t l1 = (lower_op ? i : m);
+                for (int64_t l = l0; l < l1; ++l)
+                    lanes::mul_add( acc, opA( i, l ), conjA, Bij( l, j ), false );
+                lanes::update( Bij( i, j ), alpha, acc, scalar_t( 0 ) );
+            }
+        }
+    }
+    else {
+        // B = alpha B op(A): column j uses columns l <= j if op(A) is
+        // upper, so go right to left; l >= j if lower, so left to right.
+        for (int64_t q = 0; q < n; ++q) {
+            int64_t j = (lower_op ? q : n-1 - q);
+            int64_t l0 = (lower_op ? j+1 : 0);
+            int64_t l1 = (lower_op ? n : j);
+            for (int64_t i = 0; i < m; ++i) {
+                for (int64_t v = 0; v < S; ++v)
+                    acc[ v ] = 0;
+                lanes::mul_add( acc, (unit ? one : opA( j, j )), conjA,
+                                Bij( i, j ), false );
+                for (int64_t l = l0; l < l1; ++l)
+                    lanes::mul_add( acc, opA( l, j ), conjA, Bij( i, l ), false );
+                lanes::update( Bij( i, j ), alpha, acc, scalar_t( 0 ) );
+            }
+        }
+    }
+}
+
+}  // namespace internal
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// @return number of matrices interleaved in each group of the compact
+/// format: 64 bytes of reals, e.g., 8 for double and complex<double>.
+///
+/// @ingroup batch_compact
+template <typename scalar_t>
+constexpr int64_t compact_width()
+{
+    return internal::CompactLanes<scalar_t>::V;
+}
+
+//------------------------------------------------------------------------------
+/// @return number of scalar_t elements to hold batch_size m-by-n
+/// matrices in compact format, including padding of the last group.
+///
+/// @ingroup batch_compact
+template <typename scalar_t>
+int64_t compact_size( int64_t m, int64_t n, size_t batch_size )
+{
+    int64_t V = compact_width<scalar_t>();
+    int64_t groups = (int64_t( batch_size ) + V - 1) / V;
+    return groups * V * m * n;
+}
+
+// =============================================================================
+/// Pack a batch of m-by-n matrices from pointer-array format into
+/// compact format. See compact_size for the size of Ac.
+///
+/// @param[in] layout
+///     Matrix storage of each Aarray[ b ], Layout::ColMajor or Layout::RowMajor.
+///
+/// @param[in] m
+///     Number of rows of each matrix. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each matrix. n >= 0.
+///
+/// @param[in] Aarray
+///     Array of batch_size pointers to m-by-n matrices, each stored in an
+///     lda-by-n array [RowMajor: m-by-lda].
+///
+/// @param[in] lda
+///     Leading dimension of each matrix.
+///     If ColMajor: lda >= max(1, m) [RowMajor: lda >= max(1, n)].
+///
+/// @param[out] Ac
+///     The matrices in compact format, of size compact_size( m, n, batch_size ).
+///
+/// @param[in] batch_size
+///     Number of matrices.
+///
+/// @ingroup batch_compact
+
+template <typename scalar_t>
+void pack_compact(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    std::vector<scalar_t*> const& Aarray, int64_t lda,
+    scalar_t* Ac,
+    size_t batch_size )
+{
+    using real_t = real_type<scalar_t>;
+    using lanes = internal::CompactLanes<scalar_t>;
+    constexpr int64_t V = lanes::V;
+    constexpr int64_t S = lanes::S;
+
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( lda < (layout == Layout::ColMajor ? m : n) );
+    blas_error_if( Aarray.size() < batch_size );
+
+    if (batch_size == 0)
+        return;
+
+    int64_t groups = (int64_t( batch_size ) + V - 1) / V;
+    real_t* Ar = (real_t*) Ac;
+
+    #pragma omp parallel for schedule(static) \
+            if (internal::compact_parallel( groups, groups*V*m*n ))
+    for (int64_t g = 0; g < groups; ++g) {
+        // padding lanes copy the last matrix
+        scalar_t const* Av[ V ];
+        for (int64_t v = 0; v < V; ++v)
+            Av[ v ] = Aarray[ blas::min( g*V + v, int64_t( batch_size ) - 1 ) ];
+
+        // gather each element from V matrices, so stores are contiguous
+        real_t* Ag = &Ar[ g*m*n*S ];
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                int64_t ij = (layout == Layout::ColMajor ? i + j*lda : j + i*lda);
+                real_t* e = &Ag[ (i + j*m)*S ];
+                for (int64_t v = 0; v < V; ++v) {
+                    scalar_t a = Av[ v ][ ij ];
+                    e[ v ] = real( a );
+                    if constexpr (is_complex< scalar_t >::value)
+                        e[ v+V ] = imag( a );
+                }
+            }
+        }
+    }
+}
+
+// =============================================================================
+/// Unpack a batch of m-by-n matrices from compact format into
+/// pointer-array format; the inverse of pack_compact.
+/// Arguments are as in pack_compact, with Ac input and Aarray output.
+///
+/// @ingroup batch_compact
+
+template <typename scalar_t>
+void unpack_compact(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    scalar_t const* Ac,
+    std::vector<scalar_t*> const& Aarray, int64_t lda,
+    size_t batch_size )
+{
+    using real_t = real_type<scalar_t>;
+    using lanes = internal::CompactLanes<scalar_t>;
+    constexpr int64_t V = lanes::V;
+    constexpr int64_t S = lanes::S;
+
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( lda < (layout == Layout::ColMajor ? m : n) );
+    blas_error_if( Aarray.size() < batch_size );
+
+    int64_t groups = (int64_t( batch_size ) + V - 1) / V;
+    real_t const* Ar = (real_t const*) Ac;
+
+    #pragma omp parallel for schedule(static) \
+            if (internal::compact_parallel( groups, groups*V*m*n ))
+    for (int64_t g = 0; g < groups; ++g) {
+        int64_t nv = blas::min( V, int64_t( batch_size ) - g*V );
+        scalar_t* Av[ V ];
+        for (int64_t v = 0; v < nv; ++v)
+            Av[ v ] = Aarray[ g*V + v ];
+
+        real_t const* Ag = &Ar[ g*m*n*S ];
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                int64_t ij = (layout == Layout::ColMajor ? i + j*lda : j + i*lda);
+                real_t const* e = &Ag[ (i + j*m)*S ];
+                for (int64_t v = 0; v < nv; ++v) {
+                    if constexpr (is_complex< scalar_t >::value)
+                        Av[ v ][ ij ] = scalar_t( e[ v ], e[ v+V ] );
+                    else
+                        Av[ v ][ ij ] = e[ v ];
+                }
+            }
+        }
+    }
+}
+
+// =============================================================================
+/// Compact batched general matrix-matrix multiply:
+/// \[
+///     C_b = \alpha op(A_b) \times op(B_b) + \beta C_b,
+/// \]
+/// for b = 0, ..., batch_size-1, with matrices in the compact format of
+/// pack_compact. A is stored m-by-k if transA = NoTrans, else k-by-m;
+/// B is stored k-by-n if transB = NoTrans, else n-by-k; C is m-by-n.
+/// Intended for large batches of tiny matrices; the kernel computes
+/// compact_width() problems at once, vectorized across the batch.
+///
+/// @param[in] transA, transB
+///     The operations op(A) and op(B): Op::NoTrans, Op::Trans, or Op::ConjTrans.
+///
+/// @param[in] m, n, k
+///     Dimensions of each problem. m, n, k >= 0.
+///
+/// @param[in] alpha, beta
+///     Scalars, the same for all problems.
+///     If beta is zero, C need not be set on input.
+///
+/// @param[in] Ac, Bc
+///     Batches of A and B matrices, in compact format.
+///
+/// @param[in, out] Cc
+///     Batch of C matrices, in compact format.
+///
+/// @param[in] batch_size
+///     Number of problems.
+///
+/// @ingroup batch_compact
+
+template <typename scalar_t>
+void gemm_compact(
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    scalar_type<scalar_t> alpha,
+    scalar_t const* Ac,
+    scalar_t const* Bc,
+    scalar_type<scalar_t> beta,
+    scalar_t*       Cc,
+    size_t batch_size )
+{
+    using real_t = real_type<scalar_t>;
+    using lanes = internal::CompactLanes<scalar_t>;
+    constexpr int64_t V = lanes::V;
+    constexpr int64_t S = lanes::S;
+
+    // check arguments
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    int64_t groups = (int64_t( batch_size ) + V - 1) / V;
+    real_t const* A = (real_t const*) Ac;
+    real_t const* B = (real_t const*) Bc;
+    real_t*       C = (real_t*)       Cc;
+
+    #pragma omp parallel for schedule(static) \
+            if (internal::compact_parallel( groups, groups*V*m*n*k ))
+    for (int64_t g = 0; g < groups; ++g) {
+        internal::gemm_compact_group< scalar_t >(
+            transA, transB, m, n, k,
+            alpha, &A[ g*m*k*S ], &B[ g*k*n*S ], beta, &C[ g*m*n*S ] );
+    }
+}
+
+// =============================================================================
+/// Compact batched triangular solve:
+/// \[
+///     op(A_b) X_b = \alpha B_b   \text{ or }   X_b op(A_b) = \alpha B_b,
+/// \]
+/// for b = 0, ..., batch_size-1, with matrices in the compact format of
+/// pack_compact. Each X_b overwrites B_b. A is m-by-m if side = Left,
+/// else n-by-n; only its uplo triangle is accessed. B is m-by-n.
+/// Arguments are as in trsm, without layout or leading dimensions.
+/// No pivoting or scaling is done; the diagonal must be nonzero.
+///
+/// @ingroup batch_compact
+
+template <typename scalar_t>
+void trsm_compact(
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    scalar_type<scalar_t> alpha,
+    scalar_t const* Ac,
+    scalar_t*       Bc,
+    size_t batch_size )
+{
+    using real_t = real_type<scalar_t>;
+    using lanes = internal::CompactLanes<scalar_t>;
+    constexpr int64_t V = lanes::V;
+    constexpr int64_t S = lanes::S;
+
+    // check arguments
+    blas_error_if( side != Side::Left &&
+                   side != Side::Right );
+    blas_error_if( uplo != Uplo::Lower &&
+                   uplo != Uplo::Upper );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( diag != Diag::NonUnit &&
+                   diag != Diag::Unit );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    int64_t na = (side == Side::Left ? m : n);
+    int64_t groups = (int64_t( batch_size ) + V - 1) / V;
+    real_t const* A = (real_t const*) Ac;
+    real_t*       B = (real_t*)       Bc;
+
+    #pragma omp parallel for schedule(static) \
+            if (internal::compact_parallel( groups, groups*V*m*n*na ))
+    for (int64_t g = 0; g < groups; ++g) {
+        internal::trsm_compact_group< scalar_t >(
+            side, uplo, trans, diag, m, n,
+            alpha, &A[ g*na*na*S ], &B[ g*m*n*S ] );
+    }
+}
+
+// =============================================================================
+/// Compact batched triangular matrix-matrix multiply:
+/// \[
+///     B_b = \alpha op(A_b) B_b   \text{ or }   B_b = \alpha B_b op(A_b),
+/// \]
+/// for b = 0, ..., batch_size-1, with matrices in the compact format of
+/// pack_compact. A is m-by-m if side = Left, else n-by-n; only its uplo
+/// triangle is accessed. B is m-by-n.
+/// Arguments are as in trmm, without layout or leading dimensions.
+///
+/// @ingroup batch_compact
+
+template <typename scalar_t>
+void trmm_compact(
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    scalar_type<scalar_t> alpha,
+    scalar_t const* Ac,
+    scalar_t*       Bc,
+    size_t batch_size )
+{
+    using real_t = real_type<scalar_t>;
+    using lanes = internal::CompactLanes<scalar_t>;
+    constexpr int64_t V = lanes::V;
+    constexpr int64_t S = lanes::S;
+
+    // check arguments
+    blas_error_if( side != Side::Left &&
+                   side != Side::Right );
+    blas_error_if( uplo != Uplo::Lower &&
+                   uplo != Uplo::Upper );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( diag != Diag::NonUnit &&
+                   diag != Diag::Unit );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    int64_t na = (side == Side::Left ? m : n);
+    int64_t groups = (int64_t( batch_size ) + V - 1) / V;
+    real_t const* A = (real_t const*) Ac;
+    real_t*       B = (real_t*)       Bc;
+
+    #pragma omp parallel for schedule(static) \
+            if (internal::compact_parallel( groups, groups*V*m*n*na ))
+    for (int64_t g = 0; g < groups; ++g) {
+        internal::trmm_compact_group< scalar_t >(
+            side, uplo, trans, diag, m, n,
+            alpha, &A[ g*na*na*S ], &B[ g*m*n*S ] );
+    }
+}
+
+}  // namespace batch
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_BATCH_COMPACT_HH
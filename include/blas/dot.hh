@@ -9,14 +9,183 @@
 #include "blas/util.hh"
 
 #include <limits>
+#include <vector>
 
 namespace blas {
 
+namespace internal {
+
+/// Number of independent accumulators in dot_sums.
+const int dot_lanes = 8;
+
+/// Block length summed by one dot_sums call; block sums are added pairwise.
+const int64_t dot_block = 4096;
+
+//------------------------------------------------------------------------------
+/// Computes the dot product of n-element vectors x and y,
+/// $x^H y$ if conj_x, else $x^T y$,
+/// returning its real and imaginary parts in re and im.
+/// Strides may be negative; x and y point to elements x(0) and y(0).
+///
+/// Element i is added to accumulator lane i mod dot_lanes, for any stride,
+/// and lanes are reduced pairwise, so each sum has about
+/// n/dot_lanes + log2(dot_lanes) roundings. The unit-stride loop vectorizes.
+/// Complex products are expanded into real arithmetic, avoiding the
+/// NaN recovery in std::complex multiplication.
+///
+template <bool conj_x, typename TX, typename TY>
+void dot_sums(
+    int64_t n,
+    TX const* x, int64_t incx,
+    TY const* y, int64_t incy,
+    real_type<TX, TY>& re, real_type<TX, TY>& im )
+{
+    typedef scalar_type<TX, TY> scalar_t;
+    typedef real_type<TX, TY> real_t;
+
+    const int lanes = dot_lanes;
+    real_t re_[ lanes ] = {};
+    real_t im_[ lanes ] = {};
+
+    int64_t i = 0;
+    if constexpr (is_complex<scalar_t>::value) {
+        const real_t sign = conj_x ? -1 : 1;
+        auto add = [&]( int l, TX const& xv, TY const& yv ) {
+            real_t xr = real_t( real( xv ) );
+            real_t xi = real_t( imag( xv ) ) * sign;
+            real_t yr = real_t( real( yv ) );
+            real_t yi = real_t( imag( yv ) );
+            re_[ l ] += xr*yr - xi*yi;
+            im_[ l ] += xr*yi + xi*yr;
+        };
+        if (incx == 1 && incy == 1) {
+            // unit stride
+            for (; i + lanes <= n; i += lanes) {
+                for (int l = 0; l < lanes; ++l) {
+                    add( l, x[ i + l ], y[ i + l ] );
+                }
+            }
+        }
+        else {
+            // non-unit stride
+            for (; i + lanes <= n; i += lanes) {
+                for (int l = 0; l < lanes; ++l) {
+                    add( l, x[ (i + l)*incx ], y[ (i + l)*incy ] );
+                }
+            }
+        }
+        // remainder
+        for (int l = 0; i < n; ++i, ++l) {
+            add( l, x[ i*incx ], y[ i*incy ] );
+        }
+    }
+    else {
+        if (incx == 1 && incy == 1) {
+            // unit stride
+            for (; i + lanes <= n; i += lanes) {
+                for (int l = 0; l < lanes; ++l) {
+                    re_[ l ] += scalar_t( x[ i + l ] ) * scalar_t( y[ i + l ] );
+                }
+            }
+        }
+        else {
+            // non-unit stride
+            for (; i + lanes <= n; i += lanes) {
+                for (int l = 0; l < lanes; ++l) {
+                    re_[ l ] += scalar_t( x[ (i + l)*incx ] )
+                              * scalar_t( y[ (i + l)*incy ] );
+                }
+            }
+        }
+        // remainder
+        for (int l = 0; i < n; ++i, ++l) {
+            re_[ l ] += scalar_t( x[ i*incx ] ) * scalar_t( y[ i*incy ] );
+        }
+    }
+
+    // pairwise reduction of lanes
+    for (int w = lanes/2; w > 0; w /= 2) {
+        for (int l = 0; l < w; ++l) {
+            re_[ l ] += re_[ l + w ];
+            im_[ l ] += im_[ l + w ];
+        }
+    }
+    re = re_[ 0 ];
+    im = im_[ 0 ];
+}
+
+//------------------------------------------------------------------------------
+/// Computes the dot product of n-element vectors x and y,
+/// $x^H y$ if conj_x, else $x^T y$, as in dot and dotu.
+/// Arguments are checked by the caller.
+/// Long vectors are split into blocks of dot_block elements, summed by
+/// dot_sums across OpenMP threads. Block sums are then added pairwise,
+/// so the error bound grows as
+/// dot_block/dot_lanes + log2(dot_lanes) + log2(n/dot_block) roundings,
+/// logarithmically in n rather than linearly as in serial summation.
+///
+template <bool conj_x, typename TX, typename TY>
+scalar_type<TX, TY> dot(
+    int64_t n,
+    TX const* x, int64_t incx,
+    TY const* y, int64_t incy )
+{
+    typedef scalar_type<TX, TY> scalar_t;
+    typedef real_type<TX, TY> real_t;
+
+    // point to x(0) and y(0) for negative strides
+    if (incx < 0)
+        x += (-n + 1)*incx;
+    if (incy < 0)
+        y += (-n + 1)*incy;
+
+    real_t re = 0, im = 0;
+
+    // blocks of x and y, each summed by dot_sums
+    const int64_t nb = dot_block;
+    int64_t nblocks = (n + nb - 1) / nb;
+
+    if (nblocks <= 1) {
+        dot_sums<conj_x>( n, x, incx, y, incy, re, im );
+    }
+    else {
+        std::vector<real_t> re_( nblocks ), im_( nblocks );
+
+        #pragma omp parallel for schedule(static) \
+                    if (n >= level1_omp_threshold)
+        for (int64_t b = 0; b < nblocks; ++b) {
+            int64_t i = b*nb;
+            dot_sums<conj_x>( blas::min( nb, n - i ),
+                              &x[ i*incx ], incx, &y[ i*incy ], incy,
+                              re_[ b ], im_[ b ] );
+        }
+
+        // pairwise reduction of block sums, as a binary tree
+        for (int64_t w = 1; w < nblocks; w *= 2) {
+            for (int64_t b = 0; b + w < nblocks; b += 2*w) {
+                re_[ b ] += re_[ b + w ];
+                im_[ b ] += im_[ b + w ];
+            }
+        }
+        re = re_[ 0 ];
+        im = im_[ 0 ];
+    }
+
+    if constexpr (is_complex<scalar_t>::value)
+        return scalar_t( re, im );
+    else
+        return re;
+}
+
+}  // namespace internal
+
 // =============================================================================
 /// @return dot product, $x^H y$.
 /// @see dotu for unconjugated version, $x^T y$.
 ///
 /// Generic implementation for arbitrary data types.
+/// Accumulates in independent lanes, so it vectorizes; long vectors are
+/// split into blocks across OpenMP threads, whose sums are added pairwise.
 ///
 /// @param[in] n
 ///     Number of elements in x and y. n >= 0.
@@ -43,31 +212,12 @@ scalar_type<TX, TY> dot(
     TX const *x, int64_t incx,
     TY const *y, int64_t incy )
 {
-    typedef scalar_type<TX, TY> scalar_t;
-
     // check arguments
     blas_error_if( n < 0 );
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
-    scalar_t result = 0;
-    if (incx == 1 && incy == 1) {
-        // unit stride
-        for (int64_t i = 0; i < n; ++i) {
-            result += conj(x[i]) * y[i];
-        }
-    }
-    else {
-        // non-unit stride
-        int64_t ix = (incx > 0 ? 0 : (-n + 1)*incx);
-        int64_t iy = (incy > 0 ? 0 : (-n + 1)*incy);
-        for (int64_t i = 0; i < n; ++i) {
-            result += conj(x[ix]) * y[iy];
-            ix += incx;
-            iy += incy;
-        }
-    }
-    return result;
+    return internal::dot<true>( n, x, incx, y, incy );
 }
 
 }  // namespace blas
@@ -7,6 +7,7 @@
 #define BLAS_DOTU_HH
 
 #include "blas/util.hh"
+#include "blas/dot.hh"
 
 #include <limits>
 
@@ -17,6 +18,8 @@ namespace blas {
 /// @see dot for conjugated version, $x^H y$.
 ///
 /// Generic implementation for arbitrary data types.
+/// Accumulates in independent lanes, so it vectorizes; long vectors are
+/// split into blocks across OpenMP threads, whose sums are added pairwise.
 ///
 /// @param[in] n
 ///     Number of elements in x and y. n >= 0.
@@ -43,31 +46,12 @@ scalar_type<TX, TY> dotu(
     TX const *x, int64_t incx,
     TY const *y, int64_t incy )
 {
-    typedef scalar_type<TX, TY> scalar_t;
-
     // check arguments
     blas_error_if( n < 0 );
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
-    scalar_t result = 0;
-    if (incx == 1 && incy == 1) {
-        // unit stride
-        for (int64_t i = 0; i < n; ++i) {
-            result += x[i] * y[i];
-        }
-    }
-    else {
-        // non-unit stride
-        int64_t ix = (incx > 0 ? 0 : (-n + 1)*incx);
-        int64_t iy = (incy > 0 ? 0 : (-n + 1)*incy);
-        for (int64_t i = 0; i < n; ++i) {
-            result += x[ix] * y[iy];
-            ix += incx;
-            iy += incy;
-        }
-    }
-    return result;
+    return internal::dot<false>( n, x, incx, y, incy );
 }
 
 }  // namespace blas
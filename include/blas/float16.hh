@@ -0,0 +1,205 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_FLOAT16_HH
+#define BLAS_FLOAT16_HH
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace blas {
+
+// =============================================================================
+// 16-bit floating point storage types.
+//
+// float16 is IEEE 754 binary16 (1 sign, 5 exponent, 10 mantissa bits);
+// bfloat16 is the upper half of IEEE binary32 (1 sign, 8 exponent,
+// 7 mantissa bits). Both are storage-only: they convert implicitly to float,
+// and all arithmetic is done in float. scalar_type and real_type promote
+// them to float, so the generic templates widen 16-bit data to fp32 when
+// loading it and round back to 16 bits only when storing results.
+// Conversion from float rounds to nearest, ties to even.
+// The conversions are bit manipulation that picks special cases (NaN,
+// subnormals) with selects instead of branches or early returns,
+// so loops over 16-bit arrays can vectorize.
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return bits of float x.
+inline uint32_t float_to_bits( float x )
+{
+    uint32_t u;
+    std::memcpy( &u, &x, sizeof(u) );
+    return u;
+}
+
+//------------------------------------------------------------------------------
+/// @return float with bits u.
+inline float bits_to_float( uint32_t u )
+{
+    float x;
+    std::memcpy( &x, &u, sizeof(x) );
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/// @return binary16 bits of float x, rounded to nearest even.
+/// Handles subnormals, overflow to infinity, and NaN.
+/// After M. Dukhan, FP16 library (MIT license).
+inline uint16_t float_to_half_bits( float x )
+{
+    const float scale_to_inf  = 0x1.0p+112f;
+    const float scale_to_zero = 0x1.0p-110f;
+    float base = (std::abs( x ) * scale_to_inf) * scale_to_zero;
+
+    uint32_t w      = float_to_bits( x );
+    uint32_t shl1_w = w + w;
+    uint32_t sign   = w & 0x80000000u;
+    uint32_t bias   = shl1_w & 0xFF000000u;
+    bias = (bias < 0x71000000u ? 0x71000000u : bias);
+
+    base = bits_to_float( (bias >> 1) + 0x07800000u ) + base;
+    uint32_t bits          = float_to_bits( base );
+    uint32_t exp_bits      = (bits >> 13) & 0x00007C00u;
+    uint32_t mantissa_bits = bits & 0x00000FFFu;
+    uint32_t nonsign       = exp_bits + mantissa_bits;
+    return uint16_t( (sign >> 16)
+                     | (shl1_w > 0xFF000000u ? 0x7E00u : nonsign) );
+}
+
+//------------------------------------------------------------------------------
+/// @return float value of binary16 bits h. Exact.
+/// After M. Dukhan, FP16 library (MIT license).
+inline float half_bits_to_float( uint16_t h )
+{
+    uint32_t w     = uint32_t( h ) << 16;
+    uint32_t sign  = w & 0x80000000u;
+    uint32_t two_w = w + w;
+
+    const uint32_t exp_offset = 0xE0u << 23;
+    const float    exp_scale  = 0x1.0p-112f;
+    float normalized = bits_to_float( (two_w >> 4) + exp_offset ) * exp_scale;
+
+    const uint32_t magic_mask = 126u << 23;
+    const float    magic_bias = 0.5f;
+    float denormalized = bits_to_float( (two_w >> 17) | magic_mask ) - magic_bias;
+
+    const uint32_t denormalized_cutoff = 1u << 27;
+    uint32_t result = sign | (two_w < denormalized_cutoff
+                              ? float_to_bits( denormalized )
+                              : float_to_bits( normalized ));
+    return bits_to_float( result );
+}
+
+//------------------------------------------------------------------------------
+/// @return bfloat16 bits of float x, rounded to nearest even; NaN stays NaN.
+inline uint16_t float_to_bfloat16_bits( float x )
+{
+    uint32_t u       = float_to_bits( x );
+    uint32_t nan     = (u >> 16) | 0x0040u;  // quiet NaN
+    uint32_t rounded = (u + 0x7FFFu + ((u >> 16) & 1)) >> 16;
+    return uint16_t( (u & 0x7FFFFFFFu) > 0x7F800000u ? nan : rounded );
+}
+
+//------------------------------------------------------------------------------
+/// @return float value of bfloat16 bits h. Exact.
+inline float bfloat16_bits_to_float( uint16_t h )
+{
+    return bits_to_float( uint32_t( h ) << 16 );
+}
+
+}  // namespace internal
+
+//==============================================================================
+/// IEEE 754 binary16 (half precision) storage type.
+/// Converts implicitly to float; construction from float is explicit,
+/// but assignment and compound assignment from float are allowed,
+/// so results computed in float can be stored directly.
+///
+class float16 {
+public:
+    float16() = default;
+
+    /// Rounds x to the nearest float16.
+    explicit float16( float x ):
+        bits_( internal::float_to_half_bits( x ) )
+    {}
+
+    /// @return value as float. Exact.
+    operator float() const
+        { return internal::half_bits_to_float( bits_ ); }
+
+    float16& operator =  ( float x ) { return *this = float16( x ); }
+    float16& operator += ( float x ) { return *this = float16( float( *this ) + x ); }
+    float16& operator -= ( float x ) { return *this = float16( float( *this ) - x ); }
+    float16& operator *= ( float x ) { return *this = float16( float( *this ) * x ); }
+    float16& operator /= ( float x ) { return *this = float16( float( *this ) / x ); }
+
+    /// @return float16 with raw binary16 bits.
+    static float16 from_bits( uint16_t bits )
+    {
+        float16 x;
+        x.bits_ = bits;
+        return x;
+    }
+
+    /// @return raw binary16 bits.
+    uint16_t bits() const { return bits_; }
+
+private:
+    uint16_t bits_;
+};
+
+//==============================================================================
+/// bfloat16 (brain floating point) storage type: the upper 16 bits of
+/// an IEEE binary32, with float's exponent range and 8 bits of precision.
+/// Same conversions as float16.
+///
+class bfloat16 {
+public:
+    bfloat16() = default;
+
+    /// Rounds x to the nearest bfloat16.
+    explicit bfloat16( float x ):
+        bits_( internal::float_to_bfloat16_bits( x ) )
+    {}
+
+    /// @return value as float. Exact.
+    operator float() const
+        { return internal::bfloat16_bits_to_float( bits_ ); }
+
+    bfloat16& operator =  ( float x ) { return *this = bfloat16( x ); }
+    bfloat16& operator += ( float x ) { return *this = bfloat16( float( *this ) + x ); }
+    bfloat16& operator -= ( float x ) { return *this = bfloat16( float( *this ) - x ); }
+    bfloat16& operator *= ( float x ) { return *this = bfloat16( float( *this ) * x ); }
+    bfloat16& operator /= ( float x ) { return *this = bfloat16( float( *this ) / x ); }
+
+    /// @return bfloat16 with raw bits.
+    static bfloat16 from_bits( uint16_t bits )
+    {
+        bfloat16 x;
+        x.bits_ = bits;
+        return x;
+    }
+
+    /// @return raw bits.
+    uint16_t bits() const { return bits_; }
+
+private:
+    uint16_t bits_;
+};
+
+//------------------------------------------------------------------------------
+// Extend real and imag to the 16-bit types, as C++11 does for float.
+inline float real( float16  x ) { return float( x ); }
+inline float real( bfloat16 x ) { return float( x ); }
+inline float imag( float16  /* x */ ) { return 0; }
+inline float imag( bfloat16 /* x */ ) { return 0; }
+
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_FLOAT16_HH
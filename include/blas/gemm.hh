@@ -7,11 +7,123 @@
 #define BLAS_GEMM_HH
 
 #include "blas/util.hh"
+#include "blas/gemm_packed.hh"
 
 #include <limits>
 
 namespace blas {
 
+// =============================================================================
+/// Mixed-precision general matrix-matrix multiply:
+/// \[
+///     C = \alpha op(A) \times op(B) + \beta C,
+/// \]
+/// with the products op(A) op(B) computed in precision compute_t.
+/// Panels of op(A) and op(B) are converted to compute_t as they are packed,
+/// and accumulated in compute_t by the same micro-kernel as gemm;
+/// alpha, beta, and the update of C are applied in scalar_type<TA, TB, TC>.
+/// The precision is selected per call:
+///
+/// - A wider compute_t accumulates low-precision inputs in high precision,
+///   e.g., `gemm_mixed<double>( ... )` with float A and B and double C.
+/// - A narrower compute_t runs at low-precision speed when the tolerance
+///   allows, e.g., `gemm_mixed<float>( ... )` with double A, B, and C.
+///
+/// compute_t must be complex if and only if scalar_type<TA, TB, TC> is.
+/// gemm is gemm_mixed with compute_t = scalar_type<TA, TB, TC>.
+/// Arguments are the same as gemm.
+///
+/// @tparam compute_t
+///     Precision of packed panels and accumulation, e.g., float or double.
+///
+/// @ingroup gemm
+
+template <typename compute_t, typename TA, typename TB, typename TC>
+void gemm_mixed(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    scalar_type<TA, TB, TC> alpha,
+    TA const *A, int64_t lda,
+    TB const *B, int64_t ldb,
+    scalar_type<TA, TB, TC> beta,
+    TC       *C, int64_t ldc )
+{
+    // redirect if row major
+    if (layout == Layout::RowMajor) {
+        return gemm_mixed< compute_t >(
+             Layout::ColMajor,
+             transB,
+             transA,
+             n, m, k,
+             alpha,
+             B, ldb,
+             A, lda,
+             beta,
+             C, ldc);
+    }
+    else {
+        // check layout
+        blas_error_if_msg( layout != Layout::ColMajor,
+            "layout != Layout::ColMajor && layout != Layout::RowMajor" );
+    }
+
+    typedef blas::scalar_type<TA, TB, TC> scalar_t;
+
+    #define C(i_, j_) C[ (i_) + (j_)*ldc ]
+
+    // constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // check arguments
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    blas_error_if( lda < ((transA != Op::NoTrans) ? k : m) );
+    blas_error_if( ldb < ((transB != Op::NoTrans) ? n : k) );
+    blas_error_if( ldc < m );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    // alpha == zero or k == zero: C = beta C
+    if (alpha == zero || k == 0) {
+        if (beta == zero) {
+            for (int64_t j = 0; j < n; ++j) {
+                for (int64_t i = 0; i < m; ++i)
+                    C(i, j) = zero;
+            }
+        }
+        else if (beta != one) {
+            for (int64_t j = 0; j < n; ++j) {
+                for (int64_t i = 0; i < m; ++i)
+                    C(i, j) *= beta;
+            }
+        }
+        return;
+    }
+
+    // alpha != zero: packed, cache-blocked multiply;
+    // op(A) and op(B) are converted to compute_t as they are packed.
+    internal::gemm_packed< compute_t >(
+        m, n, k,
+        alpha, internal::OpView< compute_t, TA >( transA, A, lda ),
+               internal::OpView< compute_t, TB >( transB, B, ldb ),
+        beta,  C, ldc );
+
+    #undef C
+}
+
 // =============================================================================
 /// General matrix-matrix multiply:
 /// \[
@@ -25,6 +137,10 @@ namespace blas {
 /// $op(A)$ an m-by-k matrix, $op(B)$ a k-by-n matrix, and C an m-by-n matrix.
 ///
 /// Generic implementation for arbitrary data types.
+/// Panels of op(A) and op(B) are converted to the scalar type and packed
+/// into contiguous, cache-blocked buffers for a register-blocked
+/// micro-kernel; see blas/gemm_packed.hh, and gemm_mixed to select
+/// a different compute precision.
 ///
 /// @param[in] layout
 ///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -98,175 +214,9 @@ void gemm(
     scalar_type<TA, TB, TC> beta,
     TC       *C, int64_t ldc )
 {
-    // redirect if row major
-    if (layout == Layout::RowMajor) {
-        return gemm(
-             Layout::ColMajor,
-             transB,
-             transA,
-             n, m, k,
-             alpha,
-             B, ldb,
-             A, lda,
-             beta,
-             C, ldc);
-    }
-    else {
-        // check layout
-        blas_error_if_msg( layout != Layout::ColMajor,
-            "layout != Layout::ColMajor && layout != Layout::RowMajor" );
-    }
-
-    typedef blas::scalar_type<TA, TB, TC> scalar_t;
-
-    #define A(i_, j_) A[ (i_) + (j_)*lda ]
-    #define B(i_, j_) B[ (i_) + (j_)*ldb ]
-    #define C(i_, j_) C[ (i_) + (j_)*ldc ]
-
-    // constants
-    const scalar_t zero = 0;
-    const scalar_t one  = 1;
-
-    // check arguments
-    blas_error_if( transA != Op::NoTrans &&
-                   transA != Op::Trans &&
-                   transA != Op::ConjTrans );
-    blas_error_if( transB != Op::NoTrans &&
-                   transB != Op::Trans &&
-                   transB != Op::ConjTrans );
-    blas_error_if( m < 0 );
-    blas_error_if( n < 0 );
-    blas_error_if( k < 0 );
-
-    blas_error_if( lda < ((transA != Op::NoTrans) ? k : m) );
-    blas_error_if( ldb < ((transB != Op::NoTrans) ? n : k) );
-    blas_error_if( ldc < m );
-
-    // quick return
-    if (m == 0 || n == 0 || k == 0)
-        return;
-
-    // alpha == zero
-    if (alpha == zero) {
-        if (beta == zero) {
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i)
-                    C(i, j) = zero;
-            }
-        }
-        else if (beta != one) {
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i)
-                    C(i, j) *= beta;
-            }
-        }
-        return;
-    }
-
-    // alpha != zero
-    if (transA == Op::NoTrans) {
-        if (transB == Op::NoTrans) {
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i)
-                    C(i, j) *= beta;
-                for (int64_t l = 0; l < k; ++l) {
-                    scalar_t alpha_Blj = alpha*B(l, j);
-                    for (int64_t i = 0; i < m; ++i)
-                        C(i, j) += A(i, l)*alpha_Blj;
-                }
-            }
-        }
-        else if (transB == Op::Trans) {
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i)
-                    C(i, j) *= beta;
-                for (int64_t l = 0; l < k; ++l) {
-                    scalar_t alpha_Bjl = alpha*B(j, l);
-                    for (int64_t i = 0; i < m; ++i)
-                        C(i, j) += A(i, l)*alpha_Bjl;
-                }
-            }
-        }
-        else { // transB == Op::ConjTrans
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i)
-                    C(i, j) *= beta;
-                for (int64_t l = 0; l < k; ++l) {
-                    scalar_t alpha_Bjl = alpha*conj(B(j, l));
-                    for (int64_t i = 0; i < m; ++i)
-                        C(i, j) += A(i, l)*alpha_Bjl;
-                }
-            }
-        }
-    }
-    else if (transA == Op::Trans) {
-        if (transB == Op::NoTrans) {
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i) {
-                    scalar_t sum = zero;
-                    for (int64_t l = 0; l < k; ++l)
-                        sum += A(l, i)*B(l, j);
-                    C(i, j) = alpha*sum + beta*C(i, j);
-                }
-            }
-        }
-        else if (transB == Op::Trans) {
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i) {
-                    scalar_t sum = zero;
-                    for (int64_t l = 0; l < k; ++l)
-                        sum += A(l, i)*B(j, l);
-                    C(i, j) = alpha*sum + beta*C(i, j);
-                }
-            }
-        }
-        else { // transB == Op::ConjTrans
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i) {
-                    scalar_t sum = zero;
-                    for (int64_t l = 0; l < k; ++l)
-                        sum += A(l, i)*conj(B(j, l));
-                    C(i, j) = alpha*sum + beta*C(i, j);
-                }
-            }
-        }
-    }
-    else { // transA == Op::ConjTrans
-        if (transB == Op::NoTrans) {
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i) {
-                    scalar_t sum = zero;
-                    for (int64_t l = 0; l < k; ++l)
-                        sum += conj(A(l, i))*B(l, j);
-                    C(i, j) = alpha*sum + beta*C(i, j);
-                }
-            }
-        }
-        else if (transB == Op::Trans) {
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i) {
-                    scalar_t sum = zero;
-                    for (int64_t l = 0; l < k; ++l)
-                        sum += conj(A(l, i))*B(j, l);
-                    C(i, j) = alpha*sum + beta*C(i, j);
-                }
-            }
-        }
-        else { // transB == Op::ConjTrans
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i) {
-                    scalar_t sum = zero;
-                    for (int64_t l = 0; l < k; ++l)
-                        sum += A(l, i)*B(j, l); // little improvement here
-                    C(i, j) = alpha*conj(sum) + beta*C(i, j);
-                }
-            }
-        }
-    }
-
-    #undef A
-    #undef B
-    #undef C
+    gemm_mixed< scalar_type<TA, TB, TC> >(
+        layout, transA, transB, m, n, k,
+        alpha, A, lda, B, ldb, beta, C, ldc );
 }
 
 }  // namespace blas
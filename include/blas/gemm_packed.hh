@@ -0,0 +1,583 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_GEMM_PACKED_HH
+#define BLAS_GEMM_PACKED_HH
+
+#include "blas/util.hh"
+
+#include <vector>
+
+namespace blas {
+namespace internal {
+
+// =============================================================================
+// Cache-blocked, packed gemm engine used by the generic Level 3 templates.
+//
+// Follows the GotoBLAS / BLIS structure:
+//
+//     for jc = 0 : n : nc            -- nc columns of C and B   (L3 cache)
+//       for pc = 0 : k : kc          -- kc-deep rank-k update   (L1 / L2)
+//         pack B( pc : pc+kc, jc : jc+nc ) into nr-wide micro-panels
+//         for ic = 0 : m : mc        -- mc rows of C and A      (L2 cache)
+//           pack A( ic : ic+mc, pc : pc+kc ) into mr-tall micro-panels
+//           for each mr-by-nr micro-tile of C( ic, jc ):
+//             micro-kernel: kc rank-1 updates held in registers
+//
+// Elements are converted to scalar_t while packing, so every combination
+// of input types runs the same micro-kernel. Complex panels are packed
+// with the real and imaginary parts split, so the micro-kernel is pure
+// real arithmetic that the compiler can vectorize.
+
+//------------------------------------------------------------------------------
+/// Blocking sizes for the packed gemm engine, in elements of scalar_t.
+/// mr-by-nr is the register-blocked micro-tile; kc, mc, nc are the
+/// cache blocks. mc must be a multiple of mr and nc a multiple of nr.
+/// The generic sizes suit arbitrary (possibly non-arithmetic) types;
+/// the specializations target 256-bit and 512-bit SIMD registers.
+///
+template <typename scalar_t>
+struct GemmBlocking {
+    static constexpr int64_t mr =    4;
+    static constexpr int64_t nr =    4;
+    static constexpr int64_t kc =  256;
+    static constexpr int64_t mc =   64;
+    static constexpr int64_t nc = 2048;
+};
+
+template <>
+struct GemmBlocking< float > {
+    static constexpr int64_t mr =   24;
+    static constexpr int64_t nr =    4;
+    static constexpr int64_t kc =  384;
+    static constexpr int64_t mc =  192;
+    static constexpr int64_t nc = 4092;
+};
+
+template <>
+struct GemmBlocking< double > {
+    static constexpr int64_t mr =    8;
+    static constexpr int64_t nr =    6;
+    static constexpr int64_t kc =  256;
+    static constexpr int64_t mc =   96;
+    static constexpr int64_t nc = 4092;
+};
+
+template <>
+struct GemmBlocking< std::complex<float> > {
+    static constexpr int64_t mr =    4;
+    static constexpr int64_t nr =    4;
+    static constexpr int64_t kc =  256;
+    static constexpr int64_t mc =   96;
+    static constexpr int64_t nc = 2048;
+};
+
+template <>
+struct GemmBlocking< std::complex<double> > {
+    static constexpr int64_t mr =    4;
+    static constexpr int64_t nr =    4;
+    static constexpr int64_t kc =  192;
+    static constexpr int64_t mc =   64;
+    static constexpr int64_t nc = 2048;
+};
+
+//------------------------------------------------------------------------------
+/// Read-only view of op(X), where X is a column-major matrix of type T.
+/// Element (i, j) of op(X) is converted to scalar_t on access.
+/// Used as the source for packing A and B panels.
+///
+template <typename scalar_t, typename T>
+class OpView {
+public:
+    /// Constructs view of op(X), X stored in an ldx-by-* array.
+    OpView( blas::Op op, T const* X, int64_t ldx ):
+        X_( X ),
+        rs_( op == Op::NoTrans ? 1 : ldx ),
+        cs_( op == Op::NoTrans ? ldx : 1 ),
+        conj_( op == Op::ConjTrans )
+    {}
+
+    /// @return element (i, j) of op(X).
+    scalar_t operator() ( int64_t i, int64_t j ) const
+    {
+        using blas::conj;
+        scalar_t x = scalar_t( X_[ i*rs_ + j*cs_ ] );
+        return conj_ ? conj( x ) : x;
+    }
+
+private:
+    T const* X_;
+    int64_t rs_, cs_;
+    bool conj_;
+};
+
+//------------------------------------------------------------------------------
+/// Read-only view of the full symmetric or Hermitian matrix A, where only
+/// the uplo triangle of the column-major A of type T is stored.
+/// Elements from the other triangle are read from their transposed
+/// position, conjugated if Hermitian; a Hermitian diagonal is taken
+/// as real. Used as a packing source, so symm and hemm expand A into
+/// full packed panels and run the same micro-kernel as gemm.
+///
+template <typename scalar_t, typename T>
+class SymView {
+public:
+    /// Constructs view of A, with the uplo triangle stored in an
+    /// lda-by-* array. If hermitian, A is Hermitian, else symmetric.
+    SymView( blas::Uplo uplo, bool hermitian, T const* A, int64_t lda ):
+        A_( A ),
+        lda_( lda ),
+        lower_( uplo == Uplo::Lower ),
+        hermitian_( hermitian )
+    {}
+
+    /// @return element (i, j) of A.
+    scalar_t operator() ( int64_t i, int64_t j ) const
+    {
+        using blas::conj;
+        if (i == j) {
+            scalar_t a = scalar_t( A_[ i + j*lda_ ] );
+            return hermitian_ ? scalar_t( real( a ) ) : a;
+        }
+        else if ((i > j) == lower_) {
+            return scalar_t( A_[ i + j*lda_ ] );
+        }
+        else {
+            scalar_t a = scalar_t( A_[ j + i*lda_ ] );
+            return hermitian_ ? conj( a ) : a;
+        }
+    }
+
+private:
+    T const* A_;
+    int64_t lda_;
+    bool lower_;
+    bool hermitian_;
+};
+
+//------------------------------------------------------------------------------
+/// Number of reals per packed element: 2 for complex, else 1.
+template <typename scalar_t>
+constexpr int64_t pack_elems()
+{
+    return is_complex< scalar_t >::value ? 2 : 1;
+}
+
+//------------------------------------------------------------------------------
+/// Packs the mb-by-kb block of op(A) starting at (i0, p0) into micro-panels
+/// of mr rows. Within a micro-panel, column p is stored contiguously
+/// (real parts, then imaginary parts for complex); the last micro-panel
+/// is zero-padded to mr rows.
+///
+template <typename scalar_t, typename MatA>
+void gemm_pack_a(
+    MatA const& A, int64_t i0, int64_t p0, int64_t mb, int64_t kb,
+    real_type<scalar_t>* Ap )
+{
+    using real_t = real_type<scalar_t>;
+    constexpr int64_t mr = GemmBlocking<scalar_t>::mr;
+    const real_t zero = 0;
+
+    for (int64_t ir = 0; ir < mb; ir += mr) {
+        int64_t ib = blas::min( mr, mb - ir );
+        for (int64_t p = 0; p < kb; ++p) {
+            for (int64_t i = 0; i < ib; ++i) {
+                scalar_t a = A( i0 + ir + i, p0 + p );
+                if constexpr (is_complex< scalar_t >::value) {
+                    Ap[ i      ] = real( a );
+                    Ap[ i + mr ] = imag( a );
+                }
+                else {
+                    Ap[ i ] = a;
+                }
+            }
+            for (int64_t i = ib; i < mr; ++i) {
+                Ap[ i ] = zero;
+                if constexpr (is_complex< scalar_t >::value)
+                    Ap[ i + mr ] = zero;
+            }
+            Ap += mr * pack_elems<scalar_t>();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Packs the kb-by-nb block of op(B) starting at (p0, j0) into micro-panels
+/// of nr columns. Within a micro-panel, row p is stored contiguously
+/// (real parts, then imaginary parts for complex); the last micro-panel
+/// is zero-padded to nr columns.
+///
+template <typename scalar_t, typename MatB>
+void gemm_pack_b(
+    MatB const& B, int64_t p0, int64_t j0, int64_t kb, int64_t nb,
+    real_type<scalar_t>* Bp )
+{
+    using real_t = real_type<scalar_t>;
+    constexpr int64_t nr = GemmBlocking<scalar_t>::nr;
+    const real_t zero = 0;
+
+    for (int64_t jr = 0; jr < nb; jr += nr) {
+        int64_t jb = blas::min( nr, nb - jr );
+        for (int64_t p = 0; p < kb; ++p) {
+            for (int64_t j = 0; j < jb; ++j) {
+                scalar_t b = B( p0 + p, j0 + jr + j );
+                if constexpr (is_complex< scalar_t >::value) {
+                    Bp[ j      ] = real( b );
+                    Bp[ j + nr ] = imag( b );
+                }
+                else {
+                    Bp[ j ] = b;
+                }
+            }
+            for (int64_t j = jb; j < nr; ++j) {
+                Bp[ j ] = zero;
+                if constexpr (is_complex< scalar_t >::value)
+                    Bp[ j + nr ] = zero;
+            }
+            Bp += nr * pack_elems<scalar_t>();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Micro-kernel: computes the mr-by-nr product AB = Ap * Bp of an
+/// mr-by-kb packed micro-panel of A and a kb-by-nr packed micro-panel of B.
+/// AB is column-major with leading dimension mr; for complex, the
+/// imaginary parts follow the real parts at offset mr*nr.
+/// The accumulators have compile-time extent so they stay in registers
+/// and the i loop vectorizes.
+///
+template <typename scalar_t>
+void gemm_micro_kernel(
+    int64_t kb,
+    real_type<scalar_t> const* Ap,
+    real_type<scalar_t> const* Bp,
+    real_type<scalar_t>* AB )
+{
+    using real_t = real_type<scalar_t>;
+    constexpr int64_t mr = GemmBlocking<scalar_t>::mr;
+    constexpr int64_t nr = GemmBlocking<scalar_t>::nr;
+    const real_t zero = 0;
+
+    if constexpr (is_complex< scalar_t >::value) {
+        real_t cr[ mr*nr ], ci[ mr*nr ];
+        for (int64_t ij = 0; ij < mr*nr; ++ij) {
+            cr[ ij ] = zero;
+            ci[ ij ] = zero;
+        }
+        for (int64_t p = 0; p < kb; ++p) {
+            for (int64_t j = 0; j < nr; ++j) {
+                real_t br = Bp[ j ];
+                real_t bi = Bp[ j + nr ];
+                for (int64_t i = 0; i < mr; ++i) {
+                    cr[ i + j*mr ] += Ap[ i ]*br - Ap[ i + mr ]*bi;
+                    ci[ i + j*mr ] += Ap[ i ]*bi + Ap[ i + mr ]*br;
+                }
+            }
+            Ap += 2*mr;
+            Bp += 2*nr;
+        }
+        for (int64_t ij = 0; ij < mr*nr; ++ij) {
+            AB[ ij         ] = cr[ ij ];
+            AB[ ij + mr*nr ] = ci[ ij ];
+        }
+    }
+    else {
+        real_t c[ mr*nr ];
+        for (int64_t ij = 0; ij < mr*nr; ++ij)
+            c[ ij ] = zero;
+        for (int64_t p = 0; p < kb; ++p) {
+            for (int64_t j = 0; j < nr; ++j) {
+                real_t b = Bp[ j ];
+                for (int64_t i = 0; i < mr; ++i)
+                    c[ i + j*mr ] += Ap[ i ] * b;
+            }
+            Ap += mr;
+            Bp += nr;
+        }
+        for (int64_t ij = 0; ij < mr*nr; ++ij)
+            AB[ ij ] = c[ ij ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Stores the ib-by-jb leading part of micro-tile AB, computed in compute_t,
+/// into C: C = alpha AB + beta C, with the update done in scalar_t.
+/// If beta is zero, C is not read.
+///
+template <typename compute_t, typename scalar_t, typename TC>
+void gemm_micro_store(
+    int64_t ib, int64_t jb,
+    scalar_t alpha, real_type<compute_t> const* AB,
+    scalar_t beta, TC* C, int64_t ldc )
+{
+    constexpr int64_t mr = GemmBlocking<compute_t>::mr;
+    constexpr int64_t nr = GemmBlocking<compute_t>::nr;
+    const scalar_t zero = 0;
+
+    for (int64_t j = 0; j < jb; ++j) {
+        for (int64_t i = 0; i < ib; ++i) {
+            scalar_t ab;
+            if constexpr (is_complex< compute_t >::value)
+                ab = scalar_t( AB[ i + j*mr ], AB[ i + j*mr + mr*nr ] );
+            else
+                ab = scalar_t( AB[ i + j*mr ] );
+            if (beta == zero)
+                C[ i + j*ldc ] = TC( alpha*ab );
+            else
+                C[ i + j*ldc ] = TC( alpha*ab + beta*scalar_t( C[ i + j*ldc ] ) );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Packed, cache-blocked matrix multiply
+/// \[
+///     C = \alpha A B + \beta C,
+/// \]
+/// where A is an m-by-k and B is a k-by-n read-only view (e.g., OpView),
+/// and C is an m-by-n column-major matrix. If beta is zero, C is not read.
+/// Requires k > 0; callers handle quick returns and alpha = 0.
+///
+/// Panels are packed and multiplied in compute_t, which views A and B
+/// must return; alpha, beta, and the update of C are applied in scalar_t.
+/// Usually compute_t = scalar_t; a wider or narrower compute_t gives
+/// mixed-precision accumulation (see gemm_mixed).
+///
+template <typename compute_t, typename scalar_t,
+          typename MatA, typename MatB, typename TC>
+void gemm_packed(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha,
+    MatA const& A,
+    MatB const& B,
+    scalar_t beta,
+    TC* C, int64_t ldc )
+{
+    using real_t = real_type<compute_t>;
+    using blocking = GemmBlocking<compute_t>;
+    constexpr int64_t mr = blocking::mr;
+    constexpr int64_t nr = blocking::nr;
+    constexpr int64_t elems = pack_elems<compute_t>();
+    static_assert( is_complex< compute_t >::value == is_complex< scalar_t >::value,
+                   "compute_t and scalar_t must both be real or both complex" );
+    static_assert( blocking::mc % mr == 0 && blocking::nc % nr == 0,
+                   "GemmBlocking: mc must be a multiple of mr, nc of nr" );
+    const scalar_t one = 1;
+
+    // workspace, sized to the problem if it is smaller than the blocks
+    int64_t mc = blas::min( blocking::mc, (m + mr - 1) / mr * mr );
+    int64_t nc = blas::min( blocking::nc, (n + nr - 1) / nr * nr );
+    int64_t kc = blas::min( blocking::kc, k );
+    std::vector<real_t> Ap( mc*kc*elems );
+    std::vector<real_t> Bp( kc*nc*elems );
+    real_t AB[ mr*nr*elems ];
+
+    for (int64_t jc = 0; jc < n; jc += nc) {
+        int64_t nb = blas::min( nc, n - jc );
+        for (int64_t pc = 0; pc < k; pc += kc) {
+            int64_t kb = blas::min( kc, k - pc );
+            gemm_pack_b<compute_t>( B, pc, jc, kb, nb, Bp.data() );
+
+            // beta applies to the first rank-kb update only
+            scalar_t beta_ = (pc == 0 ? beta : one);
+
+            for (int64_t ic = 0; ic < m; ic += mc) {
+                int64_t mb = blas::min( mc, m - ic );
+                gemm_pack_a<compute_t>( A, ic, pc, mb, kb, Ap.data() );
+
+                for (int64_t jr = 0; jr < nb; jr += nr) {
+                    int64_t jb = blas::min( nr, nb - jr );
+                    real_t const* Bp_ = &Bp[ jr*kb*elems ];
+                    for (int64_t ir = 0; ir < mb; ir += mr) {
+                        int64_t ib = blas::min( mr, mb - ir );
+                        real_t const* Ap_ = &Ap[ ir*kb*elems ];
+                        gemm_micro_kernel<compute_t>( kb, Ap_, Bp_, AB );
+                        gemm_micro_store<compute_t>(
+                            ib, jb, alpha, AB, beta_,
+                            &C[ (ic + ir) + (jc + jr)*ldc ], ldc );
+                    }
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// View of the block of view M starting at (i0, j0).
+///
+template <typename Mat>
+class SubView {
+public:
+    SubView( Mat const& M, int64_t i0, int64_t j0 ):
+        M_( M ),
+        i0_( i0 ),
+        j0_( j0 )
+    {}
+
+    /// @return element (i, j) of the block, M( i0 + i, j0 + j ).
+    auto operator() ( int64_t i, int64_t j ) const
+    {
+        return M_( i0_ + i, j0_ + j );
+    }
+
+private:
+    Mat const& M_;
+    int64_t i0_, j0_;
+};
+
+//------------------------------------------------------------------------------
+/// View of [ X, Y ], where X and Y are m-by-k views: an m-by-2k matrix.
+/// Used with StackView to pack both rank-k terms of syr2k and her2k
+/// into one panel of depth 2k.
+///
+template <typename MatX, typename MatY>
+class ConcatView {
+public:
+    ConcatView( MatX const& X, MatY const& Y, int64_t k ):
+        X_( X ),
+        Y_( Y ),
+        k_( k )
+    {}
+
+    /// @return element (i, j) of [ X, Y ].
+    auto operator() ( int64_t i, int64_t j ) const
+    {
+        return j < k_ ? X_( i, j ) : Y_( i, j - k_ );
+    }
+
+private:
+    MatX const& X_;
+    MatY const& Y_;
+    int64_t k_;
+};
+
+//------------------------------------------------------------------------------
+/// View of [ alpha X; beta Y ], where X and Y are k-by-n views:
+/// a 2k-by-n matrix. The scaling is applied as elements are packed.
+///
+template <typename scalar_t, typename MatX, typename MatY>
+class StackView {
+public:
+    StackView( scalar_t alpha, MatX const& X, scalar_t beta, MatY const& Y,
+               int64_t k ):
+        X_( X ),
+        Y_( Y ),
+        alpha_( alpha ),
+        beta_( beta ),
+        k_( k )
+    {}
+
+    /// @return element (i, j) of [ alpha X; beta Y ].
+    scalar_t operator() ( int64_t i, int64_t j ) const
+    {
+        return i < k_ ? alpha_ * X_( i, j ) : beta_ * Y_( i - k_, j );
+    }
+
+private:
+    MatX const& X_;
+    MatY const& Y_;
+    scalar_t alpha_, beta_;
+    int64_t k_;
+};
+
+//------------------------------------------------------------------------------
+/// Triangular matrix multiply, updating only the uplo triangle of C:
+/// \[
+///     C = \alpha A B + \beta C,
+/// \]
+/// where A is an n-by-k and B is a k-by-n read-only view (e.g., OpView),
+/// and C is n-by-n column-major.
+/// Elements of C outside the triangle are neither computed nor accessed.
+/// If hermitian, the diagonal of C is real and its imaginary part is
+/// not read (as in herk). If beta is zero, C is not read.
+/// Requires k > 0 and uplo = Lower or Upper.
+///
+/// Recursively splits C = [ C11 C12; C21 C22 ]: the off-diagonal block in
+/// the triangle is one packed gemm, and diagonal blocks of nb or less are
+/// computed by a packed gemm into a workspace, then their triangle is
+/// stored. This computes about half the flops of a full gemm.
+///
+template <typename compute_t, typename scalar_t,
+          typename MatA, typename MatB, typename TC>
+void gemmt_packed(
+    blas::Uplo uplo,
+    int64_t n, int64_t k,
+    scalar_t alpha,
+    MatA const& A,
+    MatB const& B,
+    scalar_t beta,
+    TC* C, int64_t ldc,
+    bool hermitian,
+    int64_t j0 = 0 )
+{
+    // block size for diagonal blocks
+    const int64_t nb = 64;
+
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // this call computes C( j0 : j0+n, j0 : j0+n ), using rows j0 : j0+n
+    // of A and columns j0 : j0+n of B
+    SubView< MatA > A0( A, j0, 0 );
+    SubView< MatB > B0( B, 0, j0 );
+    TC* C0 = &C[ j0 + j0*ldc ];
+
+    if (n <= nb) {
+        // diagonal block: W = A B, then store the triangle
+        std::vector<scalar_t> W( n*n );
+        gemm_packed< compute_t >( n, n, k, one, A0, B0, zero, W.data(), n );
+
+        for (int64_t j = 0; j < n; ++j) {
+            int64_t ibegin = (uplo == Uplo::Lower ? j : 0);
+            int64_t iend   = (uplo == Uplo::Lower ? n : j + 1);
+            for (int64_t i = ibegin; i < iend; ++i) {
+                scalar_t c;
+                if (hermitian && i == j) {
+                    c = real( alpha*W[ i + j*n ] );
+                    if (beta != zero)
+                        c += beta*scalar_t( real( C0[ i + j*ldc ] ) );
+                }
+                else {
+                    c = alpha*W[ i + j*n ];
+                    if (beta != zero)
+                        c += beta*scalar_t( C0[ i + j*ldc ] );
+                }
+                C0[ i + j*ldc ] = TC( c );
+            }
+        }
+        return;
+    }
+
+    // split with n1 a multiple of nb
+    int64_t n1 = blas::max( nb, n / 2 / nb * nb );
+    int64_t n2 = n - n1;
+
+    gemmt_packed< compute_t >( uplo, n1, k, alpha, A, B, beta, C, ldc,
+                               hermitian, j0 );
+
+    if (uplo == Uplo::Lower) {
+        // C21 = alpha A( n1:n, : ) B( :, 0:n1 ) + beta C21
+        gemm_packed< compute_t >(
+            n2, n1, k,
+            alpha, SubView< MatA >( A, j0 + n1, 0 ), B0,
+            beta, &C0[ n1 ], ldc );
+    }
+    else {
+        // C12 = alpha A( 0:n1, : ) B( :, n1:n ) + beta C12
+        gemm_packed< compute_t >(
+            n1, n2, k,
+            alpha, A0, SubView< MatB >( B, 0, j0 + n1 ),
+            beta, &C0[ n1*ldc ], ldc );
+    }
+
+    gemmt_packed< compute_t >( uplo, n2, k, alpha, A, B, beta, C, ldc,
+                               hermitian, j0 + n1 );
+}
+
+}  // namespace internal
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_GEMM_PACKED_HH
@@ -9,9 +9,290 @@
 #include "blas/util.hh"
 
 #include <limits>
+#include <vector>
 
 namespace blas {
 
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return A_ij converted to scalar_t, conjugated if conj_A.
+template <bool conj_A, typename scalar_t, typename TA>
+inline scalar_t gemv_elem( TA a )
+{
+    if constexpr (conj_A)
+        return conj( scalar_t( a ) );
+    else
+        return scalar_t( a );
+}
+
+//------------------------------------------------------------------------------
+/// Computes y += alpha op(A) x for m-by-n A, where op(A) = A,
+/// or conj(A) if conj_A, and y is unit stride.
+/// x points to x(0) and may have any stride.
+///
+/// Processes 4 columns per pass, so each y_i is loaded and stored
+/// once per 4 columns instead of once per column.
+/// The caller blocks rows so the y chunk stays in cache across passes.
+///
+template <bool conj_A, typename TA, typename TX, typename scalar_t>
+void gemv_n_block(
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    TA const* A, int64_t lda,
+    TX const* x, int64_t incx,
+    scalar_t* y )
+{
+    int64_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        scalar_t t0 = alpha*scalar_t( x[ (j    )*incx ] );
+        scalar_t t1 = alpha*scalar_t( x[ (j + 1)*incx ] );
+        scalar_t t2 = alpha*scalar_t( x[ (j + 2)*incx ] );
+        scalar_t t3 = alpha*scalar_t( x[ (j + 3)*incx ] );
+        TA const* A0 = &A[ (j    )*lda ];
+        TA const* A1 = &A[ (j + 1)*lda ];
+        TA const* A2 = &A[ (j + 2)*lda ];
+        TA const* A3 = &A[ (j + 3)*lda ];
+        for (int64_t i = 0; i < m; ++i) {
+            y[ i ] += t0 * gemv_elem<conj_A, scalar_t>( A0[ i ] )
+                    + t1 * gemv_elem<conj_A, scalar_t>( A1[ i ] )
+                    + t2 * gemv_elem<conj_A, scalar_t>( A2[ i ] )
+                    + t3 * gemv_elem<conj_A, scalar_t>( A3[ i ] );
+        }
+    }
+    // remaining columns
+    for (; j < n; ++j) {
+        scalar_t t0 = alpha*scalar_t( x[ j*incx ] );
+        TA const* A0 = &A[ j*lda ];
+        for (int64_t i = 0; i < m; ++i) {
+            y[ i ] += t0 * gemv_elem<conj_A, scalar_t>( A0[ i ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Computes y += alpha op(A)^T x for m-by-n A, where op(A) = A,
+/// or conj(A) if conj_A, and x is unit stride.
+/// y points to y(0) and may have any stride.
+///
+/// Processes 4 columns per pass, so each x_i is loaded once per
+/// 4 columns. Each column's dot product uses independent accumulators
+/// per lane, reduced pairwise, so the loop vectorizes.
+///
+template <bool conj_A, typename TA, typename scalar_t, typename TY>
+void gemv_t_block(
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    TA const* A, int64_t lda,
+    scalar_t const* x,
+    TY* y, int64_t incy )
+{
+    const int lanes = 4;
+
+    int64_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        TA const* A0 = &A[ (j    )*lda ];
+        TA const* A1 = &A[ (j + 1)*lda ];
+        TA const* A2 = &A[ (j + 2)*lda ];
+        TA const* A3 = &A[ (j + 3)*lda ];
+        scalar_t s0[ lanes ] = {};
+        scalar_t s1[ lanes ] = {};
+        scalar_t s2[ lanes ] = {};
+        scalar_t s3[ lanes ] = {};
+        int64_t i = 0;
+        for (; i + lanes <= m; i += lanes) {
+            for (int l = 0; l < lanes; ++l) {
+                scalar_t xi = x[ i + l ];
+                s0[ l ] += gemv_elem<conj_A, scalar_t>( A0[ i + l ] ) * xi;
+                s1[ l ] += gemv_elem<conj_A, scalar_t>( A1[ i + l ] ) * xi;
+                s2[ l ] += gemv_elem<conj_A, scalar_t>( A2[ i + l ] ) * xi;
+                s3[ l ] += gemv_elem<conj_A, scalar_t>( A3[ i + l ] ) * xi;
+            }
+        }
+        // remaining rows
+        for (; i < m; ++i) {
+            scalar_t xi = x[ i ];
+            s0[ 0 ] += gemv_elem<conj_A, scalar_t>( A0[ i ] ) * xi;
+            s1[ 0 ] += gemv_elem<conj_A, scalar_t>( A1[ i ] ) * xi;
+            s2[ 0 ] += gemv_elem<conj_A, scalar_t>( A2[ i ] ) * xi;
+            s3[ 0 ] += gemv_elem<conj_A, scalar_t>( A3[ i ] ) * xi;
+        }
+        // pairwise reduction of lanes
+        for (int w = lanes/2; w > 0; w /= 2) {
+            for (int l = 0; l < w; ++l) {
+                s0[ l ] += s0[ l + w ];
+                s1[ l ] += s1[ l + w ];
+                s2[ l ] += s2[ l + w ];
+                s3[ l ] += s3[ l + w ];
+            }
+        }
+        y[ (j    )*incy ] += alpha*s0[ 0 ];
+        y[ (j + 1)*incy ] += alpha*s1[ 0 ];
+        y[ (j + 2)*incy ] += alpha*s2[ 0 ];
+        y[ (j + 3)*incy ] += alpha*s3[ 0 ];
+    }
+    // remaining columns
+    for (; j < n; ++j) {
+        TA const* A0 = &A[ j*lda ];
+        scalar_t s0[ lanes ] = {};
+        int64_t i = 0;
+        for (; i + lanes <= m; i += lanes) {
+            for (int l = 0; l < lanes; ++l) {
+                s0[ l ] += gemv_elem<conj_A, scalar_t>( A0[ i + l ] )
+                           * x[ i + l ];
+            }
+        }
+        for (; i < m; ++i) {
+            s0[ 0 ] += gemv_elem<conj_A, scalar_t>( A0[ i ] ) * x[ i ];
+        }
+        for (int w = lanes/2; w > 0; w /= 2) {
+            for (int l = 0; l < w; ++l) {
+                s0[ l ] += s0[ l + w ];
+            }
+        }
+        y[ j*incy ] += alpha*s0[ 0 ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Computes y += alpha op(A) x for column-major m-by-n A,
+/// where op(A) = A, or conj(A) if conj_A.
+/// Arguments are checked and y scaled by beta by the caller;
+/// x and y point to x(0) and y(0).
+///
+/// Rows are blocked so a chunk of y stays in cache while all n columns
+/// pass over it. If y is strided or narrower than scalar_t, the product
+/// is accumulated in a scalar_t workspace, then added to y once.
+/// With OpenMP, row blocks are divided among threads, which thus
+/// update disjoint parts of y.
+///
+template <bool conj_A, typename TA, typename TX, typename TY>
+void gemv_n(
+    int64_t m, int64_t n,
+    scalar_type<TA, TX, TY> alpha,
+    TA const* A, int64_t lda,
+    TX const* x, int64_t incx,
+    TY* y, int64_t incy )
+{
+    typedef scalar_type<TA, TX, TY> scalar_t;
+
+    const scalar_t zero = 0;
+
+    std::vector<scalar_t> w;
+    scalar_t* yw;
+    if constexpr (std::is_same< TY, scalar_t >::value) {
+        if (incy == 1) {
+            yw = y;
+        }
+        else {
+            w.assign( m, zero );
+            yw = w.data();
+        }
+    }
+    else {
+        w.assign( m, zero );
+        yw = w.data();
+    }
+
+    // row block size; y chunk of mb elements stays in L1 cache
+    const int64_t mb = 2048;
+
+    #pragma omp parallel for schedule(static) \
+                if (m*n >= level2_omp_threshold && m > mb)
+    for (int64_t i = 0; i < m; i += mb) {
+        gemv_n_block<conj_A>( blas::min( mb, m - i ), n, alpha,
+                              &A[ i ], lda, x, incx, &yw[ i ] );
+    }
+
+    if (! w.empty()) {
+        for (int64_t i = 0; i < m; ++i) {
+            y[ i*incy ] += w[ i ];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Computes y += alpha op(A)^T x for column-major m-by-n A,
+/// where op(A) = A, or conj(A) if conj_A.
+/// Arguments are checked and y scaled by beta by the caller;
+/// x and y point to x(0) and y(0).
+///
+/// Rows are blocked so a chunk of x stays in L2 cache while all n columns
+/// pass over it. If x is strided or narrower than scalar_t, it is first
+/// copied to a scalar_t workspace; if y is narrower than scalar_t,
+/// the product is accumulated in a workspace, then added to y once.
+/// With OpenMP, columns are divided among threads, which thus
+/// update disjoint parts of y; each thread keeps the same columns
+/// for every row block.
+///
+template <bool conj_A, typename TA, typename TX, typename TY>
+void gemv_t(
+    int64_t m, int64_t n,
+    scalar_type<TA, TX, TY> alpha,
+    TA const* A, int64_t lda,
+    TX const* x, int64_t incx,
+    TY* y, int64_t incy )
+{
+    typedef scalar_type<TA, TX, TY> scalar_t;
+
+    const scalar_t zero = 0;
+
+    std::vector<scalar_t> xw;
+    scalar_t const* xp;
+    if constexpr (std::is_same< TX, scalar_t >::value) {
+        if (incx == 1) {
+            xp = x;
+        }
+        else {
+            xw.resize( m );
+            for (int64_t i = 0; i < m; ++i)
+                xw[ i ] = x[ i*incx ];
+            xp = xw.data();
+        }
+    }
+    else {
+        xw.resize( m );
+        for (int64_t i = 0; i < m; ++i)
+            xw[ i ] = scalar_t( x[ i*incx ] );
+        xp = xw.data();
+    }
+
+    std::vector<scalar_t> w;
+    if constexpr (! std::is_same< TY, scalar_t >::value) {
+        w.assign( n, zero );
+    }
+
+    // row block size; x chunk of mb elements stays in L2 cache
+    const int64_t mb = 16384;
+    // columns per task
+    const int64_t nb = 16;
+
+    #pragma omp parallel if (m*n >= level2_omp_threshold && n > nb)
+    for (int64_t i = 0; i < m; i += mb) {
+        int64_t ib = blas::min( mb, m - i );
+        #pragma omp for schedule(static) nowait
+        for (int64_t j = 0; j < n; j += nb) {
+            int64_t jb = blas::min( nb, n - j );
+            if constexpr (std::is_same< TY, scalar_t >::value) {
+                gemv_t_block<conj_A>( ib, jb, alpha, &A[ i + j*lda ], lda,
+                                      &xp[ i ], &y[ j*incy ], incy );
+            }
+            else {
+                gemv_t_block<conj_A>( ib, jb, alpha, &A[ i + j*lda ], lda,
+                                      &xp[ i ], &w[ j ], 1 );
+            }
+        }
+    }
+
+    if constexpr (! std::is_same< TY, scalar_t >::value) {
+        for (int64_t j = 0; j < n; ++j) {
+            y[ j*incy ] += w[ j ];
+        }
+    }
+}
+
+}  // namespace internal
+
 // =============================================================================
 /// General matrix-vector multiply:
 /// \[
@@ -25,6 +306,9 @@ namespace blas {
 /// and A is an m-by-n matrix.
 ///
 /// Generic implementation for arbitrary data types.
+/// Processes 4 columns of A per pass, with rows blocked so the
+/// chunk of y (or x, for op(A) = A^T) stays in cache;
+/// large matrices are split across OpenMP threads.
 ///
 /// @param[in] layout
 ///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -88,8 +372,6 @@ void gemv(
 {
     typedef blas::scalar_type<TA, TX, TY> scalar_t;
 
-    #define A(i_, j_) A[ (i_) + (j_)*lda ]
-
     // constants
     const scalar_t zero = 0;
     const scalar_t one  = 1;
@@ -170,109 +452,26 @@ void gemv(
         return;
 
     // ----------
+    // x and y point to x(0) and y(0)
+    x += kx;
+    y += ky;
     if (trans == Op::NoTrans && ! doconj) {
         // form y += alpha * A * x
-        int64_t jx = kx;
-        if (incy == 1) {
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp = alpha*x[jx];
-                jx += incx;
-                for (int64_t i = 0; i < m; ++i) {
-                    y[i] += tmp * A(i, j);
-                }
-            }
-        }
-        else {
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp = alpha*x[jx];
-                jx += incx;
-                int64_t iy = ky;
-                for (int64_t i = 0; i < m; ++i) {
-                    y[iy] += tmp * A(i, j);
-                    iy += incy;
-                }
-            }
-        }
+        internal::gemv_n<false>( m, n, alpha, A, lda, x, incx, y, incy );
     }
-    else if (trans == Op::NoTrans && doconj) {
+    else if (trans == Op::NoTrans) {
         // form y += alpha * conj( A ) * x
         // this occurs for row-major A^H * x
-        int64_t jx = kx;
-        if (incy == 1) {
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp = alpha*x[jx];
-                jx += incx;
-                for (int64_t i = 0; i < m; ++i) {
-                    y[i] += tmp * conj(A(i, j));
-                }
-            }
-        }
-        else {
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp = alpha*x[jx];
-                jx += incx;
-                int64_t iy = ky;
-                for (int64_t i = 0; i < m; ++i) {
-                    y[iy] += tmp * conj(A(i, j));
-                    iy += incy;
-                }
-            }
-        }
+        internal::gemv_n<true>( m, n, alpha, A, lda, x, incx, y, incy );
     }
     else if (trans == Op::Trans) {
         // form y += alpha * A^T * x
-        int64_t jy = ky;
-        if (incx == 1) {
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp = zero;
-                for (int64_t i = 0; i < m; ++i) {
-                    tmp += A(i, j) * x[i];
-                }
-                y[jy] += alpha*tmp;
-                jy += incy;
-            }
-        }
-        else {
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp = zero;
-                int64_t ix = kx;
-                for (int64_t i = 0; i < m; ++i) {
-                    tmp += A(i, j) * x[ix];
-                    ix += incx;
-                }
-                y[jy] += alpha*tmp;
-                jy += incy;
-            }
-        }
+        internal::gemv_t<false>( m, n, alpha, A, lda, x, incx, y, incy );
     }
     else {
         // form y += alpha * A^H * x
-        int64_t jy = ky;
-        if (incx == 1) {
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp = zero;
-                for (int64_t i = 0; i < m; ++i) {
-                    tmp += conj(A(i, j)) * x[i];
-                }
-                y[jy] += alpha*tmp;
-                jy += incy;
-            }
-        }
-        else {
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp = zero;
-                int64_t ix = kx;
-                for (int64_t i = 0; i < m; ++i) {
-                    tmp += conj(A(i, j)) * x[ix];
-                    ix += incx;
-                }
-                y[jy] += alpha*tmp;
-                jy += incy;
-            }
-        }
+        internal::gemv_t<true>( m, n, alpha, A, lda, x, incx, y, incy );
     }
-
-    #undef A
 }
 
 }  // namespace blas
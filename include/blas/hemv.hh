@@ -8,6 +8,7 @@
 
 #include "blas/util.hh"
 #include "blas/symv.hh"
+#include "blas/symv.hh"
 
 #include <limits>
 
@@ -22,6 +23,8 @@ namespace blas {
 /// and A is an n-by-n Hermitian matrix.
 ///
 /// Generic implementation for arbitrary data types.
+/// Processes columns in pairs, reading each stored element of A once;
+/// large matrices are split across OpenMP threads.
 ///
 /// @param[in] layout
 ///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -78,8 +81,6 @@ void hemv(
 {
     typedef blas::scalar_type<TA, TX, TY> scalar_t;
 
-    #define A(i_, j_) A[ (i_) + (j_)*lda ]
-
     // constants
     const scalar_t zero = 0;
     const scalar_t one  = 1;
@@ -134,152 +135,17 @@ void hemv(
     if (alpha == zero)
         return;
 
+    // x and y point to x(0) and y(0)
     if (layout == Layout::ColMajor) {
-        if (uplo == Uplo::Upper) {
-            // A is stored in upper triangle
-            // form y += alpha * A * x
-            if (incx == 1 && incy == 1) {
-                // unit stride
-                for (int64_t j = 0; j < n; ++j) {
-                    scalar_t tmp1 = alpha*x[j];
-                    scalar_t tmp2 = zero;
-                    for (int64_t i = 0; i < j; ++i) {
-                        y[i] += tmp1 * A(i, j);
-                        tmp2 += conj( A(i, j) ) * x[i];
-                    }
-                    y[j] += tmp1 * real( A(j, j) ) + alpha * tmp2;
-                }
-            }
-            else {
-                // non-unit stride
-                int64_t jx = kx;
-                int64_t jy = ky;
-                for (int64_t j = 0; j < n; ++j) {
-                    scalar_t tmp1 = alpha*x[jx];
-                    scalar_t tmp2 = zero;
-                    int64_t ix = kx;
-                    int64_t iy = ky;
-                    for (int64_t i = 0; i < j; ++i) {
-                        y[iy] += tmp1 * A(i, j);
-                        tmp2 += conj( A(i, j) ) * x[ix];
-                        ix += incx;
-                        iy += incy;
-                    }
-                    y[jy] += tmp1 * real( A(j, j) ) + alpha * tmp2;
-                    jx += incx;
-                    jy += incy;
-                }
-            }
-        }
-        else if (uplo == Uplo::Lower) {
-            // A is stored in lower triangle
-            // form y += alpha * A * x
-            if (incx == 1 && incy == 1) {
-                for (int64_t j = 0; j < n; ++j) {
-                    scalar_t tmp1 = alpha*x[j];
-                    scalar_t tmp2 = zero;
-                    for (int64_t i = j+1; i < n; ++i) {
-                        y[i] += tmp1 * A(i, j);
-                        tmp2 += conj( A(i, j) ) * x[i];
-                    }
-                    y[j] += tmp1 * real( A(j, j) ) + alpha * tmp2;
-                }
-            }
-            else {
-                int64_t jx = kx;
-                int64_t jy = ky;
-                for (int64_t j = 0; j < n; ++j) {
-                    scalar_t tmp1 = alpha*x[jx];
-                    scalar_t tmp2 = zero;
-                    int64_t ix = jx;
-                    int64_t iy = jy;
-                    for (int64_t i = j+1; i < n; ++i) {
-                        ix += incx;
-                        iy += incy;
-                        y[iy] += tmp1 * A(i, j);
-                        tmp2 += conj( A(i, j) ) * x[ix];
-                    }
-                    y[jy] += tmp1 * real( A(j, j) ) + alpha * tmp2;
-                    jx += incx;
-                    jy += incy;
-                }
-            }
-        }
+        internal::symv<true, false>( uplo, n, alpha, A, lda, x + kx, incx,
+                                     y + ky, incy );
     }
     else {
-        if (uplo == Uplo::Lower) {
-            // A is stored in lower triangle
-            // form y += alpha * A * x
-            if (incx == 1 && incy == 1) {
-                // unit stride
-                for (int64_t j = 0; j < n; ++j) {
-                    scalar_t tmp1 = alpha*x[j];
-                    scalar_t tmp2 = zero;
-                    for (int64_t i = 0; i < j; ++i) {
-                        y[i] += tmp1 * conj( A(i, j) );
-                        tmp2 += A(i, j) * x[i];
-                    }
-                    y[j] += tmp1 * real( A(j, j) ) + alpha * tmp2;
-                }
-            }
-            else {
-                // non-unit stride
-                int64_t jx = kx;
-                int64_t jy = ky;
-                for (int64_t j = 0; j < n; ++j) {
-                    scalar_t tmp1 = alpha*x[jx];
-                    scalar_t tmp2 = zero;
-                    int64_t ix = kx;
-                    int64_t iy = ky;
-                    for (int64_t i = 0; i < j; ++i) {
-                        y[iy] += tmp1 * conj( A(i, j) );
-                        tmp2 += A(i, j) * x[ix];
-                        ix += incx;
-                        iy += incy;
-                    }
-                    y[jy] += tmp1 * real( A(j, j) ) + alpha * tmp2;
-                    jx += incx;
-                    jy += incy;
-                }
-            }
-        }
-        else if (uplo == Uplo::Upper) {
-            // A is stored in upper triangle
-            // form y += alpha * A * x
-            if (incx == 1 && incy == 1) {
-                for (int64_t j = 0; j < n; ++j) {
-                    scalar_t tmp1 = alpha*x[j];
-                    scalar_t tmp2 = zero;
-                    for (int64_t i = j+1; i < n; ++i) {
-                        y[i] += tmp1 * conj( A(i, j) );
-                        tmp2 += A(i, j) * x[i];
-                    }
-                    y[j] += tmp1 * real( A(j, j) ) + alpha * tmp2;
-                }
-            }
-            else {
-                int64_t jx = kx;
-                int64_t jy = ky;
-                for (int64_t j = 0; j < n; ++j) {
-                    scalar_t tmp1 = alpha*x[jx];
-                    scalar_t tmp2 = zero;
-                    int64_t ix = jx;
-                    int64_t iy = jy;
-                    for (int64_t i = j+1; i < n; ++i) {
-                        ix += incx;
-                        iy += incy;
-                        y[iy] += tmp1 * conj( A(i, j) );
-                        tmp2 += A(i, j) * x[ix];
-                    }
-                    y[jy] += tmp1 * real( A(j, j) ) + alpha * tmp2;
-                    jx += incx;
-                    jy += incy;
-                }
-            }
-        }
+        // row-major A is col-major A^T = conj( A ), with uplo swapped
+        uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+        internal::symv<true, true>( uplo, n, alpha, A, lda, x + kx, incx,
+                                    y + ky, incy );
     }
-
-    #undef A
 }
 
 }  // namespace blas
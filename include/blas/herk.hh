@@ -7,6 +7,7 @@
 #define BLAS_HERK_HH
 
 #include "blas/util.hh"
+#include "blas/gemm_packed.hh"
 #include "blas/syrk.hh"
 
 #include <limits>
@@ -26,6 +27,9 @@ namespace blas {
 /// and A is an n-by-k or k-by-n matrix.
 ///
 /// Generic implementation for arbitrary data types.
+/// Computes only the uplo triangle, blocked: diagonal blocks and the
+/// off-diagonal blocks in the triangle use the packed gemm engine
+/// (see blas/gemm_packed.hh), for about half the flops of gemm.
 ///
 /// @param[in] layout
 ///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -137,132 +141,38 @@ void herk(
     blas_error_if( ldc < n );
 
     // quick return
-    if (n == 0 || k == 0)
+    if (n == 0)
         return;
 
-    // alpha == zero
-    if (alpha == zero) {
-        if (beta == zero) {
-            if (uplo != Uplo::Upper) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i <= j; ++i)
-                        C(i, j) = szero;
-                }
-            }
-            else if (uplo != Uplo::Lower) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = j; i < n; ++i)
-                        C(i, j) = szero;
-                }
-            }
-            else {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i < n; ++i)
-                        C(i, j) = szero;
-                }
-            }
-        }
-        else if (beta != one) {
-            if (uplo != Uplo::Upper) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i < j; ++i)
-                        C(i, j) *= beta;
-                    C(j, j) = beta * real( C(j, j) );
-                }
-            }
-            else if (uplo != Uplo::Lower) {
-                for (int64_t j = 0; j < n; ++j) {
-                    C(j, j) = beta * real( C(j, j) );
-                    for (int64_t i = j+1; i < n; ++i)
-                        C(i, j) *= beta;
-                }
-            }
-            else {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i < j; ++i)
-                        C(i, j) *= beta;
+    // alpha == zero or k == zero: C = beta C on the uplo triangle
+    if (alpha == zero || k == 0) {
+        if (beta == one)
+            return;
+        for (int64_t j = 0; j < n; ++j) {
+            int64_t ibegin = (uplo == Uplo::Lower ? j : 0);
+            int64_t iend   = (uplo == Uplo::Upper ? j + 1 : n);
+            for (int64_t i = ibegin; i < iend; ++i) {
+                if (beta == zero)
+                    C(i, j) = szero;
+                else if (i == j)
                     C(j, j) = beta * real( C(j, j) );
-                    for (int64_t i = j+1; i < n; ++i)
-                        C(i, j) *= beta;
-                }
+                else
+                    C(i, j) *= beta;
             }
         }
         return;
     }
 
     // alpha != zero
-    if (trans == Op::NoTrans) {
-        if (uplo != Uplo::Lower) {
-            // uplo == Uplo::Upper or uplo == Uplo::General
-            for (int64_t j = 0; j < n; ++j) {
-
-                for (int64_t i = 0; i < j; ++i)
-                    C(i, j) *= beta;
-                C(j, j) = beta * real( C(j, j) );
-
-                for (int64_t l = 0; l < k; ++l) {
-
-                    scalar_t alpha_conj_Ajl = alpha*conj( A(j, l) );
-
-                    for (int64_t i = 0; i < j; ++i)
-                        C(i, j) += A(i, l)*alpha_conj_Ajl;
-                    C(j, j) += real( A(j, l) * alpha_conj_Ajl );
-                }
-            }
-        }
-        else { // uplo == Uplo::Lower
-            for (int64_t j = 0; j < n; ++j) {
-
-                C(j, j) = beta * real( C(j, j) );
-                for (int64_t i = j+1; i < n; ++i)
-                    C(i, j) *= beta;
-
-                for (int64_t l = 0; l < k; ++l) {
-
-                    scalar_t alpha_conj_Ajl = alpha*conj( A(j, l) );
-
-                    C(j, j) += real( A(j, l) * alpha_conj_Ajl );
-                    for (int64_t i = j+1; i < n; ++i) {
-                        C(i, j) += A(i, l) * alpha_conj_Ajl;
-                    }
-                }
-            }
-        }
-    }
-    else { // trans == Op::ConjTrans
-        if (uplo != Uplo::Lower) {
-            // uplo == Uplo::Upper or uplo == Uplo::General
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < j; ++i) {
-                    scalar_t sum = szero;
-                    for (int64_t l = 0; l < k; ++l)
-                        sum += conj( A(l, i) ) * A(l, j);
-                    C(i, j) = alpha*sum + beta*C(i, j);
-                }
-                real_t sum = zero;
-                for (int64_t l = 0; l < k; ++l)
-                    sum += real(A(l, j)) * real(A(l, j))
-                           + imag(A(l, j)) * imag(A(l, j));
-                C(j, j) = alpha*sum + beta*real( C(j, j) );
-            }
-        }
-        else {
-            // uplo == Uplo::Lower
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = j+1; i < n; ++i) {
-                    scalar_t sum = szero;
-                    for (int64_t l = 0; l < k; ++l)
-                        sum += conj( A(l, i) ) * A(l, j);
-                    C(i, j) = alpha*sum + beta*C(i, j);
-                }
-                real_t sum = zero;
-                for (int64_t l = 0; l < k; ++l)
-                    sum += real(A(l, j)) * real(A(l, j))
-                           + imag(A(l, j)) * imag(A(l, j));
-                C(j, j) = alpha*sum + beta*real( C(j, j) );
-            }
-        }
-    }
+    // compute only the uplo triangle (upper if General) with the packed
+    // gemm engine: C = alpha op(A) op(A)^H + beta C, with real diagonal
+    internal::gemmt_packed< scalar_t >(
+        (uplo == Uplo::Lower ? Uplo::Lower : Uplo::Upper), n, k,
+        scalar_t( alpha ),
+        internal::OpView< scalar_t, TA >( trans, A, lda ),
+        internal::OpView< scalar_t, TA >(
+            (trans == Op::NoTrans ? Op::ConjTrans : Op::NoTrans), A, lda ),
+        scalar_t( beta ), C, ldc, true );
 
     if (uplo == Uplo::General) {
         for (int64_t j = 0; j < n; ++j) {
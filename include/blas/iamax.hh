@@ -12,12 +12,135 @@
 
 namespace blas {
 
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Merges candidate (value, index) into the running max (vmax, imax),
+/// keeping the first index among equal values.
+///
+template <typename real_t>
+inline void iamax_merge(
+    real_t value, int64_t index,
+    real_t& vmax, int64_t& imax )
+{
+    if (value > vmax || (value == vmax && index < imax)) {
+        vmax = value;
+        imax = index;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Finds the first index of max |Re(x_i)| + |Im(x_i)| in the n-element
+/// vector x, returning it in imax and the max in vmax.
+/// Returns imax = -1, vmax = -1 if n = 0 (or all entries are NaN).
+///
+/// Each lane tracks its own max and index with selects, not branches,
+/// so the loop vectorizes; lanes are merged at the end.
+///
+template <typename T>
+void iamax_search(
+    int64_t n,
+    T const* x, int64_t incx,
+    real_type<T>& vmax, int64_t& imax )
+{
+    typedef real_type<T> real_t;
+
+    const int lanes = 8;
+    real_t  max_[ lanes ];
+    int64_t idx_[ lanes ];
+    for (int l = 0; l < lanes; ++l) {
+        max_[ l ] = -1;
+        idx_[ l ] = -1;
+    }
+
+    int64_t i = 0;
+    if (incx == 1) {
+        // unit stride
+        for (; i + lanes <= n; i += lanes) {
+            for (int l = 0; l < lanes; ++l) {
+                real_t a = real_t( abs1( x[ i + l ] ) );
+                bool greater = a > max_[ l ];
+                max_[ l ] = greater ? a     : max_[ l ];
+                idx_[ l ] = greater ? i + l : idx_[ l ];
+            }
+        }
+    }
+    // remainder, or non-unit stride; indices are after those in the lanes
+    for (; i < n; ++i) {
+        real_t a = real_t( abs1( x[ i*incx ] ) );
+        if (a > max_[ 0 ]) {
+            max_[ 0 ] = a;
+            idx_[ 0 ] = i;
+        }
+    }
+
+    vmax = max_[ 0 ];
+    imax = idx_[ 0 ];
+    for (int l = 1; l < lanes; ++l) {
+        iamax_merge( max_[ l ], idx_[ l ], vmax, imax );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return first index of max |Re(x_i)| + |Im(x_i)|, as in iamax.
+/// As in reference BLAS, a NaN in x_0 is returned; later NaN entries
+/// are skipped. Arguments are checked by the caller.
+/// Long vectors are split into blocks across OpenMP threads;
+/// each thread searches its blocks, then the threads' results are merged.
+///
+template <typename T>
+int64_t iamax( int64_t n, T const* x, int64_t incx )
+{
+    typedef real_type<T> real_t;
+
+    real_t  vmax = -1;
+    int64_t imax = -1;
+
+    // reference BLAS starts from |x_0|, which no entry exceeds if NaN
+    if (n > 0) {
+        real_t a0 = real_t( abs1( x[ 0 ] ) );
+        if (a0 != a0)
+            return 0;
+    }
+
+    // blocks of x, each searched by iamax_search
+    const int64_t nb = 4096;
+
+    #pragma omp parallel if (n >= level1_omp_threshold)
+    {
+        real_t  vmax_t = -1;
+        int64_t imax_t = -1;
+
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < n; i += nb) {
+            real_t  v;
+            int64_t k;
+            iamax_search( blas::min( nb, n - i ), &x[ i*incx ], incx, v, k );
+            if (k >= 0)
+                iamax_merge( v, i + k, vmax_t, imax_t );
+        }
+
+        #pragma omp critical
+        if (imax_t >= 0)
+            iamax_merge( vmax_t, imax_t, vmax, imax );
+    }
+
+    return imax;
+}
+
+}  // namespace internal
+
 // =============================================================================
 /// @return Index of infinity-norm of vector, $|| x ||_{inf}$,
 ///     $\text{argmax}_{i=0}^{n-1} |Re(x_i)| + |Im(x_i)|$.
 /// Returns -1 if n = 0.
+/// NaN entries are handled as in reference BLAS: if x_0 is NaN, returns 0;
+/// otherwise NaN entries are skipped, so the max is over the other entries.
+/// Optimized vendor BLAS may differ.
 ///
 /// Generic implementation for arbitrary data types.
+/// Each SIMD lane tracks its own max and index, merged at the end;
+/// long vectors are split across OpenMP threads.
 ///
 /// @param[in] n
 ///     Number of elements in x. n >= 0.
@@ -35,37 +158,48 @@ int64_t iamax(
     int64_t n,
     T const *x, int64_t incx )
 {
-    typedef real_type<T> real_t;
+    // check arguments
+    blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
+    blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
+
+    return internal::iamax( n, x, incx );
+}
+
+// =============================================================================
+/// @return Index of infinity-norm of vector, as in iamax,
+/// also returning the entry itself, so callers such as pivot searches
+/// need not load it again.
+/// Returns -1 if n = 0. NaN entries are handled as in iamax.
+///
+/// Generic implementation for arbitrary data types.
+///
+/// @param[in] n
+///     Number of elements in x. n >= 0.
+///
+/// @param[in] x
+///     The n-element vector x, in an array of length (n-1)*incx + 1.
+///
+/// @param[in] incx
+///     Stride between elements of x. incx > 0.
+///
+/// @param[out] value
+///     On exit, $x_i$ for the returned index i, or zero if n = 0.
+///
+/// @ingroup iamax
 
+template <typename T>
+int64_t amax(
+    int64_t n,
+    T const *x, int64_t incx,
+    T* value )
+{
     // check arguments
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
+    blas_error_if( value == nullptr );
 
-    // todo: check NAN
-    real_t result = -1;
-    int64_t index = -1;
-    if (incx == 1) {
-        // unit stride
-        for (int64_t i = 0; i < n; ++i) {
-            real_t tmp = abs1( x[i] );
-            if (tmp > result) {
-                result = tmp;
-                index = i;
-            }
-        }
-    }
-    else {
-        // non-unit stride
-        int64_t ix = 0;
-        for (int64_t i = 0; i < n; ++i) {
-            real_t tmp = abs1( x[ix] );
-            if (tmp > result) {
-                result = tmp;
-                index = i;
-            }
-            ix += incx;
-        }
-    }
+    int64_t index = internal::iamax( n, x, incx );
+    *value = (index >= 0 ? x[ index*incx ] : T( 0 ));
     return index;
 }
 
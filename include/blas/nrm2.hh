@@ -12,12 +12,180 @@
 
 namespace blas {
 
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Adds |a|^2 to one of Blue's three accumulators:
+/// sml for |a| < blue_min, scaled by blue_scaling_min;
+/// big for |a| > blue_max, scaled by blue_scaling_max;
+/// med otherwise, unscaled. NaN goes to med.
+///
+template <typename real_t>
+inline void nrm2_add(
+    real_t a,
+    real_t& sml, real_t& med, real_t& big,
+    real_t tsml, real_t tbig, real_t ssml, real_t sbig )
+{
+    const real_t zero = 0;
+    a = std::abs( a );
+    bool is_sml = a < tsml;
+    bool is_big = a > tbig;
+    real_t as = is_sml ? a*ssml : zero;
+    real_t ab = is_big ? a*sbig : zero;
+    real_t am = (is_sml || is_big) ? zero : a;
+    sml += as*as;
+    big += ab*ab;
+    med += am*am;
+}
+
+//------------------------------------------------------------------------------
+/// Computes Blue's three accumulators for the n-element vector x:
+/// sml and big hold scaled sums of squares of tiny and huge entries,
+/// med the unscaled sum of squares of the rest.
+/// For complex x, real and imaginary parts are added separately.
+///
+/// A first pass computes the plain sum of squares and max |x_i|, using
+/// independent accumulators per lane, reduced pairwise, so it vectorizes.
+/// Only if max |x_i| is outside Blue's medium range, where squares may
+/// overflow or underflow, is x summed again into scaled accumulators.
+///
+template <typename T>
+void nrm2_sums(
+    int64_t n,
+    T const* x, int64_t incx,
+    real_type<T>& sml, real_type<T>& med, real_type<T>& big )
+{
+    typedef real_type<T> real_t;
+
+    const real_t zero = 0;
+    const real_t tsml = blue_min<real_t>();
+    const real_t tbig = blue_max<real_t>();
+
+    const int lanes = 8;
+    real_t sum_[ lanes ] = {};
+    real_t max_[ lanes ] = {};
+
+    int64_t i = 0;
+    if (incx == 1) {
+        // unit stride
+        for (; i + lanes <= n; i += lanes) {
+            for (int l = 0; l < lanes; ++l) {
+                real_t a = std::abs( real_t( real( x[ i + l ] ) ) );
+                sum_[ l ] += a*a;
+                max_[ l ] = max_[ l ] < a ? a : max_[ l ];
+            }
+            if constexpr (is_complex<T>::value) {
+                for (int l = 0; l < lanes; ++l) {
+                    real_t a = std::abs( real_t( imag( x[ i + l ] ) ) );
+                    sum_[ l ] += a*a;
+                    max_[ l ] = max_[ l ] < a ? a : max_[ l ];
+                }
+            }
+        }
+    }
+    // remainder, or non-unit stride
+    for (; i < n; ++i) {
+        real_t a = std::abs( real_t( real( x[ i*incx ] ) ) );
+        sum_[ 0 ] += a*a;
+        max_[ 0 ] = max_[ 0 ] < a ? a : max_[ 0 ];
+        if constexpr (is_complex<T>::value) {
+            a = std::abs( real_t( imag( x[ i*incx ] ) ) );
+            sum_[ 0 ] += a*a;
+            max_[ 0 ] = max_[ 0 ] < a ? a : max_[ 0 ];
+        }
+    }
+
+    // pairwise reduction of lanes
+    for (int w = lanes/2; w > 0; w /= 2) {
+        for (int l = 0; l < w; ++l) {
+            sum_[ l ] += sum_[ l + w ];
+            max_[ l ] = max_[ l ] < max_[ l + w ] ? max_[ l + w ] : max_[ l ];
+        }
+    }
+
+    // Common case: all squares are safe. Entries below tsml contribute
+    // less than rounding error relative to max^2 >= tsml^2.
+    // NaN propagates through the sum.
+    real_t amax = max_[ 0 ];
+    if (amax <= tbig && (amax >= tsml || amax == zero)) {
+        sml = zero;
+        med = sum_[ 0 ];
+        big = zero;
+        return;
+    }
+
+    // Rare case: tiny or huge entries; use Blue's scaled accumulators.
+    const real_t ssml = blue_scaling_min<real_t>();
+    const real_t sbig = blue_scaling_max<real_t>();
+    sml = zero;
+    med = zero;
+    big = zero;
+    for (i = 0; i < n; ++i) {
+        nrm2_add( real_t( real( x[ i*incx ] ) ), sml, med, big,
+                  tsml, tbig, ssml, sbig );
+        if constexpr (is_complex<T>::value) {
+            nrm2_add( real_t( imag( x[ i*incx ] ) ), sml, med, big,
+                      tsml, tbig, ssml, sbig );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return sqrt of the sum of squares held in Blue's accumulators,
+/// as computed by nrm2_sums, combined without overflow or underflow.
+/// After LAPACK la_xnrm2.
+///
+template <typename real_t>
+real_t nrm2_combine( real_t sml, real_t med, real_t big )
+{
+    const real_t zero = 0;
+    const real_t one  = 1;
+    const real_t ssml = blue_scaling_min<real_t>();
+    const real_t sbig = blue_scaling_max<real_t>();
+
+    real_t scl, sumsq;
+    if (big > zero) {
+        // huge values present; the medium ones only matter if not tiny
+        if (med > zero || std::isnan( med ))
+            big += (med*sbig)*sbig;
+        scl = one / sbig;
+        sumsq = big;
+    }
+    else if (sml > zero) {
+        // tiny values present
+        if (med > zero || std::isnan( med )) {
+            med = std::sqrt( med );
+            sml = std::sqrt( sml ) / ssml;
+            real_t ymin = (sml > med ? med : sml);
+            real_t ymax = (sml > med ? sml : med);
+            scl = one;
+            sumsq = ymax*ymax * (one + (ymin/ymax)*(ymin/ymax));
+        }
+        else {
+            scl = one / ssml;
+            sumsq = sml;
+        }
+    }
+    else {
+        // only medium values
+        scl = one;
+        sumsq = med;
+    }
+    return scl * std::sqrt( sumsq );
+}
+
+}  // namespace internal
+
 // =============================================================================
 /// @return 2-norm of vector,
 ///     $|| x ||_2 = (\sum_{i=0}^{n-1} |x_i|^2)^{1/2}$.
 ///
 /// Generic implementation for arbitrary data types.
-/// TODO: generic implementation does not currently scale to avoid over- or underflow.
+/// Uses Blue's algorithm with three scaled accumulators, so it neither
+/// overflows nor underflows. Blocks of x without tiny or huge entries are
+/// summed directly, with independent lanes so the loop vectorizes.
+/// Long vectors are split across OpenMP threads, whose partial sums are
+/// added per accumulator.
 ///
 /// @param[in] n
 ///     Number of elements in x. n >= 0.
@@ -42,23 +210,23 @@ nrm2(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
-    // todo: scale to avoid overflow & underflow
-    real_t result = 0;
-    if (incx == 1) {
-        // unit stride
-        for (int64_t i = 0; i < n; ++i) {
-            result += real(x[i]) * real(x[i]) + imag(x[i]) * imag(x[i]);
-        }
-    }
-    else {
-        // non-unit stride
-        int64_t ix = 0;
-        for (int64_t i = 0; i < n; ++i) {
-            result += real(x[ix]) * real(x[ix]) + imag(x[ix]) * imag(x[ix]);
-            ix += incx;
-        }
+    real_t asml = 0, amed = 0, abig = 0;
+
+    // blocks of x, each summed by nrm2_sums
+    const int64_t nb = 4096;
+
+    #pragma omp parallel for schedule(static) reduction(+:asml, amed, abig) \
+                if (n >= internal::level1_omp_threshold)
+    for (int64_t i = 0; i < n; i += nb) {
+        real_t sml, med, big;
+        internal::nrm2_sums( blas::min( nb, n - i ), &x[ i*incx ], incx,
+                             sml, med, big );
+        asml += sml;
+        amed += med;
+        abig += big;
     }
-    return std::sqrt( result );
+
+    return internal::nrm2_combine( asml, amed, abig );
 }
 
 }  // namespace blas
@@ -0,0 +1,324 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_ROT_SEQUENCE_HH
+#define BLAS_ROT_SEQUENCE_HH
+
+#include "blas/util.hh"
+
+#include <cctype>
+#include <limits>
+
+namespace blas {
+
+namespace internal {
+
+/// Rows per block for side = Right; the carried column, mb scalars,
+/// stays in cache while the block's segments of A stream through.
+/// It is a local array, so each OpenMP thread needs mb scalars of stack,
+/// 32 KiB for complex<double>, well within default thread stacks
+/// ($OMP_STACKSIZE); keep that in mind before raising mb.
+const int64_t rot_sequence_mb = 2048;
+
+/// Rotations per wavefront step for side = Right.
+const int64_t rot_sequence_kb = 8;
+
+/// Rows per tile for side = Right; a tile of kb+1 column segments of
+/// mr rows, plus its part of the carried column, fits in L1 cache.
+const int64_t rot_sequence_mr = 128;
+
+//------------------------------------------------------------------------------
+/// Applies the k = n-1 rotations of rot_sequence from the right to
+/// rows [0, m) of the col-major m-by-n matrix A, with m <= rot_sequence_mb.
+/// The column that is rotated next is carried in a local array t,
+/// so each element of A is loaded and stored once, not once per rotation.
+/// Rotations are applied as a wavefront: a group of kb rotations sweeps
+/// down the rows in tiles of mr rows, each tile staying in L1 cache
+/// while all kb rotations are applied to it.
+///
+template <typename TA, typename TS>
+void rot_sequence_right(
+    bool forward,
+    int64_t m, int64_t n,
+    real_type<TS> const* c,
+    TS const* s,
+    TA* A, int64_t lda )
+{
+    typedef scalar_type<TA, TS> scalar_t;
+
+    // std::complex multiply doesn't vectorize; lanes would only add overhead
+    const int lanes = is_complex<scalar_t>::value ? 1 : 8;
+    const int64_t mb = rot_sequence_mb;
+    const int64_t kb = rot_sequence_kb;
+    const int64_t mr = rot_sequence_mr;
+    const int64_t k  = n - 1;
+    assert( m <= mb );
+    scalar_t t[ mb ];
+
+    if (forward) {
+        // rotation i: t = col i (already rotated by i-1), y = col i+1
+        for (int64_t r = 0; r < m; ++r)
+            t[ r ] = A[ r ];
+        for (int64_t i0 = 0; i0 < k; i0 += kb) {
+            int64_t i1 = blas::min( i0 + kb, k );
+            for (int64_t r0 = 0; r0 < m; r0 += mr) {
+                int64_t r1 = blas::min( r0 + mr, m );
+                for (int64_t i = i0; i < i1; ++i) {
+                    TA*       x = &A[ i*lda ];
+                    TA const* y = &A[ (i+1)*lda ];
+                    real_type<TS> ci = c[ i ];
+                    TS si = s[ i ];
+                    TS sc = conj( si );
+                    int64_t r = r0;
+                    for (; r + lanes <= r1; r += lanes) {
+                        // loads precede stores, so the lanes vectorize
+                        scalar_t xn[ lanes ];
+                        for (int l = 0; l < lanes; ++l) {
+                            scalar_t yr = y[ r+l ];
+                            scalar_t tr = t[ r+l ];
+                            xn[ l ]    = ci*tr + si*yr;
+                            t[ r+l ]   = ci*yr - sc*tr;
+                        }
+                        for (int l = 0; l < lanes; ++l)
+                            x[ r+l ] = xn[ l ];
+                    }
+                    for (; r < r1; ++r) {
+                        scalar_t yr = y[ r ];
+                        x[ r ] = ci*t[ r ] + si*yr;
+                        t[ r ] = ci*yr - sc*t[ r ];
+                    }
+                }
+            }
+        }
+        for (int64_t r = 0; r < m; ++r)
+            A[ r + k*lda ] = t[ r ];
+    }
+    else {
+        // rotation i: x = col i, t = col i+1 (already rotated by i+1)
+        for (int64_t r = 0; r < m; ++r)
+            t[ r ] = A[ r + k*lda ];
+        for (int64_t i1 = k; i1 > 0; i1 -= kb) {
+            int64_t i0 = blas::max( i1 - kb, int64_t( 0 ) );
+            for (int64_t r0 = 0; r0 < m; r0 += mr) {
+                int64_t r1 = blas::min( r0 + mr, m );
+                for (int64_t i = i1 - 1; i >= i0; --i) {
+                    TA const* x = &A[ i*lda ];
+                    TA*       y = &A[ (i+1)*lda ];
+                    real_type<TS> ci = c[ i ];
+                    TS si = s[ i ];
+                    TS sc = conj( si );
+                    int64_t r = r0;
+                    for (; r + lanes <= r1; r += lanes) {
+                        scalar_t yn[ lanes ];
+                        for (int l = 0; l < lanes; ++l) {
+                            scalar_t xr = x[ r+l ];
+                            scalar_t tr = t[ r+l ];
+                            yn[ l ]    = ci*tr - sc*xr;
+                            t[ r+l ]   = ci*xr + si*tr;
+                        }
+                        for (int l = 0; l < lanes; ++l)
+                            y[ r+l ] = yn[ l ];
+                    }
+                    for (; r < r1; ++r) {
+                        scalar_t xr = x[ r ];
+                        y[ r ] = ci*t[ r ] - sc*xr;
+                        t[ r ] = ci*xr + si*t[ r ];
+                    }
+                }
+            }
+        }
+        for (int64_t r = 0; r < m; ++r)
+            A[ r ] = t[ r ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Applies the k = m-1 rotations of rot_sequence from the left to
+/// columns [0, n) of the col-major m-by-n matrix A.
+/// Each column is an independent chain of rotations down the column;
+/// several columns are interleaved in lanes to hide the chain's latency.
+///
+template <typename TA, typename TS>
+void rot_sequence_left(
+    bool forward,
+    int64_t m, int64_t n,
+    real_type<TS> const* c,
+    TS const* s,
+    TA* A, int64_t lda )
+{
+    typedef scalar_type<TA, TS> scalar_t;
+
+    const int lanes = 4;
+    scalar_t t[ lanes ];
+
+    for (int64_t j = 0; j < n; j += lanes) {
+        int nl = int( blas::min( int64_t( lanes ), n - j ) );
+        TA* Aj = &A[ j*lda ];
+        if (forward) {
+            for (int l = 0; l < nl; ++l)
+                t[ l ] = Aj[ l*lda ];
+            for (int64_t i = 0; i < m-1; ++i) {
+                real_type<TS> ci = c[ i ];
+                TS si = s[ i ];
+                TS sc = conj( si );
+                for (int l = 0; l < nl; ++l) {
+                    scalar_t yl = Aj[ i+1 + l*lda ];
+                    Aj[ i + l*lda ] = ci*t[ l ] + si*yl;
+                    t[ l ] = ci*yl - sc*t[ l ];
+                }
+            }
+            for (int l = 0; l < nl; ++l)
+                Aj[ m-1 + l*lda ] = t[ l ];
+        }
+        else {
+            for (int l = 0; l < nl; ++l)
+                t[ l ] = Aj[ m-1 + l*lda ];
+            for (int64_t i = m-2; i >= 0; --i) {
+                real_type<TS> ci = c[ i ];
+                TS si = s[ i ];
+                TS sc = conj( si );
+                for (int l = 0; l < nl; ++l) {
+                    scalar_t xl = Aj[ i + l*lda ];
+                    Aj[ i+1 + l*lda ] = ci*t[ l ] - sc*xl;
+                    t[ l ] = ci*xl + si*t[ l ];
+                }
+            }
+            for (int l = 0; l < nl; ++l)
+                Aj[ l*lda ] = t[ l ];
+        }
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+/// Apply a sequence of plane rotations to a general m-by-n matrix A,
+/// from the left,
+///     $A = P A$, with $k = m-1$ rotations acting on rows i and i+1,
+/// or from the right,
+///     $A = A P^T$, with $k = n-1$ rotations acting on columns i and i+1.
+/// Rotation i applies $(c_i, s_i)$ to the pair (x, y) as in rot:
+///     $x = c_i x + s_i y$, $y = c_i y - \bar{s}_i x$.
+/// Like LAPACK's lasr with pivot = variable.
+///
+/// Generic implementation for arbitrary data types.
+/// Instead of one pass over A per rotation, all k rotations are applied
+/// while a block of A is in cache, carrying the rotated row or column
+/// forward, so each element of A is loaded and stored once.
+/// For side = Right, rotations sweep A as a wavefront of tiles,
+/// each a few rotations by a few rows, that are applied in L1 cache;
+/// blocks of rows are independent and, for large matrices, are split
+/// across OpenMP threads; likewise blocks of columns for side = Left.
+///
+/// @param[in] layout
+///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
+///
+/// @param[in] side
+///     Whether rotations are applied from the left or right:
+///     - Side::Left:  $A = P A$, rotating rows.
+///     - Side::Right: $A = A P^T$, rotating columns.
+///
+/// @param[in] direction
+///     Order in which rotations are applied, as LAPACK's direct:
+///     - 'F', or lapack::Direction::Forward:  i = 0, 1, ..., k-1.
+///     - 'B', or lapack::Direction::Backward: i = k-1, ..., 1, 0.
+///     Any enum with these char values, such as LAPACK++'s
+///     lapack::Direction, or the char itself, can be passed.
+///     BLAS++ doesn't define its own Direction, which would be ambiguous
+///     with lapack::Direction when both namespaces are used.
+///
+/// @param[in] m
+///     Number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of the matrix A. n >= 0.
+///
+/// @param[in] c
+///     Array of length k; cosines of rotations; real.
+///
+/// @param[in] s
+///     Array of length k; sines of rotations; real or complex.
+///
+/// @param[in, out] A
+///     The m-by-n matrix A, stored in an lda-by-n array [RowMajor: m-by-lda].
+///
+/// @param[in] lda
+///     Leading dimension of A.
+///     If ColMajor: lda >= max(1, m) [RowMajor: lda >= max(1, n)].
+///
+/// @ingroup rot_sequence
+
+template <typename TA, typename TS, typename direction_t>
+void rot_sequence(
+    blas::Layout layout,
+    blas::Side side,
+    direction_t direction,
+    int64_t m, int64_t n,
+    blas::real_type<TS> const* c,
+    TS const* s,
+    TA* A, int64_t lda )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( side != Side::Left &&
+                   side != Side::Right );
+    char direct = (char) toupper( char( direction ) );
+    blas_error_if( direct != 'F' &&
+                   direct != 'B' );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < n );
+
+    // RowMajor A is ColMajor A^T: rotating rows of A rotates columns of A^T.
+    if (layout == Layout::RowMajor) {
+        side = (side == Side::Left ? Side::Right : Side::Left);
+        std::swap( m, n );
+    }
+
+    // quick return
+    if (m == 0 || n == 0
+        || (side == Side::Left  && m == 1)
+        || (side == Side::Right && n == 1))
+        return;
+
+    const bool forward  = direct == 'F';
+    const bool parallel = m*n >= internal::level2_omp_threshold;
+
+    if (side == Side::Right) {
+        // blocks of rows, at most rot_sequence_mb; with threads, about
+        // m / threads rows, rounded up to whole mr-row tiles, so every
+        // thread gets work even when m <= rot_sequence_mb
+        const int64_t mr = internal::rot_sequence_mr;
+        int64_t mb = internal::rot_sequence_mb;
+        if (parallel) {
+            int64_t nt = internal::omp_max_threads();
+            int64_t rows = (m + nt - 1) / nt;
+            mb = blas::min( mb, ((rows + mr - 1) / mr) * mr );
+        }
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int64_t i = 0; i < m; i += mb) {
+            internal::rot_sequence_right( forward, blas::min( mb, m - i ), n,
+                                          c, s, &A[ i ], lda );
+        }
+    }
+    else {
+        // blocks of columns
+        const int64_t nb = 64;
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int64_t j = 0; j < n; j += nb) {
+            internal::rot_sequence_left( forward, m, blas::min( nb, n - j ),
+                                         c, s, &A[ j*lda ], lda );
+        }
+    }
+}
+
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_ROT_SEQUENCE_HH
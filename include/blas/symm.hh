@@ -7,6 +7,7 @@
 #define BLAS_SYMM_HH
 
 #include "blas/util.hh"
+#include "blas/gemm_packed.hh"
 
 #include <limits>
 
@@ -25,6 +26,8 @@ namespace blas {
 /// and B and C are m-by-n matrices.
 ///
 /// Generic implementation for arbitrary data types.
+/// The symmetric A is expanded to full panels while packing, so the
+/// multiply runs the packed gemm micro-kernel (see blas/gemm_packed.hh).
 ///
 /// @param[in] layout
 ///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -88,8 +91,6 @@ void symm(
 {
     typedef blas::scalar_type<TA, TB, TC> scalar_t;
 
-    #define A(i_, j_) A[ (i_) + (j_)*lda ]
-    #define B(i_, j_) B[ (i_) + (j_)*ldb ]
     #define C(i_, j_) C[ (i_) + (j_)*ldc ]
 
     // constants
@@ -146,95 +147,22 @@ void symm(
     }
 
     // alpha != zero
+    // expand the symmetric A while packing (upper if General),
+    // then multiply with the packed gemm engine
+    internal::SymView< scalar_t, TA > Afull(
+        (uplo == Uplo::Lower ? Uplo::Lower : Uplo::Upper), false, A, lda );
+    internal::OpView< scalar_t, TB > Bview( Op::NoTrans, B, ldb );
     if (side == Side::Left) {
-        if (uplo != Uplo::Lower) {
-            // uplo == Uplo::Upper or uplo == Uplo::General
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i < m; ++i) {
-
-                    scalar_t alpha_Bij = alpha*B(i, j);
-                    scalar_t sum = zero;
-
-                    for (int64_t k = 0; k < i; ++k) {
-                        C(k, j) += A(k, i) * alpha_Bij;
-                        sum += A(k, i) * B(k, j);
-                    }
-                    C(i, j) =
-                        beta * C(i, j)
-                        + A(i, i) * alpha_Bij
-                        + alpha * sum;
-                }
-            }
-        }
-        else {
-            // uplo == Uplo::Lower
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = m-1; i >= 0; --i) {
-
-                    scalar_t alpha_Bij = alpha*B(i, j);
-                    scalar_t sum = zero;
-
-                    for (int64_t k = i+1; k < m; ++k) {
-                        C(k, j) += A(k, i) * alpha_Bij;
-                        sum += A(k, i) * B(k, j);
-                    }
-                    C(i, j) =
-                        beta * C(i, j)
-                        + A(i, i) * alpha_Bij
-                        + alpha * sum;
-                }
-            }
-        }
+        // C = alpha A B + beta C
+        internal::gemm_packed< scalar_t >(
+            m, n, m, alpha, Afull, Bview, beta, C, ldc );
     }
-    else { // side == Side::Right
-        if (uplo != Uplo::Lower) {
-            // uplo == Uplo::Upper or uplo == Uplo::General
-            for (int64_t j = 0; j < n; ++j) {
-
-                scalar_t alpha_Akj = alpha * A(j, j);
-
-                for (int64_t i = 0; i < m; ++i)
-                    C(i, j) = beta * C(i, j) + B(i, j) * alpha_Akj;
-
-                for (int64_t k = 0; k < j; ++k) {
-                    alpha_Akj = alpha*A(k, j);
-                    for (int64_t i = 0; i < m; ++i)
-                        C(i, j) += B(i, k) * alpha_Akj;
-                }
-
-                for (int64_t k = j+1; k < n; ++k) {
-                    alpha_Akj = alpha * A(j, k);
-                    for (int64_t i = 0; i < m; ++i)
-                        C(i, j) += B(i, k) * alpha_Akj;
-                }
-            }
-        }
-        else {
-            // uplo == Uplo::Lower
-            for (int64_t j = 0; j < n; ++j) {
-
-                scalar_t alpha_Akj = alpha * A(j, j);
-
-                for (int64_t i = 0; i < m; ++i)
-                    C(i, j) = beta * C(i, j) + B(i, j) * alpha_Akj;
-
-                for (int64_t k = 0; k < j; ++k) {
-                    alpha_Akj = alpha * A(j, k);
-                    for (int64_t i = 0; i < m; ++i)
-                        C(i, j) += B(i, k) * alpha_Akj;
-                }
-
-                for (int64_t k = j+1; k < n; ++k) {
-                    alpha_Akj = alpha*A(k, j);
-                    for (int64_t i = 0; i < m; ++i)
-                        C(i, j) += B(i, k) * alpha_Akj;
-                }
-            }
-        }
+    else {
+        // C = alpha B A + beta C
+        internal::gemm_packed< scalar_t >(
+            m, n, n, alpha, Bview, Afull, beta, C, ldc );
     }
 
-    #undef A
-    #undef B
     #undef C
 }
 
@@ -7,11 +7,247 @@
 #define BLAS_SYMV_HH
 
 #include "blas/util.hh"
+#include "blas/gemv.hh"
 
 #include <limits>
+#include <vector>
 
 namespace blas {
 
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return a_ij as used for a_ji: conj( a ) if hermitian, else a.
+template <bool hermitian, typename scalar_t>
+inline scalar_t symv_trans( scalar_t a )
+{
+    if constexpr (hermitian)
+        return conj( a );
+    else
+        return a;
+}
+
+//------------------------------------------------------------------------------
+/// @return diagonal entry a_jj converted to scalar_t,
+/// keeping only the real part if hermitian.
+template <bool hermitian, typename scalar_t, typename TA>
+inline scalar_t symv_diag( TA a )
+{
+    if constexpr (hermitian)
+        return scalar_t( real( a ) );
+    else
+        return scalar_t( a );
+}
+
+//------------------------------------------------------------------------------
+/// Adds to y the part of alpha A x due to stored columns j0, ..., j1-1
+/// of the n-by-n symmetric A, or Hermitian A if hermitian, with uplo
+/// triangle stored in column-major order. x and y are unit stride.
+/// If conj_A, the stored entries are conjugated first (row-major hemv).
+///
+/// Processes columns in pairs, reading each stored element once:
+/// it is used both for y_i += a_ij x_j and, with independent accumulators
+/// per lane reduced pairwise, for y_j += a_ij x_i (conjugated if hermitian).
+///
+template <bool hermitian, bool conj_A, typename TA, typename scalar_t>
+void symv_cols(
+    blas::Uplo uplo,
+    int64_t n, int64_t j0, int64_t j1,
+    scalar_t alpha,
+    TA const* A, int64_t lda,
+    scalar_t const* x,
+    scalar_t* y )
+{
+    #define A(i_, j_) A[ (i_) + (j_)*lda ]
+
+    // std::complex multiplies don't vectorize, so lanes only add
+    // register pressure for complex types
+    const int lanes = is_complex<scalar_t>::value ? 1 : 4;
+
+    int64_t j = j0;
+    for (; j + 2 <= j1; j += 2) {
+        scalar_t t0 = alpha*x[ j ];
+        scalar_t t1 = alpha*x[ j + 1 ];
+        TA const* A0 = &A( 0, j );
+        TA const* A1 = &A( 0, j + 1 );
+
+        // rows strictly outside the 2x2 diagonal block
+        int64_t ibegin = (uplo == Uplo::Lower ? j + 2 : 0);
+        int64_t iend   = (uplo == Uplo::Lower ? n     : j);
+
+        scalar_t s0[ lanes ] = {};
+        scalar_t s1[ lanes ] = {};
+        int64_t i = ibegin;
+        for (; i + lanes <= iend; i += lanes) {
+            // all loads precede the stores to y, so the compiler can
+            // vectorize without proving y doesn't alias A or x
+            scalar_t a0[ lanes ], a1[ lanes ];
+            for (int l = 0; l < lanes; ++l) {
+                a0[ l ] = gemv_elem<conj_A, scalar_t>( A0[ i + l ] );
+                a1[ l ] = gemv_elem<conj_A, scalar_t>( A1[ i + l ] );
+                s0[ l ] += symv_trans<hermitian>( a0[ l ] ) * x[ i + l ];
+                s1[ l ] += symv_trans<hermitian>( a1[ l ] ) * x[ i + l ];
+            }
+            for (int l = 0; l < lanes; ++l) {
+                y[ i + l ] += t0*a0[ l ] + t1*a1[ l ];
+            }
+        }
+        for (; i < iend; ++i) {
+            scalar_t a0 = gemv_elem<conj_A, scalar_t>( A0[ i ] );
+            scalar_t a1 = gemv_elem<conj_A, scalar_t>( A1[ i ] );
+            y[ i ] += t0*a0 + t1*a1;
+            s0[ 0 ] += symv_trans<hermitian>( a0 ) * x[ i ];
+            s1[ 0 ] += symv_trans<hermitian>( a1 ) * x[ i ];
+        }
+        // pairwise reduction of lanes
+        for (int w = lanes/2; w > 0; w /= 2) {
+            for (int l = 0; l < w; ++l) {
+                s0[ l ] += s0[ l + w ];
+                s1[ l ] += s1[ l + w ];
+            }
+        }
+
+        // 2x2 diagonal block; b is entry (j+1, j) if lower, (j, j+1) if upper
+        scalar_t d0 = symv_diag<hermitian, scalar_t>( A( j, j ) );
+        scalar_t d1 = symv_diag<hermitian, scalar_t>( A( j + 1, j + 1 ) );
+        if (uplo == Uplo::Lower) {
+            scalar_t b = gemv_elem<conj_A, scalar_t>( A( j + 1, j ) );
+            y[ j     ] += d0*t0 + symv_trans<hermitian>( b )*t1
+                          + alpha*s0[ 0 ];
+            y[ j + 1 ] += b*t0 + d1*t1 + alpha*s1[ 0 ];
+        }
+        else {
+            scalar_t b = gemv_elem<conj_A, scalar_t>( A( j, j + 1 ) );
+            y[ j     ] += d0*t0 + b*t1 + alpha*s0[ 0 ];
+            y[ j + 1 ] += symv_trans<hermitian>( b )*t0 + d1*t1
+                          + alpha*s1[ 0 ];
+        }
+    }
+    // last column, if odd
+    for (; j < j1; ++j) {
+        scalar_t t0 = alpha*x[ j ];
+        scalar_t s0 = 0;
+        int64_t ibegin = (uplo == Uplo::Lower ? j + 1 : 0);
+        int64_t iend   = (uplo == Uplo::Lower ? n     : j);
+        for (int64_t i = ibegin; i < iend; ++i) {
+            scalar_t a0 = gemv_elem<conj_A, scalar_t>( A( i, j ) );
+            y[ i ] += t0*a0;
+            s0 += symv_trans<hermitian>( a0 ) * x[ i ];
+        }
+        y[ j ] += symv_diag<hermitian, scalar_t>( A( j, j ) )*t0 + alpha*s0;
+    }
+
+    #undef A
+}
+
+//------------------------------------------------------------------------------
+/// Computes y += alpha A x for n-by-n column-major symmetric A,
+/// or Hermitian A if hermitian, with uplo triangle stored;
+/// if conj_A, the stored entries are conjugated first.
+/// Arguments are checked and y scaled by beta by the caller;
+/// x and y point to x(0) and y(0).
+///
+/// If x or y is strided or of another type than scalar_t, it goes through
+/// a scalar_t workspace. With OpenMP, blocks of columns are divided
+/// cyclically among threads, each adding into its own partial y,
+/// which are then summed in thread order, so results are reproducible
+/// for a given number of threads.
+///
+template <bool hermitian, bool conj_A, typename TA, typename TX, typename TY>
+void symv(
+    blas::Uplo uplo,
+    int64_t n,
+    scalar_type<TA, TX, TY> alpha,
+    TA const* A, int64_t lda,
+    TX const* x, int64_t incx,
+    TY* y, int64_t incy )
+{
+    typedef scalar_type<TA, TX, TY> scalar_t;
+
+    const scalar_t zero = 0;
+
+    std::vector<scalar_t> xw;
+    scalar_t const* xp;
+    if constexpr (std::is_same< TX, scalar_t >::value) {
+        if (incx == 1) {
+            xp = x;
+        }
+        else {
+            xw.resize( n );
+            for (int64_t i = 0; i < n; ++i)
+                xw[ i ] = x[ i*incx ];
+            xp = xw.data();
+        }
+    }
+    else {
+        xw.resize( n );
+        for (int64_t i = 0; i < n; ++i)
+            xw[ i ] = scalar_t( x[ i*incx ] );
+        xp = xw.data();
+    }
+
+    std::vector<scalar_t> w;
+    scalar_t* yw;
+    if constexpr (std::is_same< TY, scalar_t >::value) {
+        if (incy == 1) {
+            yw = y;
+        }
+        else {
+            w.assign( n, zero );
+            yw = w.data();
+        }
+    }
+    else {
+        w.assign( n, zero );
+        yw = w.data();
+    }
+
+    // columns per task; even, to keep column pairs together
+    const int64_t nb = 32;
+
+    if (n*n < 2*level2_omp_threshold) {
+        symv_cols<hermitian, conj_A>( uplo, n, 0, n, alpha, A, lda, xp, yw );
+    }
+    else {
+        // static cyclic schedule balances the triangle and always gives
+        // a thread the same blocks; partials are summed in thread order.
+        // Partials are sized by the actual team, which may be smaller
+        // than the max threads, e.g., inside a batch's outer threads.
+        int64_t nt = 1;
+        std::vector<scalar_t> yt;
+        #pragma omp parallel
+        {
+            #pragma omp single
+            {
+                nt = omp_num_threads();
+                yt.assign( nt*n, zero );
+            }
+            scalar_t* ytp = &yt[ omp_thread_num()*n ];
+
+            #pragma omp for schedule(static, 1)
+            for (int64_t j = 0; j < n; j += nb) {
+                symv_cols<hermitian, conj_A>(
+                    uplo, n, j, blas::min( j + nb, n ),
+                    alpha, A, lda, xp, ytp );
+            }
+
+            #pragma omp for schedule(static)
+            for (int64_t i = 0; i < n; ++i) {
+                for (int64_t t = 0; t < nt; ++t)
+                    yw[ i ] += yt[ t*n + i ];
+            }
+        }
+    }
+
+    if (! w.empty()) {
+        for (int64_t i = 0; i < n; ++i) {
+            y[ i*incy ] += w[ i ];
+        }
+    }
+}
+
+}  // namespace internal
+
 // =============================================================================
 /// Symmetric matrix-vector multiply:
 /// \[
@@ -21,6 +257,8 @@ namespace blas {
 /// and A is an n-by-n symmetric matrix.
 ///
 /// Generic implementation for arbitrary data types.
+/// Processes columns in pairs, reading each stored element of A once;
+/// large matrices are split across OpenMP threads.
 ///
 /// @param[in] layout
 ///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -73,11 +311,8 @@ void symv(
     blas::scalar_type<TA, TX, TY> beta,
     TY *y, int64_t incy )
 {
-printf( "%s: %s\n", __func__, __PRETTY_FUNCTION__ );
     typedef blas::scalar_type<TA, TX, TY> scalar_t;
 
-    #define A(i_, j_) A[ (i_) + (j_)*lda ]
-
     // constants
     const scalar_t zero = 0;
     const scalar_t one  = 1;
@@ -137,80 +372,9 @@ printf( "%s: %s\n", __func__, __PRETTY_FUNCTION__ );
     if (alpha == zero)
         return;
 
-    if (uplo == Uplo::Upper) {
-        // A is stored in upper triangle
-        // form y += alpha * A * x
-        if (incx == 1 && incy == 1) {
-            // unit stride
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp1 = alpha*x[j];
-                scalar_t tmp2 = zero;
-                for (int64_t i = 0; i < j; ++i) {
-                    y[i] += tmp1 * A(i, j);
-                    tmp2 += A(i, j) * x[i];
-                }
-                y[j] += tmp1 * A(j, j) + alpha * tmp2;
-            }
-        }
-        else {
-            // non-unit stride
-            int64_t jx = kx;
-            int64_t jy = ky;
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp1 = alpha*x[jx];
-                scalar_t tmp2 = zero;
-                int64_t ix = kx;
-                int64_t iy = ky;
-                for (int64_t i = 0; i < j; ++i) {
-                    y[iy] += tmp1 * A(i, j);
-                    tmp2 += A(i, j) * x[ix];
-                    ix += incx;
-                    iy += incy;
-                }
-                y[jy] += tmp1 * A(j, j) + alpha * tmp2;
-                jx += incx;
-                jy += incy;
-            }
-        }
-    }
-    else {
-        // A is stored in lower triangle
-        // form y += alpha * A * x
-        if (incx == 1 && incy == 1) {
-            // unit stride
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp1 = alpha*x[j];
-                scalar_t tmp2 = zero;
-                for (int64_t i = j+1; i < n; ++i) {
-                    y[i] += tmp1 * A(i, j);
-                    tmp2 += A(i, j) * x[i];
-                }
-                y[j] += tmp1 * A(j, j) + alpha * tmp2;
-            }
-        }
-        else {
-            // non-unit stride
-            int64_t jx = kx;
-            int64_t jy = ky;
-            for (int64_t j = 0; j < n; ++j) {
-                scalar_t tmp1 = alpha*x[jx];
-                scalar_t tmp2 = zero;
-                int64_t ix = jx;
-                int64_t iy = jy;
-                for (int64_t i = j+1; i < n; ++i) {
-                    ix += incx;
-                    iy += incy;
-                    y[iy] += tmp1 * A(i, j);
-                    tmp2 += A(i, j) * x[ix];
-                }
-                y[jy] += tmp1 * A(j, j) + alpha * tmp2;
-                jx += incx;
-                jy += incy;
-            }
-        }
-    }
-
-    #undef A
+    // x and y point to x(0) and y(0)
+    internal::symv<false, false>( uplo, n, alpha, A, lda, x + kx, incx,
+                                  y + ky, incy );
 }
 
 }  // namespace blas
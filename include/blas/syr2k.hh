@@ -7,6 +7,7 @@
 #define BLAS_SYR2K_HH
 
 #include "blas/util.hh"
+#include "blas/gemm_packed.hh"
 
 #include <limits>
 
@@ -25,6 +26,9 @@ namespace blas {
 /// and A and B are n-by-k or k-by-n matrices.
 ///
 /// Generic implementation for arbitrary data types.
+/// Computes only the uplo triangle with the packed gemm engine
+/// (see blas/gemm_packed.hh), packing A and B panels together so both
+/// rank-k terms are applied to each tile in a single pass.
 ///
 /// @param[in] layout
 ///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -149,115 +153,45 @@ void syr2k(
     blas_error_if( ldc < n );
 
     // quick return
-    if (n == 0 || k == 0)
+    if (n == 0)
         return;
 
-    // alpha == zero
-    if (alpha == zero) {
-        if (beta == zero) {
-            if (uplo != Uplo::Upper) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i <= j; ++i)
-                        C(i, j) = zero;
-                }
-            }
-            else if (uplo != Uplo::Lower) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = j; i < n; ++i)
-                        C(i, j) = zero;
-                }
-            }
-            else {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i < n; ++i)
-                        C(i, j) = zero;
-                }
-            }
-        }
-        else if (beta != one) {
-            if (uplo != Uplo::Upper) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i <= j; ++i)
-                        C(i, j) *= beta;
-                }
-            }
-            else if (uplo != Uplo::Lower) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = j; i < n; ++i)
-                        C(i, j) *= beta;
-                }
-            }
-            else {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i < n; ++i)
-                        C(i, j) *= beta;
-                }
+    // alpha == zero or k == zero: C = beta C on the uplo triangle
+    if (alpha == zero || k == 0) {
+        if (beta == one)
+            return;
+        for (int64_t j = 0; j < n; ++j) {
+            int64_t ibegin = (uplo == Uplo::Lower ? j : 0);
+            int64_t iend   = (uplo == Uplo::Upper ? j + 1 : n);
+            for (int64_t i = ibegin; i < iend; ++i) {
+                if (beta == zero)
+                    C(i, j) = zero;
+                else
+                    C(i, j) *= beta;
             }
         }
         return;
     }
 
     // alpha != zero
-    if (trans == Op::NoTrans) {
-        if (uplo != Uplo::Lower) {
-            // uplo == Uplo::Upper or uplo == Uplo::General
-            for (int64_t j = 0; j < n; ++j) {
-
-                for (int64_t i = 0; i <= j; ++i)
-                    C(i, j) *= beta;
-
-                for (int64_t l = 0; l < k; ++l) {
-                    scalar_t alpha_Bjl = alpha*B(j, l);
-                    scalar_t alpha_Ajl = alpha*A(j, l);
-                    for (int64_t i = 0; i <= j; ++i)
-                        C(i, j) += A(i, l)*alpha_Bjl + B(i, l)*alpha_Ajl;
-                }
-            }
-        }
-        else { // uplo == Uplo::Lower
-            for (int64_t j = 0; j < n; ++j) {
-
-                for (int64_t i = j; i < n; ++i)
-                    C(i, j) *= beta;
-
-                for (int64_t l = 0; l < k; ++l) {
-                    scalar_t alpha_Bjl = alpha*B(j, l);
-                    scalar_t alpha_Ajl = alpha*A(j, l);
-                    for (int64_t i = j; i < n; ++i)
-                        C(i, j) += A(i, l)*alpha_Bjl + B(i, l)*alpha_Ajl;
-                }
-            }
-        }
-    }
-    else { // trans == Op::Trans
-        if (uplo != Uplo::Lower) {
-            // uplo == Uplo::Upper or uplo == Uplo::General
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i <= j; ++i) {
-                    scalar_t sum1 = zero;
-                    scalar_t sum2 = zero;
-                    for (int64_t l = 0; l < k; ++l) {
-                        sum1 += A(l, i) * B(l, j);
-                        sum2 += B(l, i) * A(l, j);
-                    }
-                    C(i, j) = alpha*sum1 + alpha*sum2 + beta*C(i, j);
-                }
-            }
-        }
-        else { // uplo == Uplo::Lower
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = j; i < n; ++i) {
-                    scalar_t sum1 = zero;
-                    scalar_t sum2 = zero;
-                    for (int64_t l = 0; l < k; ++l) {
-                        sum1 +=  A(l, i) * B(l, j);
-                        sum2 +=  B(l, i) * A(l, j);
-                    }
-                    C(i, j) = alpha*sum1 + alpha*sum2 + beta*C(i, j);
-                }
-            }
-        }
-    }
+    // Both rank-k terms share one packed pass, since together they are one
+    // product of depth 2k,
+    // C = [ op(A), op(B) ] [ alpha op(B)^T; alpha op(A)^T ] + beta C,
+    // so each packed panel holds matching slices of A and B, and each tile
+    // of the triangle gets both terms at once.
+    // For Uplo::General, the upper triangle is computed, then mirrored.
+    Op transT = (trans == Op::NoTrans ? Op::Trans : Op::NoTrans);
+    internal::OpView< scalar_t, TA > opA( trans, A, lda );
+    internal::OpView< scalar_t, TB > opB( trans, B, ldb );
+    internal::OpView< scalar_t, TB > opBT( transT, B, ldb );
+    internal::OpView< scalar_t, TA > opAT( transT, A, lda );
+    internal::gemmt_packed< scalar_t >(
+        (uplo == Uplo::Lower ? Uplo::Lower : Uplo::Upper), n, 2*k,
+        one, internal::ConcatView< decltype( opA ), decltype( opB ) >(
+                 opA, opB, k ),
+             internal::StackView< scalar_t, decltype( opBT ), decltype( opAT ) >(
+                 alpha, opBT, alpha, opAT, k ),
+        scalar_t( beta ), C, ldc, false );
 
     if (uplo == Uplo::General) {
         for (int64_t j = 0; j < n; ++j) {
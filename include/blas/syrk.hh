@@ -7,6 +7,7 @@
 #define BLAS_SYRK_HH
 
 #include "blas/util.hh"
+#include "blas/gemm_packed.hh"
 
 #include <limits>
 
@@ -25,6 +26,9 @@ namespace blas {
 /// and A is an n-by-k or k-by-n matrix.
 ///
 /// Generic implementation for arbitrary data types.
+/// Computes only the uplo triangle, blocked: diagonal blocks and the
+/// off-diagonal blocks in the triangle use the packed gemm engine
+/// (see blas/gemm_packed.hh), for about half the flops of gemm.
 ///
 /// @param[in] layout
 ///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -133,108 +137,35 @@ void syrk(
     blas_error_if( ldc < n );
 
     // quick return
-    if (n == 0 || k == 0)
+    if (n == 0)
         return;
 
-    // alpha == zero
-    if (alpha == zero) {
-        if (beta == zero) {
-            if (uplo != Uplo::Upper) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i <= j; ++i)
-                        C(i, j) = zero;
-                }
-            }
-            else if (uplo != Uplo::Lower) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = j; i < n; ++i)
-                        C(i, j) = zero;
-                }
-            }
-            else {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i < n; ++i)
-                        C(i, j) = zero;
-                }
-            }
-        }
-        else if (beta != one) {
-            if (uplo != Uplo::Upper) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i <= j; ++i)
-                        C(i, j) *= beta;
-                }
-            }
-            else if (uplo != Uplo::Lower) {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = j; i < n; ++i)
-                        C(i, j) *= beta;
-                }
-            }
-            else {
-                for (int64_t j = 0; j < n; ++j) {
-                    for (int64_t i = 0; i < n; ++i)
-                        C(i, j) *= beta;
-                }
+    // alpha == zero or k == zero: C = beta C on the uplo triangle
+    if (alpha == zero || k == 0) {
+        if (beta == one)
+            return;
+        for (int64_t j = 0; j < n; ++j) {
+            int64_t ibegin = (uplo == Uplo::Lower ? j : 0);
+            int64_t iend   = (uplo == Uplo::Upper ? j + 1 : n);
+            for (int64_t i = ibegin; i < iend; ++i) {
+                if (beta == zero)
+                    C(i, j) = zero;
+                else
+                    C(i, j) *= beta;
             }
         }
         return;
     }
 
     // alpha != zero
-    if (trans == Op::NoTrans) {
-        if (uplo != Uplo::Lower) {
-            // uplo == Uplo::Upper or uplo == Uplo::General
-            for (int64_t j = 0; j < n; ++j) {
-
-                for (int64_t i = 0; i <= j; ++i)
-                    C(i, j) *= beta;
-
-                for (int64_t l = 0; l < k; ++l) {
-                    scalar_t alpha_Ajl = alpha*A(j, l);
-                    for (int64_t i = 0; i <= j; ++i)
-                        C(i, j) += A(i, l)*alpha_Ajl;
-                }
-            }
-        }
-        else { // uplo == Uplo::Lower
-            for (int64_t j = 0; j < n; ++j) {
-
-                for (int64_t i = j; i < n; ++i)
-                    C(i, j) *= beta;
-
-                for (int64_t l = 0; l < k; ++l) {
-                    scalar_t alpha_Ajl = alpha*A(j, l);
-                    for (int64_t i = j; i < n; ++i)
-                        C(i, j) += A(i, l)*alpha_Ajl;
-                }
-            }
-        }
-    }
-    else { // trans == Op::Trans
-        if (uplo != Uplo::Lower) {
-            // uplo == Uplo::Upper or uplo == Uplo::General
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = 0; i <= j; ++i) {
-                    scalar_t sum = zero;
-                    for (int64_t l = 0; l < k; ++l)
-                        sum += A(l, i) * A(l, j);
-                    C(i, j) = alpha*sum + beta*C(i, j);
-                }
-            }
-        }
-        else { // uplo == Uplo::Lower
-            for (int64_t j = 0; j < n; ++j) {
-                for (int64_t i = j; i < n; ++i) {
-                    scalar_t sum = zero;
-                    for (int64_t l = 0; l < k; ++l) {
-                        sum +=  A(l, i) * A(l, j);
-                    }
-                    C(i, j) = alpha*sum + beta*C(i, j);
-                }
-            }
-        }
-    }
+    // compute only the uplo triangle (upper if General) with the packed
+    // gemm engine: C = alpha op(A) op(A)^T + beta C
+    internal::gemmt_packed< scalar_t >(
+        (uplo == Uplo::Lower ? Uplo::Lower : Uplo::Upper), n, k,
+        alpha, internal::OpView< scalar_t, TA >( trans, A, lda ),
+               internal::OpView< scalar_t, TA >(
+                   (trans == Op::NoTrans ? Op::Trans : Op::NoTrans), A, lda ),
+        beta, C, ldc, false );
 
     if (uplo == Uplo::General) {
         for (int64_t j = 0; j < n; ++j) {
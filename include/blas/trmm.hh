@@ -7,86 +7,20 @@
 #define BLAS_TRMM_HH
 
 #include "blas/util.hh"
+#include "blas/gemm_packed.hh"
 
 #include <limits>
 
 namespace blas {
+namespace internal {
 
-// =============================================================================
-/// Triangular matrix-matrix multiply:
-/// \[
-///     B = \alpha op(A) B,
-/// \]
-/// or
-/// \[
-///     B = \alpha B op(A),
-/// \]
-/// where $op(A)$ is one of
-///     $op(A) = A$,
-///     $op(A) = A^T$, or
-///     $op(A) = A^H$,
-/// B is an m-by-n matrix, and A is an m-by-m or n-by-n, unit or non-unit,
-/// upper or lower triangular matrix.
+//------------------------------------------------------------------------------
+/// Unblocked trmm, for column-major A and B, alpha != 0.
+/// Used for the diagonal blocks of the recursive trmm.
+/// Arguments are as in blas::trmm, without layout; they are not checked.
 ///
-/// Generic implementation for arbitrary data types.
-///
-/// @param[in] layout
-///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
-///
-/// @param[in] side
-///     Whether $op(A)$ is on the left or right of B:
-///     - Side::Left:  $B = \alpha op(A) B$.
-///     - Side::Right: $B = \alpha B op(A)$.
-///
-/// @param[in] uplo
-///     What part of the matrix A is referenced,
-///     the opposite triangle being assumed to be zero:
-///     - Uplo::Lower: A is lower triangular.
-///     - Uplo::Upper: A is upper triangular.
-///     - Uplo::General is illegal (see @ref gemm instead).
-///
-/// @param[in] trans
-///     The form of $op(A)$:
-///     - Op::NoTrans:   $op(A) = A$.
-///     - Op::Trans:     $op(A) = A^T$.
-///     - Op::ConjTrans: $op(A) = A^H$.
-///
-/// @param[in] diag
-///     Whether A has a unit or non-unit diagonal:
-///     - Diag::Unit:    A is assumed to be unit triangular.
-///     - Diag::NonUnit: A is not assumed to be unit triangular.
-///
-/// @param[in] m
-///     Number of rows of matrix B. m >= 0.
-///
-/// @param[in] n
-///     Number of columns of matrix B. n >= 0.
-///
-/// @param[in] alpha
-///     Scalar alpha. If alpha is zero, A is not accessed.
-///
-/// @param[in] A
-///     - If side = Left:
-///       the m-by-m matrix A, stored in an lda-by-m array [RowMajor: m-by-lda].
-///     - If side = Right:
-///       the n-by-n matrix A, stored in an lda-by-n array [RowMajor: n-by-lda].
-///
-/// @param[in] lda
-///     Leading dimension of A.
-///     - If side = left:  lda >= max(1, m).
-///     - If side = right: lda >= max(1, n).
-///
-/// @param[in, out] B
-///     The m-by-n matrix B, stored in an ldb-by-n array [RowMajor: m-by-ldb].
-///
-/// @param[in] ldb
-///     Leading dimension of B. ldb >= max(1, m) [RowMajor: ldb >= max(1, n)].
-///
-/// @ingroup trmm
-
 template <typename TA, typename TB>
-void trmm(
-    blas::Layout layout,
+void trmm_unblocked(
     blas::Side side,
     blas::Uplo uplo,
     blas::Op trans,
@@ -102,54 +36,6 @@ void trmm(
     #define A(i_, j_) A[ (i_) + (j_)*lda ]
     #define B(i_, j_) B[ (i_) + (j_)*ldb ]
 
-    // constants
-    const scalar_t zero = 0;
-
-    // check arguments
-    blas_error_if( layout != Layout::ColMajor &&
-                   layout != Layout::RowMajor );
-    blas_error_if( side != Side::Left &&
-                   side != Side::Right );
-    blas_error_if( uplo != Uplo::Lower &&
-                   uplo != Uplo::Upper );
-    blas_error_if( trans != Op::NoTrans &&
-                   trans != Op::Trans &&
-                   trans != Op::ConjTrans );
-    blas_error_if( diag != Diag::NonUnit &&
-                   diag != Diag::Unit );
-    blas_error_if( m < 0 );
-    blas_error_if( n < 0 );
-
-    // adapt if row major
-    if (layout == Layout::RowMajor) {
-        side = (side == Side::Left)
-               ? Side::Right
-               : Side::Left;
-        if (uplo == Uplo::Lower)
-            uplo = Uplo::Upper;
-        else if (uplo == Uplo::Upper)
-            uplo = Uplo::Lower;
-        std::swap( m, n );
-    }
-
-    // check remaining arguments
-    blas_error_if( lda < ((side == Side::Left) ? m : n) );
-    blas_error_if( ldb < m );
-
-    // quick return
-    if (m == 0 || n == 0)
-        return;
-
-    // alpha == zero
-    if (alpha == zero) {
-        for (int64_t j = 0; j < n; ++j) {
-            for (int64_t i = 0; i < m; ++i)
-                B(i, j) = zero;
-        }
-        return;
-    }
-
-    // alpha != zero
     if (side == Side::Left) {
         if (trans == Op::NoTrans) {
             if (uplo == Uplo::Upper) {
@@ -335,6 +221,254 @@ void trmm(
     #undef B
 }
 
+//------------------------------------------------------------------------------
+/// Recursive trmm, for column-major A and B, alpha != 0.
+/// Splits the triangular dimension of A in two. The half of B that
+/// depends on both halves is multiplied by its diagonal block first,
+/// then updated in place by a packed gemm with the other, still original,
+/// half of B; the other half is then multiplied by its diagonal block.
+/// Blocks of nb or less are done by trmm_unblocked, so nearly all of
+/// the flops are done by the gemm micro-kernel.
+/// Arguments are as in blas::trmm, without layout; they are not checked.
+///
+template <typename TA, typename TB>
+void trmm_recursive(
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m,
+    int64_t n,
+    blas::scalar_type<TA, TB> alpha,
+    TA const *A, int64_t lda,
+    TB       *B, int64_t ldb )
+{
+    typedef blas::scalar_type<TA, TB> scalar_t;
+
+    // block size for the unblocked diagonal multiplies
+    const int64_t nb = 64;
+
+    const scalar_t one = 1;
+
+    int64_t k = (side == Side::Left ? m : n);
+    if (k <= nb) {
+        trmm_unblocked( side, uplo, trans, diag, m, n, alpha, A, lda, B, ldb );
+        return;
+    }
+
+    // split op(A) = [ A11 A12; A21 A22 ], with k1 a multiple of nb
+    int64_t k1 = blas::max( nb, k / 2 / nb * nb );
+    int64_t k2 = k - k1;
+    TA const* A11 = A;
+    TA const* A22 = &A[ k1 + k1*lda ];
+
+    // op(A) is lower if A is lower and not transposed, or upper and transposed
+    bool lower = (uplo == Uplo::Lower) == (trans == Op::NoTrans);
+
+    // op(A)21 is A21 if not transposed, else A12, which starts at A(0, k1)
+    TA const* opA21 = (trans == Op::NoTrans ? &A[ k1 ] : &A[ k1*lda ]);
+    TA const* opA12 = (trans == Op::NoTrans ? &A[ k1*lda ] : &A[ k1 ]);
+
+    if (side == Side::Left) {
+        // B = [ B1; B2 ], with k1 and k2 rows
+        TB* B1 = B;
+        TB* B2 = &B[ k1 ];
+        if (lower) {
+            // B2 = alpha op(A22) B2 + alpha op(A)21 B1
+            // B1 = alpha op(A11) B1
+            trmm_recursive( side, uplo, trans, diag, k2, n, alpha, A22, lda, B2, ldb );
+            gemm_packed< scalar_t >(
+                k2, n, k1,
+                alpha, OpView< scalar_t, TA >( trans, opA21, lda ),
+                       OpView< scalar_t, TB >( Op::NoTrans, B1, ldb ),
+                one, B2, ldb );
+            trmm_recursive( side, uplo, trans, diag, k1, n, alpha, A11, lda, B1, ldb );
+        }
+        else {
+            // B1 = alpha op(A11) B1 + alpha op(A)12 B2
+            // B2 = alpha op(A22) B2
+            trmm_recursive( side, uplo, trans, diag, k1, n, alpha, A11, lda, B1, ldb );
+            gemm_packed< scalar_t >(
+                k1, n, k2,
+                alpha, OpView< scalar_t, TA >( trans, opA12, lda ),
+                       OpView< scalar_t, TB >( Op::NoTrans, B2, ldb ),
+                one, B1, ldb );
+            trmm_recursive( side, uplo, trans, diag, k2, n, alpha, A22, lda, B2, ldb );
+        }
+    }
+    else { // side == Side::Right
+        // B = [ B1, B2 ], with k1 and k2 columns
+        TB* B1 = B;
+        TB* B2 = &B[ k1*ldb ];
+        if (lower) {
+            // B1 = alpha B1 op(A11) + alpha B2 op(A)21
+            // B2 = alpha B2 op(A22)
+            trmm_recursive( side, uplo, trans, diag, m, k1, alpha, A11, lda, B1, ldb );
+            gemm_packed< scalar_t >(
+                m, k1, k2,
+                alpha, OpView< scalar_t, TB >( Op::NoTrans, B2, ldb ),
+                       OpView< scalar_t, TA >( trans, opA21, lda ),
+                one, B1, ldb );
+            trmm_recursive( side, uplo, trans, diag, m, k2, alpha, A22, lda, B2, ldb );
+        }
+        else {
+            // B2 = alpha B2 op(A22) + alpha B1 op(A)12
+            // B1 = alpha B1 op(A11)
+            trmm_recursive( side, uplo, trans, diag, m, k2, alpha, A22, lda, B2, ldb );
+            gemm_packed< scalar_t >(
+                m, k2, k1,
+                alpha, OpView< scalar_t, TB >( Op::NoTrans, B1, ldb ),
+                       OpView< scalar_t, TA >( trans, opA12, lda ),
+                one, B2, ldb );
+            trmm_recursive( side, uplo, trans, diag, m, k1, alpha, A11, lda, B1, ldb );
+        }
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+/// Triangular matrix-matrix multiply:
+/// \[
+///     B = \alpha op(A) B,
+/// \]
+/// or
+/// \[
+///     B = \alpha B op(A),
+/// \]
+/// where $op(A)$ is one of
+///     $op(A) = A$,
+///     $op(A) = A^T$, or
+///     $op(A) = A^H$,
+/// B is an m-by-n matrix, and A is an m-by-m or n-by-n, unit or non-unit,
+/// upper or lower triangular matrix.
+///
+/// Generic implementation for arbitrary data types.
+/// Uses a recursive algorithm, in place in B: small diagonal blocks are
+/// multiplied directly and the off-diagonal updates are done by the packed
+/// gemm engine (see blas/gemm_packed.hh), so it runs at Level 3 speed.
+///
+/// @param[in] layout
+///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
+///
+/// @param[in] side
+///     Whether $op(A)$ is on the left or right of B:
+///     - Side::Left:  $B = \alpha op(A) B$.
+///     - Side::Right: $B = \alpha B op(A)$.
+///
+/// @param[in] uplo
+///     What part of the matrix A is referenced,
+///     the opposite triangle being assumed to be zero:
+///     - Uplo::Lower: A is lower triangular.
+///     - Uplo::Upper: A is upper triangular.
+///     - Uplo::General is illegal (see @ref gemm instead).
+///
+/// @param[in] trans
+///     The form of $op(A)$:
+///     - Op::NoTrans:   $op(A) = A$.
+///     - Op::Trans:     $op(A) = A^T$.
+///     - Op::ConjTrans: $op(A) = A^H$.
+///
+/// @param[in] diag
+///     Whether A has a unit or non-unit diagonal:
+///     - Diag::Unit:    A is assumed to be unit triangular.
+///     - Diag::NonUnit: A is not assumed to be unit triangular.
+///
+/// @param[in] m
+///     Number of rows of matrix B. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of matrix B. n >= 0.
+///
+/// @param[in] alpha
+///     Scalar alpha. If alpha is zero, A is not accessed.
+///
+/// @param[in] A
+///     - If side = Left:
+///       the m-by-m matrix A, stored in an lda-by-m array [RowMajor: m-by-lda].
+///     - If side = Right:
+///       the n-by-n matrix A, stored in an lda-by-n array [RowMajor: n-by-lda].
+///
+/// @param[in] lda
+///     Leading dimension of A.
+///     - If side = left:  lda >= max(1, m).
+///     - If side = right: lda >= max(1, n).
+///
+/// @param[in, out] B
+///     The m-by-n matrix B, stored in an ldb-by-n array [RowMajor: m-by-ldb].
+///
+/// @param[in] ldb
+///     Leading dimension of B. ldb >= max(1, m) [RowMajor: ldb >= max(1, n)].
+///
+/// @ingroup trmm
+
+template <typename TA, typename TB>
+void trmm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m,
+    int64_t n,
+    blas::scalar_type<TA, TB> alpha,
+    TA const *A, int64_t lda,
+    TB       *B, int64_t ldb )
+{
+    typedef blas::scalar_type<TA, TB> scalar_t;
+
+    // constants
+    const scalar_t zero = 0;
+
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( side != Side::Left &&
+                   side != Side::Right );
+    blas_error_if( uplo != Uplo::Lower &&
+                   uplo != Uplo::Upper );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( diag != Diag::NonUnit &&
+                   diag != Diag::Unit );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    // adapt if row major
+    if (layout == Layout::RowMajor) {
+        side = (side == Side::Left)
+               ? Side::Right
+               : Side::Left;
+        if (uplo == Uplo::Lower)
+            uplo = Uplo::Upper;
+        else if (uplo == Uplo::Upper)
+            uplo = Uplo::Lower;
+        std::swap( m, n );
+    }
+
+    // check remaining arguments
+    blas_error_if( lda < ((side == Side::Left) ? m : n) );
+    blas_error_if( ldb < m );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    // alpha == zero
+    if (alpha == zero) {
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i)
+                B[ i + j*ldb ] = zero;
+        }
+        return;
+    }
+
+    // alpha != zero
+    internal::trmm_recursive( side, uplo, trans, diag, m, n,
+                              alpha, A, lda, B, ldb );
+}
+
 }  // namespace blas
 
 #endif        //  #ifndef BLAS_TRMM_HH
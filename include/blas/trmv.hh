@@ -7,69 +7,26 @@
 #define BLAS_TRMV_HH
 
 #include "blas/util.hh"
+#include "blas/gemv.hh"
 
 #include <limits>
 
 namespace blas {
 
-// =============================================================================
-/// Triangular matrix-vector multiply:
-/// \[
-///     x = op(A) x,
-/// \]
-/// where $op(A)$ is one of
-///     $op(A) = A$,
-///     $op(A) = A^T$, or
-///     $op(A) = A^H$,
-/// x is a vector,
-/// and A is an n-by-n, unit or non-unit, upper or lower triangular matrix.
-///
-/// Generic implementation for arbitrary data types.
-///
-/// @param[in] layout
-///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
-///
-/// @param[in] uplo
-///     What part of the matrix A is referenced,
-///     the opposite triangle being assumed to be zero.
-///     - Uplo::Lower: A is lower triangular.
-///     - Uplo::Upper: A is upper triangular.
-///
-/// @param[in] trans
-///     The operation to be performed:
-///     - Op::NoTrans:   $x = A   x$,
-///     - Op::Trans:     $x = A^T x$,
-///     - Op::ConjTrans: $x = A^H x$.
-///
-/// @param[in] diag
-///     Whether A has a unit or non-unit diagonal:
-///     - Diag::Unit:    A is assumed to be unit triangular.
-///                      The diagonal elements of A are not referenced.
-///     - Diag::NonUnit: A is not assumed to be unit triangular.
-///
-/// @param[in] n
-///     Number of rows and columns of the matrix A. n >= 0.
-///
-/// @param[in] A
-///     The n-by-n matrix A, stored in an lda-by-n array [RowMajor: n-by-lda].
-///
-/// @param[in] lda
-///     Leading dimension of A. lda >= max(1, n).
-///
-/// @param[in, out] x
-///     The n-element vector x, in an array of length (n-1)*abs(incx) + 1.
-///
-/// @param[in] incx
-///     Stride between elements of x. incx must not be zero.
-///     If incx < 0, uses elements of x in reverse order: x(n-1), ..., x(0).
-///
-/// @ingroup trmv
+namespace internal {
 
+//------------------------------------------------------------------------------
+/// Unblocked trmv by column updates, for column-major A.
+/// Used for the diagonal blocks of the blocked trmv,
+/// and for strided or mixed-precision x.
+/// Arguments are as in blas::trmv after the row-major adjustment:
+/// doconj conjugates A for trans = NoTrans. They are not checked.
+///
 template <typename TA, typename TX>
-void trmv(
-    blas::Layout layout,
+void trmv_unblocked(
     blas::Uplo uplo,
     blas::Op trans,
+    bool doconj,
     blas::Diag diag,
     int64_t n,
     TA const *A, int64_t lda,
@@ -77,40 +34,6 @@ void trmv(
 {
     #define A(i_, j_) A[ (i_) + (j_)*lda ]
 
-    // check arguments
-    blas_error_if( layout != Layout::ColMajor &&
-                   layout != Layout::RowMajor );
-    blas_error_if( uplo != Uplo::Lower &&
-                   uplo != Uplo::Upper );
-    blas_error_if( trans != Op::NoTrans &&
-                   trans != Op::Trans &&
-                   trans != Op::ConjTrans );
-    blas_error_if( diag != Diag::NonUnit &&
-                   diag != Diag::Unit );
-    blas_error_if( n < 0 );
-    blas_error_if( lda < n );
-    blas_error_if( incx == 0 );
-
-    // quick return
-    if (n == 0)
-        return;
-
-    // for row major, swap lower <=> upper and
-    // A => A^T; A^T => A; A^H => A & conj
-    bool doconj = false;
-    if (layout == Layout::RowMajor) {
-        uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
-        if (trans == Op::NoTrans) {
-            trans = Op::Trans;
-        }
-        else {
-            if (trans == Op::ConjTrans) {
-                doconj = true;
-            }
-            trans = Op::NoTrans;
-        }
-    }
-
     bool nonunit = (diag == Diag::NonUnit);
     int64_t kx = (incx > 0 ? 0 : (-n + 1)*incx);
 
@@ -397,6 +320,210 @@ void trmv(
     #undef A
 }
 
+//------------------------------------------------------------------------------
+/// Block size for the blocked trmv.
+const int64_t trmv_nb = 64;
+
+//------------------------------------------------------------------------------
+/// Blocked trmv, for column-major A and unit-stride x.
+/// Diagonal blocks are multiplied by trmv_unblocked, while in cache;
+/// off-diagonal blocks are applied by the multi-column gemv kernels,
+/// so each element of A is streamed once.
+/// Blocks are ordered so each gemv reads parts of x not yet overwritten.
+/// Arguments are as in trmv_unblocked; they are not checked.
+///
+template <typename TA, typename TX>
+void trmv_blocked(
+    blas::Uplo uplo,
+    blas::Op trans,
+    bool doconj,
+    blas::Diag diag,
+    int64_t n,
+    TA const *A, int64_t lda,
+    TX       *x )
+{
+    typedef blas::scalar_type<TA, TX> scalar_t;
+
+    #define A(i_, j_) A[ (i_) + (j_)*lda ]
+
+    const scalar_t one = 1;
+    const int64_t nb = trmv_nb;
+
+    if (trans == Op::NoTrans) {
+        if (uplo == Uplo::Upper) {
+            // x1 += A12 x2; x2 = A22 x2
+            for (int64_t j = 0; j < n; j += nb) {
+                int64_t jb = blas::min( nb, n - j );
+                if (doconj)
+                    gemv_n<true>( j, jb, one, &A( 0, j ), lda,
+                                  &x[ j ], 1, x, 1 );
+                else
+                    gemv_n<false>( j, jb, one, &A( 0, j ), lda,
+                                   &x[ j ], 1, x, 1 );
+                trmv_unblocked( uplo, trans, doconj, diag, jb,
+                                &A( j, j ), lda, &x[ j ], 1 );
+            }
+        }
+        else {
+            // x2 += A21 x1; x1 = A11 x1
+            for (int64_t j = (n - 1) / nb * nb; j >= 0; j -= nb) {
+                int64_t jb = blas::min( nb, n - j );
+                if (doconj)
+                    gemv_n<true>( n - j - jb, jb, one, &A( j + jb, j ), lda,
+                                  &x[ j ], 1, &x[ j + jb ], 1 );
+                else
+                    gemv_n<false>( n - j - jb, jb, one, &A( j + jb, j ), lda,
+                                   &x[ j ], 1, &x[ j + jb ], 1 );
+                trmv_unblocked( uplo, trans, doconj, diag, jb,
+                                &A( j, j ), lda, &x[ j ], 1 );
+            }
+        }
+    }
+    else {
+        bool conj_A = (trans == Op::ConjTrans);
+        if (uplo == Uplo::Upper) {
+            // x2 = A22^T x2 + A12^T x1
+            for (int64_t j = (n - 1) / nb * nb; j >= 0; j -= nb) {
+                int64_t jb = blas::min( nb, n - j );
+                trmv_unblocked( uplo, trans, doconj, diag, jb,
+                                &A( j, j ), lda, &x[ j ], 1 );
+                if (conj_A)
+                    gemv_t<true>( j, jb, one, &A( 0, j ), lda,
+                                  x, 1, &x[ j ], 1 );
+                else
+                    gemv_t<false>( j, jb, one, &A( 0, j ), lda,
+                                   x, 1, &x[ j ], 1 );
+            }
+        }
+        else {
+            // x1 = A11^T x1 + A21^T x2
+            for (int64_t j = 0; j < n; j += nb) {
+                int64_t jb = blas::min( nb, n - j );
+                trmv_unblocked( uplo, trans, doconj, diag, jb,
+                                &A( j, j ), lda, &x[ j ], 1 );
+                if (conj_A)
+                    gemv_t<true>( n - j - jb, jb, one, &A( j + jb, j ), lda,
+                                  &x[ j + jb ], 1, &x[ j ], 1 );
+                else
+                    gemv_t<false>( n - j - jb, jb, one, &A( j + jb, j ), lda,
+                                   &x[ j + jb ], 1, &x[ j ], 1 );
+            }
+        }
+    }
+
+    #undef A
+}
+}  // namespace internal
+
+// =============================================================================
+/// Triangular matrix-vector multiply:
+/// \[
+///     x = op(A) x,
+/// \]
+/// where $op(A)$ is one of
+///     $op(A) = A$,
+///     $op(A) = A^T$, or
+///     $op(A) = A^H$,
+/// x is a vector,
+/// and A is an n-by-n, unit or non-unit, upper or lower triangular matrix.
+///
+/// Generic implementation for arbitrary data types.
+/// For unit-stride x, A is processed in blocks: diagonal blocks are
+/// multiplied directly, and off-diagonal blocks are applied by gemv kernels.
+///
+/// @param[in] layout
+///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
+///
+/// @param[in] uplo
+///     What part of the matrix A is referenced,
+///     the opposite triangle being assumed to be zero.
+///     - Uplo::Lower: A is lower triangular.
+///     - Uplo::Upper: A is upper triangular.
+///
+/// @param[in] trans
+///     The operation to be performed:
+///     - Op::NoTrans:   $x = A   x$,
+///     - Op::Trans:     $x = A^T x$,
+///     - Op::ConjTrans: $x = A^H x$.
+///
+/// @param[in] diag
+///     Whether A has a unit or non-unit diagonal:
+///     - Diag::Unit:    A is assumed to be unit triangular.
+///                      The diagonal elements of A are not referenced.
+///     - Diag::NonUnit: A is not assumed to be unit triangular.
+///
+/// @param[in] n
+///     Number of rows and columns of the matrix A. n >= 0.
+///
+/// @param[in] A
+///     The n-by-n matrix A, stored in an lda-by-n array [RowMajor: n-by-lda].
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= max(1, n).
+///
+/// @param[in, out] x
+///     The n-element vector x, in an array of length (n-1)*abs(incx) + 1.
+///
+/// @param[in] incx
+///     Stride between elements of x. incx must not be zero.
+///     If incx < 0, uses elements of x in reverse order: x(n-1), ..., x(0).
+///
+/// @ingroup trmv
+
+template <typename TA, typename TX>
+void trmv(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t n,
+    TA const *A, int64_t lda,
+    TX       *x, int64_t incx )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( uplo != Uplo::Lower &&
+                   uplo != Uplo::Upper );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( diag != Diag::NonUnit &&
+                   diag != Diag::Unit );
+    blas_error_if( n < 0 );
+    blas_error_if( lda < n );
+    blas_error_if( incx == 0 );
+
+    // quick return
+    if (n == 0)
+        return;
+
+    // for row major, swap lower <=> upper and
+    // A => A^T; A^T => A; A^H => A & conj
+    bool doconj = false;
+    if (layout == Layout::RowMajor) {
+        uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+        if (trans == Op::NoTrans) {
+            trans = Op::Trans;
+        }
+        else {
+            if (trans == Op::ConjTrans) {
+                doconj = true;
+            }
+            trans = Op::NoTrans;
+        }
+    }
+
+    if (incx == 1 && std::is_same< TX, scalar_type<TA, TX> >::value
+        && n > internal::trmv_nb) {
+        internal::trmv_blocked( uplo, trans, doconj, diag, n, A, lda, x );
+    }
+    else {
+        internal::trmv_unblocked( uplo, trans, doconj, diag, n, A, lda,
+                                  x, incx );
+    }
+}
+
 }  // namespace blas
 
 #endif        //  #ifndef BLAS_TRMV_HH
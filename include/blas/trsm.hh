@@ -7,91 +7,20 @@
 #define BLAS_TRSM_HH
 
 #include "blas/util.hh"
+#include "blas/gemm_packed.hh"
 
 #include <limits>
 
 namespace blas {
+namespace internal {
 
-// =============================================================================
-/// Solve the triangular matrix-vector equation
-/// \[
-///     op(A) X = \alpha B,
-/// \]
-/// or
-/// \[
-///     X op(A) = \alpha B,
-/// \]
-/// where $op(A)$ is one of
-///     $op(A) = A$,
-///     $op(A) = A^T$, or
-///     $op(A) = A^H$,
-/// X and B are m-by-n matrices, and A is an m-by-m or n-by-n, unit or non-unit,
-/// upper or lower triangular matrix.
-///
-/// No test for singularity or near-singularity is included in this
-/// routine. Such tests must be performed before calling this routine.
-/// @see latrs for a more numerically robust implementation.
+//------------------------------------------------------------------------------
+/// Unblocked trsm by substitution, for column-major A and B, alpha != 0.
+/// Used for the diagonal blocks of the recursive trsm.
+/// Arguments are as in blas::trsm, without layout; they are not checked.
 ///
-/// Generic implementation for arbitrary data types.
-///
-/// @param[in] layout
-///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
-///
-/// @param[in] side
-///     Whether $op(A)$ is on the left or right of X:
-///     - Side::Left:  $op(A) X = B$.
-///     - Side::Right: $X op(A) = B$.
-///
-/// @param[in] uplo
-///     What part of the matrix A is referenced,
-///     the opposite triangle being assumed to be zero:
-///     - Uplo::Lower: A is lower triangular.
-///     - Uplo::Upper: A is upper triangular.
-///
-/// @param[in] trans
-///     The form of $op(A)$:
-///     - Op::NoTrans:   $op(A) = A$.
-///     - Op::Trans:     $op(A) = A^T$.
-///     - Op::ConjTrans: $op(A) = A^H$.
-///
-/// @param[in] diag
-///     Whether A has a unit or non-unit diagonal:
-///     - Diag::Unit:    A is assumed to be unit triangular.
-///     - Diag::NonUnit: A is not assumed to be unit triangular.
-///
-/// @param[in] m
-///     Number of rows of matrices B and X. m >= 0.
-///
-/// @param[in] n
-///     Number of columns of matrices B and X. n >= 0.
-///
-/// @param[in] alpha
-///     Scalar alpha. If alpha is zero, A is not accessed.
-///
-/// @param[in] A
-///     - If side = Left:
-///       the m-by-m matrix A, stored in an lda-by-m array [RowMajor: m-by-lda].
-///     - If side = Right:
-///       the n-by-n matrix A, stored in an lda-by-n array [RowMajor: n-by-lda].
-///
-/// @param[in] lda
-///     Leading dimension of A.
-///     - If side = left:  lda >= max(1, m).
-///     - If side = right: lda >= max(1, n).
-///
-/// @param[in, out] B
-///     On entry,
-///     the m-by-n matrix B, stored in an ldb-by-n array [RowMajor: m-by-ldb].
-///     On exit, overwritten by the solution matrix X.
-///
-/// @param[in] ldb
-///     Leading dimension of B. ldb >= max(1, m) [RowMajor: ldb >= max(1, n)].
-///
-/// @ingroup trsm
-
 template <typename TA, typename TB>
-void trsm(
-    blas::Layout layout,
+void trsm_unblocked(
     blas::Side side,
     blas::Uplo uplo,
     blas::Op trans,
@@ -107,54 +36,6 @@ void trsm(
     #define A(i_, j_) A[ (i_) + (j_)*lda ]
     #define B(i_, j_) B[ (i_) + (j_)*ldb ]
 
-    // constants
-    const scalar_t zero = 0;
-
-    // check arguments
-    blas_error_if( layout != Layout::ColMajor &&
-                   layout != Layout::RowMajor );
-    blas_error_if( side != Side::Left &&
-                   side != Side::Right );
-    blas_error_if( uplo != Uplo::Lower &&
-                   uplo != Uplo::Upper );
-    blas_error_if( trans != Op::NoTrans &&
-                   trans != Op::Trans &&
-                   trans != Op::ConjTrans );
-    blas_error_if( diag != Diag::NonUnit &&
-                   diag != Diag::Unit );
-    blas_error_if( m < 0 );
-    blas_error_if( n < 0 );
-
-    // adapt if row major
-    if (layout == Layout::RowMajor) {
-        side = (side == Side::Left)
-               ? Side::Right
-               : Side::Left;
-        if (uplo == Uplo::Lower)
-            uplo = Uplo::Upper;
-        else if (uplo == Uplo::Upper)
-            uplo = Uplo::Lower;
-        std::swap( m, n );
-    }
-
-    // check remaining arguments
-    blas_error_if( lda < ((side == Side::Left) ? m : n) );
-    blas_error_if( ldb < m );
-
-    // quick return
-    if (m == 0 || n == 0)
-        return;
-
-    // alpha == zero
-    if (alpha == zero) {
-        for (int64_t j = 0; j < n; ++j) {
-            for (int64_t i = 0; i < m; ++i)
-                B(i, j) = zero;
-        }
-        return;
-    }
-
-    // alpha != zero
     if (side == Side::Left) {
         if (trans == Op::NoTrans) {
             if (uplo == Uplo::Upper) {
@@ -332,6 +213,262 @@ void trsm(
     #undef B
 }
 
+//------------------------------------------------------------------------------
+/// Recursive trsm, for column-major A and B, alpha != 0.
+/// Splits the triangular dimension of A in two:
+/// one half is solved recursively, the other half of B is updated
+/// by a packed gemm, then the second half is solved recursively.
+/// Blocks of nb or less are solved by trsm_unblocked, so nearly all of
+/// the flops are done by the gemm micro-kernel.
+/// Arguments are as in blas::trsm, without layout; they are not checked.
+///
+template <typename TA, typename TB>
+void trsm_recursive(
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m,
+    int64_t n,
+    blas::scalar_type<TA, TB> alpha,
+    TA const *A, int64_t lda,
+    TB       *B, int64_t ldb )
+{
+    typedef blas::scalar_type<TA, TB> scalar_t;
+
+    // block size for the unblocked diagonal solves
+    const int64_t nb = 64;
+
+    const scalar_t one = 1;
+
+    int64_t k = (side == Side::Left ? m : n);
+    if (k <= nb) {
+        trsm_unblocked( side, uplo, trans, diag, m, n, alpha, A, lda, B, ldb );
+        return;
+    }
+
+    // split op(A) = [ A11 A12; A21 A22 ], with k1 a multiple of nb
+    int64_t k1 = blas::max( nb, k / 2 / nb * nb );
+    int64_t k2 = k - k1;
+    TA const* A11 = A;
+    TA const* A22 = &A[ k1 + k1*lda ];
+
+    // op(A) is lower if A is lower and not transposed, or upper and transposed
+    bool lower = (uplo == Uplo::Lower) == (trans == Op::NoTrans);
+
+    // op(A)21 is A21 if not transposed, else A12, which starts at A(0, k1)
+    TA const* opA21 = (trans == Op::NoTrans ? &A[ k1 ] : &A[ k1*lda ]);
+    TA const* opA12 = (trans == Op::NoTrans ? &A[ k1*lda ] : &A[ k1 ]);
+
+    if (side == Side::Left) {
+        // B = [ B1; B2 ], with k1 and k2 rows
+        TB* B1 = B;
+        TB* B2 = &B[ k1 ];
+        if (lower) {
+            // op(A11) X1 = alpha B1
+            // B2 = alpha B2 - op(A)21 X1
+            // op(A22) X2 = B2
+            trsm_recursive( side, uplo, trans, diag, k1, n, alpha, A11, lda, B1, ldb );
+            gemm_packed< scalar_t >(
+                k2, n, k1,
+                -one, OpView< scalar_t, TA >( trans, opA21, lda ),
+                      OpView< scalar_t, TB >( Op::NoTrans, B1, ldb ),
+                alpha, B2, ldb );
+            trsm_recursive( side, uplo, trans, diag, k2, n, one, A22, lda, B2, ldb );
+        }
+        else {
+            // op(A22) X2 = alpha B2
+            // B1 = alpha B1 - op(A)12 X2
+            // op(A11) X1 = B1
+            trsm_recursive( side, uplo, trans, diag, k2, n, alpha, A22, lda, B2, ldb );
+            gemm_packed< scalar_t >(
+                k1, n, k2,
+                -one, OpView< scalar_t, TA >( trans, opA12, lda ),
+                      OpView< scalar_t, TB >( Op::NoTrans, B2, ldb ),
+                alpha, B1, ldb );
+            trsm_recursive( side, uplo, trans, diag, k1, n, one, A11, lda, B1, ldb );
+        }
+    }
+    else { // side == Side::Right
+        // B = [ B1, B2 ], with k1 and k2 columns
+        TB* B1 = B;
+        TB* B2 = &B[ k1*ldb ];
+        if (lower) {
+            // X2 op(A22) = alpha B2
+            // B1 = alpha B1 - X2 op(A)21
+            // X1 op(A11) = B1
+            trsm_recursive( side, uplo, trans, diag, m, k2, alpha, A22, lda, B2, ldb );
+            gemm_packed< scalar_t >(
+                m, k1, k2,
+                -one, OpView< scalar_t, TB >( Op::NoTrans, B2, ldb ),
+                      OpView< scalar_t, TA >( trans, opA21, lda ),
+                alpha, B1, ldb );
+            trsm_recursive( side, uplo, trans, diag, m, k1, one, A11, lda, B1, ldb );
+        }
+        else {
+            // X1 op(A11) = alpha B1
+            // B2 = alpha B2 - X1 op(A)12
+            // X2 op(A22) = B2
+            trsm_recursive( side, uplo, trans, diag, m, k1, alpha, A11, lda, B1, ldb );
+            gemm_packed< scalar_t >(
+                m, k2, k1,
+                -one, OpView< scalar_t, TB >( Op::NoTrans, B1, ldb ),
+                      OpView< scalar_t, TA >( trans, opA12, lda ),
+                alpha, B2, ldb );
+            trsm_recursive( side, uplo, trans, diag, m, k2, one, A22, lda, B2, ldb );
+        }
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+/// Solve the triangular matrix-vector equation
+/// \[
+///     op(A) X = \alpha B,
+/// \]
+/// or
+/// \[
+///     X op(A) = \alpha B,
+/// \]
+/// where $op(A)$ is one of
+///     $op(A) = A$,
+///     $op(A) = A^T$, or
+///     $op(A) = A^H$,
+/// X and B are m-by-n matrices, and A is an m-by-m or n-by-n, unit or non-unit,
+/// upper or lower triangular matrix.
+///
+/// No test for singularity or near-singularity is included in this
+/// routine. Such tests must be performed before calling this routine.
+/// @see latrs for a more numerically robust implementation.
+///
+/// Generic implementation for arbitrary data types.
+/// Uses a recursive algorithm: small diagonal blocks are solved by
+/// substitution and the off-diagonal updates are done by the packed gemm
+/// engine (see blas/gemm_packed.hh), so it runs at Level 3 speed.
+///
+/// @param[in] layout
+///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
+///
+/// @param[in] side
+///     Whether $op(A)$ is on the left or right of X:
+///     - Side::Left:  $op(A) X = B$.
+///     - Side::Right: $X op(A) = B$.
+///
+/// @param[in] uplo
+///     What part of the matrix A is referenced,
+///     the opposite triangle being assumed to be zero:
+///     - Uplo::Lower: A is lower triangular.
+///     - Uplo::Upper: A is upper triangular.
+///
+/// @param[in] trans
+///     The form of $op(A)$:
+///     - Op::NoTrans:   $op(A) = A$.
+///     - Op::Trans:     $op(A) = A^T$.
+///     - Op::ConjTrans: $op(A) = A^H$.
+///
+/// @param[in] diag
+///     Whether A has a unit or non-unit diagonal:
+///     - Diag::Unit:    A is assumed to be unit triangular.
+///     - Diag::NonUnit: A is not assumed to be unit triangular.
+///
+/// @param[in] m
+///     Number of rows of matrices B and X. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of matrices B and X. n >= 0.
+///
+/// @param[in] alpha
+///     Scalar alpha. If alpha is zero, A is not accessed.
+///
+/// @param[in] A
+///     - If side = Left:
+///       the m-by-m matrix A, stored in an lda-by-m array [RowMajor: m-by-lda].
+///     - If side = Right:
+///       the n-by-n matrix A, stored in an lda-by-n array [RowMajor: n-by-lda].
+///
+/// @param[in] lda
+///     Leading dimension of A.
+///     - If side = left:  lda >= max(1, m).
+///     - If side = right: lda >= max(1, n).
+///
+/// @param[in, out] B
+///     On entry,
+///     the m-by-n matrix B, stored in an ldb-by-n array [RowMajor: m-by-ldb].
+///     On exit, overwritten by the solution matrix X.
+///
+/// @param[in] ldb
+///     Leading dimension of B. ldb >= max(1, m) [RowMajor: ldb >= max(1, n)].
+///
+/// @ingroup trsm
+
+template <typename TA, typename TB>
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m,
+    int64_t n,
+    blas::scalar_type<TA, TB> alpha,
+    TA const *A, int64_t lda,
+    TB       *B, int64_t ldb )
+{
+    typedef blas::scalar_type<TA, TB> scalar_t;
+
+    // constants
+    const scalar_t zero = 0;
+
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( side != Side::Left &&
+                   side != Side::Right );
+    blas_error_if( uplo != Uplo::Lower &&
+                   uplo != Uplo::Upper );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( diag != Diag::NonUnit &&
+                   diag != Diag::Unit );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    // adapt if row major
+    if (layout == Layout::RowMajor) {
+        side = (side == Side::Left)
+               ? Side::Right
+               : Side::Left;
+        if (uplo == Uplo::Lower)
+            uplo = Uplo::Upper;
+        else if (uplo == Uplo::Upper)
+            uplo = Uplo::Lower;
+        std::swap( m, n );
+    }
+
+    // check remaining arguments
+    blas_error_if( lda < ((side == Side::Left) ? m : n) );
+    blas_error_if( ldb < m );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    // alpha == zero
+    if (alpha == zero) {
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i)
+                B[ i + j*ldb ] = zero;
+        }
+        return;
+    }
+
+    // alpha != zero
+    internal::trsm_recursive( side, uplo, trans, diag, m, n,
+                              alpha, A, lda, B, ldb );
+}
+
 }  // namespace blas
 
 #endif        //  #ifndef BLAS_TRSM_HH
@@ -7,6 +7,7 @@
 #define BLAS_UTIL_HH
 
 #include <exception>
+#include <cmath>
 #include <complex>
 #include <cstdarg>
 #include <limits>
@@ -14,6 +15,12 @@
 
 #include <assert.h>
 
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "blas/float16.hh"
+
 namespace blas {
 
 /// Use to silence compiler warning of unused variable.
@@ -264,12 +271,27 @@ struct scalar_type_traits< T >
     using type = decay_t<T>;
 };
 
+// 16-bit storage types compute in float
+template <>
+struct scalar_type_traits< float16 >
+{
+    using type = float;
+};
+
+template <>
+struct scalar_type_traits< bfloat16 >
+{
+    using type = float;
+};
+
 // for two types
-// relies on type of ?: operator being the common type of its two arguments
+// relies on type of ?: operator being the common type of its two arguments,
+// after promoting each (e.g., float16 to float)
 template <typename T1, typename T2>
 struct scalar_type_traits< T1, T2 >
 {
-    using type = decay_t< decltype( true ? std::declval<T1>() : std::declval<T2>() ) >;
+    using type = decay_t< decltype( true ? std::declval< scalar_type<T1> >()
+                                         : std::declval< scalar_type<T2> >() ) >;
 };
 
 // for either or both complex,
@@ -305,10 +327,12 @@ struct scalar_type_traits< T1, T2, Types... >
 //
 // real_type< float >                               is float
 // real_type< float, double, complex<float> >       is double
+// real_type< float16 >                             is float
 //
 // scalar_type< float >                             is float
 // scalar_type< float, complex<float> >             is complex<float>
 // scalar_type< float, double, complex<float> >     is complex<double>
+// scalar_type< float16, bfloat16 >                 is float
 //
 // complex_type< float >                            is complex<float>
 // complex_type< float, double >                    is complex<double>
@@ -340,6 +364,19 @@ struct real_type_traits< std::complex<T> >
     using real_t = T;
 };
 
+// 16-bit storage types compute in float
+template <>
+struct real_type_traits< float16 >
+{
+    using real_t = float;
+};
+
+template <>
+struct real_type_traits< bfloat16 >
+{
+    using real_t = float;
+};
+
 // for two or more types
 template <typename T1, typename... Types>
 struct real_type_traits< T1, Types... >
@@ -487,9 +524,95 @@ inline const real_t root_max()
     return sqrt( safe_max<real_t>() * ulp<real_t>() );
 }
 
+// -----------------------------------------------------------------------------
+// Blue's scaling constants for sums of squares, as in LAPACK la_constants.
+//
+// __Further details__
+//
+// Blue JL (1978) A portable Fortran program to find the Euclidean norm of
+// a vector. ACM Trans Math Softw 4:15-23. https://doi.org/10.1145/355769.355771
+
+/// Blue's threshold below which squares may underflow (tsml)
+template <typename real_t>
+inline const real_t blue_min()
+{
+    const int expm = std::numeric_limits<real_t>::min_exponent;
+
+    return std::scalbn( real_t( 1 ), (expm - 1) / 2 );  // ceil, as expm < 0
+}
+
+/// Blue's threshold above which squares may overflow (tbig)
+template <typename real_t>
+inline const real_t blue_max()
+{
+    const int expM = std::numeric_limits<real_t>::max_exponent;
+    const int t = std::numeric_limits<real_t>::digits;
+
+    return std::scalbn( real_t( 1 ), (expM - t + 1) / 2 );
+}
+
+/// Blue's scaling factor for values below blue_min (ssml)
+template <typename real_t>
+inline const real_t blue_scaling_min()
+{
+    const int expm = std::numeric_limits<real_t>::min_exponent;
+    const int t = std::numeric_limits<real_t>::digits;
+
+    return std::scalbn( real_t( 1 ), -((expm - t - 1) / 2) );  // -floor
+}
+
+/// Blue's scaling factor for values above blue_max (sbig)
+template <typename real_t>
+inline const real_t blue_scaling_max()
+{
+    const int expM = std::numeric_limits<real_t>::max_exponent;
+    const int t = std::numeric_limits<real_t>::digits;
+
+    return std::scalbn( real_t( 1 ), -((expM + t) / 2) );  // -ceil
+}
+
 //==============================================================================
 namespace internal {
 
+// -----------------------------------------------------------------------------
+/// Vector length at or above which the generic Level 1 templates
+/// split the work across OpenMP threads, if compiled with OpenMP.
+const int64_t level1_omp_threshold = 65536;
+
+/// Number of matrix entries, m*n, at or above which the generic Level 2
+/// templates split the work across OpenMP threads, if compiled with OpenMP.
+const int64_t level2_omp_threshold = 65536;
+
+/// @return OpenMP max threads, or 1 without OpenMP.
+inline int64_t omp_max_threads()
+{
+    #ifdef _OPENMP
+        return omp_get_max_threads();
+    #else
+        return 1;
+    #endif
+}
+
+/// @return number of OpenMP threads in the current team, or 1 without OpenMP.
+inline int64_t omp_num_threads()
+{
+    #ifdef _OPENMP
+        return omp_get_num_threads();
+    #else
+        return 1;
+    #endif
+}
+
+/// @return OpenMP thread number in the current team, or 0 without OpenMP.
+inline int64_t omp_thread_num()
+{
+    #ifdef _OPENMP
+        return omp_get_thread_num();
+    #else
+        return 0;
+    #endif
+}
+
 // -----------------------------------------------------------------------------
 // internal helper function; throws Error if cond is true
 // called by blas_error_if macro
@@ -549,6 +672,48 @@ inline void abort_if( bool cond, const char* func,  const char* format, ... )
 
 }  // namespace internal
 
+//------------------------------------------------------------------------------
+/// @return number of heap allocations made so far, by any thread, for
+/// temporary vectors used in layout conversion (e.g., RowMajor complex
+/// gemv, ger, hemv, her). Calls that fit in the stack buffer or in the
+/// calling thread's existing workspace don't allocate, so the count
+/// doesn't change. Used by the tester to show whether a call allocated.
+///
+int64_t host_workspace_allocs();
+
+//------------------------------------------------------------------------------
+/// Frees the calling thread's workspace for temporary vectors (see
+/// host_workspace_allocs). Each thread keeps its workspace between calls,
+/// up to 1 MiB; a larger one is freed after the call that needed it.
+/// The next call that needs a workspace allocates it again.
+///
+void host_workspace_free();
+
+//------------------------------------------------------------------------------
+/// Level 1 threshold: vector length n at or above which CPU Level 1 calls
+/// (axpy, scal, copy, swap, dot, dotu, nrm2, asum) are split into chunks,
+/// one per OpenMP thread, each calling the vendor BLAS.
+/// Default 0 = disabled; n <= 0 disables splitting.
+/// The initial value is read from $BLASPP_PARALLEL_LEVEL1_THRESHOLD.
+///
+void    set_parallel_level1_threshold( int64_t n );
+
+/// @return Level 1 threshold; see set_parallel_level1_threshold.
+int64_t get_parallel_level1_threshold();
+
+//------------------------------------------------------------------------------
+/// Level 3 threshold: dimension n such that CPU Level 3 calls
+/// (gemm, hemm, symm, trsm, trmm, syrk, herk, syr2k, her2k) whose output
+/// has at least n*n entries are split into tiles, computed by OpenMP
+/// threads, each calling the vendor BLAS.
+/// Default 0 = disabled; n <= 0 disables tiling.
+/// The initial value is read from $BLASPP_PARALLEL_LEVEL3_THRESHOLD.
+///
+void    set_parallel_level3_threshold( int64_t n );
+
+/// @return Level 3 threshold; see set_parallel_level3_threshold.
+int64_t get_parallel_level3_threshold();
+
 // -----------------------------------------------------------------------------
 // internal macros to handle error checks
 #if defined(BLAS_ERROR_NDEBUG) || (defined(BLAS_ERROR_ASSERT) && defined(NDEBUG))
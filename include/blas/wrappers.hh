@@ -137,6 +137,27 @@ int64_t iamax(
     int64_t n,
     std::complex<double> const* x, int64_t incx );
 
+//------------------------------------------------------------------------------
+int64_t amax(
+    int64_t n,
+    float const* x, int64_t incx,
+    float* value );
+
+int64_t amax(
+    int64_t n,
+    double const* x, int64_t incx,
+    double* value );
+
+int64_t amax(
+    int64_t n,
+    std::complex<float> const* x, int64_t incx,
+    std::complex<float>* value );
+
+int64_t amax(
+    int64_t n,
+    std::complex<double> const* x, int64_t incx,
+    std::complex<double>* value );
+
 //------------------------------------------------------------------------------
 float nrm2(
     int64_t n,
@@ -1183,6 +1204,118 @@ void gemm(
     size_t batch_size,
     std::vector<int64_t>& info );
 
+//------------------------------------------------------------------------------
+// strided batch gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float const* B, int64_t ldb, int64_t strideB,
+    float beta,
+    float*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double const* B, int64_t ldb, int64_t strideB,
+    double beta,
+    double*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float> const* B, int64_t ldb, int64_t strideB,
+    std::complex<float> beta,
+    std::complex<float>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double> const* B, int64_t ldb, int64_t strideB,
+    std::complex<double> beta,
+    std::complex<double>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+//------------------------------------------------------------------------------
+// batch gemm, group API
+void gemm(
+    blas::Layout layout,
+    std::vector<blas::Op>   const& transA,
+    std::vector<blas::Op>   const& transB,
+    std::vector<int64_t>    const& m,
+    std::vector<int64_t>    const& n,
+    std::vector<int64_t>    const& k,
+    std::vector<float >     const& alpha,
+    std::vector<float*>     const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<float*>     const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<float >     const& beta,
+    std::vector<float*>     const& Carray, std::vector<int64_t> const& ldc,
+    std::vector<size_t>     const& group_size,
+    std::vector<int64_t>& info );
+
+void gemm(
+    blas::Layout layout,
+    std::vector<blas::Op>   const& transA,
+    std::vector<blas::Op>   const& transB,
+    std::vector<int64_t>    const& m,
+    std::vector<int64_t>    const& n,
+    std::vector<int64_t>    const& k,
+    std::vector<double >    const& alpha,
+    std::vector<double*>    const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<double*>    const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<double >    const& beta,
+    std::vector<double*>    const& Carray, std::vector<int64_t> const& ldc,
+    std::vector<size_t>     const& group_size,
+    std::vector<int64_t>& info );
+
+void gemm(
+    blas::Layout layout,
+    std::vector<blas::Op>   const& transA,
+    std::vector<blas::Op>   const& transB,
+    std::vector<int64_t>    const& m,
+    std::vector<int64_t>    const& n,
+    std::vector<int64_t>    const& k,
+    std::vector< std::complex<float>  > const& alpha,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<float>* > const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< std::complex<float>  > const& beta,
+    std::vector< std::complex<float>* > const& Carray, std::vector<int64_t> const& ldc,
+    std::vector<size_t>     const& group_size,
+    std::vector<int64_t>& info );
+
+void gemm(
+    blas::Layout layout,
+    std::vector<blas::Op>   const& transA,
+    std::vector<blas::Op>   const& transB,
+    std::vector<int64_t>    const& m,
+    std::vector<int64_t>    const& n,
+    std::vector<int64_t>    const& k,
+    std::vector< std::complex<double>  > const& alpha,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<double>* > const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< std::complex<double>  > const& beta,
+    std::vector< std::complex<double>* > const& Carray, std::vector<int64_t> const& ldc,
+    std::vector<size_t>     const& group_size,
+    std::vector<int64_t>& info );
+
 //------------------------------------------------------------------------------
 // batch hemm
 void hemm(
@@ -1241,6 +1374,56 @@ void hemm(
     size_t batch_size,
     std::vector<int64_t>& info );
 
+//------------------------------------------------------------------------------
+// strided batch hemm
+void hemm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float const* B, int64_t ldb, int64_t strideB,
+    float beta,
+    float*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void hemm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double const* B, int64_t ldb, int64_t strideB,
+    double beta,
+    double*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void hemm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float> const* B, int64_t ldb, int64_t strideB,
+    std::complex<float> beta,
+    std::complex<float>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void hemm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double> const* B, int64_t ldb, int64_t strideB,
+    std::complex<double> beta,
+    std::complex<double>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
 //------------------------------------------------------------------------------
 // batch her2k
 void her2k(
@@ -1353,6 +1536,52 @@ void herk(
     size_t batch_size,
     std::vector<int64_t>& info );
 
+//------------------------------------------------------------------------------
+// strided batch herk
+void herk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float beta,
+    float*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void herk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double beta,
+    double*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void herk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    float alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    float beta,
+    std::complex<float>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void herk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    double alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    double beta,
+    std::complex<double>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
 //------------------------------------------------------------------------------
 // batch symm
 void symm(
@@ -1411,6 +1640,56 @@ void symm(
     size_t batch_size,
     std::vector<int64_t>& info );
 
+//------------------------------------------------------------------------------
+// strided batch symm
+void symm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float const* B, int64_t ldb, int64_t strideB,
+    float beta,
+    float*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void symm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double const* B, int64_t ldb, int64_t strideB,
+    double beta,
+    double*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void symm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float> const* B, int64_t ldb, int64_t strideB,
+    std::complex<float> beta,
+    std::complex<float>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void symm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double> const* B, int64_t ldb, int64_t strideB,
+    std::complex<double> beta,
+    std::complex<double>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
 //------------------------------------------------------------------------------
 // batch syr2k
 void syr2k(
@@ -1523,6 +1802,52 @@ void syrk(
     size_t batch_size,
     std::vector<int64_t>& info );
 
+//------------------------------------------------------------------------------
+// strided batch syrk
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float beta,
+    float*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double beta,
+    double*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float> beta,
+    std::complex<float>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double> beta,
+    std::complex<double>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size );
+
 //------------------------------------------------------------------------------
 // batch trmm
 void trmm(
@@ -1581,6 +1906,56 @@ void trmm(
     size_t batch_size,
     std::vector<int64_t>& info );
 
+//------------------------------------------------------------------------------
+// strided batch trmm
+void trmm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size );
+
+void trmm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size );
+
+void trmm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float>*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size );
+
+void trmm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double>*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size );
+
 //------------------------------------------------------------------------------
 // batch trsm
 void trsm(
@@ -1639,5 +2014,55 @@ void trsm(
     size_t batch_size,
     std::vector<int64_t>& info );
 
+//------------------------------------------------------------------------------
+// strided batch trsm
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size );
+
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size );
+
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float>*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size );
+
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double>*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size );
+
 }  // namespace batch
 }  // namespace blas
@@ -8,6 +8,7 @@
 #include "blas_internal.hh"
 
 #include <limits>
+#include <vector>
 
 namespace blas {
 
@@ -77,6 +78,22 @@ real_type<scalar_t> asum(
     blas_int n_    = to_blas_int( n );
     blas_int incx_ = to_blas_int( incx );
 
+    // split long vectors across threads, if enabled;
+    // partial sums are added in chunk order, so results are reproducible
+    int64_t nchunks = internal::parallel_level1_chunks( n );
+    if (nchunks > 1) {
+        std::vector< real_type<scalar_t> > partial( nchunks, 0 );
+        internal::parallel_level1( n, nchunks,
+            [&]( int64_t c, int64_t i, int64_t len ) {
+                partial[ c ] = internal::asum(
+                    blas_int( len ), &x[ i*incx ], incx_ );
+            } );
+        real_type<scalar_t> result = 0;
+        for (int64_t c = 0; c < nchunks; ++c)
+            result += partial[ c ];
+        return result;
+    }
+
     // call low-level wrapper
     return internal::asum( n_, x, incx_ );
 }
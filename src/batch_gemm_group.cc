@@ -0,0 +1,319 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/fortran.h"
+#include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas.hh"
+#include "blas_internal.hh"
+
+#include <limits>
+
+namespace blas {
+
+//==============================================================================
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// CPU, group batched version.
+/// Group ig has group_size[ ig ] problems sharing transA[ ig ], m[ ig ],
+/// alpha[ ig ], etc.; Aarray, Barray, Carray hold the problems of all groups
+/// in order. Mid-level templated wrapper checks and converts arguments
+/// once per group, then calls the low-level group wrapper: once per group
+/// if the vendor's gemm_batch is available, otherwise on chunks of each
+/// group in parallel.
+/// @ingroup gemm_internal
+///
+template <typename scalar_t>
+void gemm(
+    blas::Layout layout,
+    std::vector<blas::Op>   const& transA,
+    std::vector<blas::Op>   const& transB,
+    std::vector<int64_t>    const& m,
+    std::vector<int64_t>    const& n,
+    std::vector<int64_t>    const& k,
+    std::vector<scalar_t >  const& alpha,
+    std::vector<scalar_t*>  const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<scalar_t*>  const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<scalar_t >  const& beta,
+    std::vector<scalar_t*>  const& Carray, std::vector<int64_t> const& ldc,
+    std::vector<size_t>     const& group_size,
+    std::vector<int64_t>& info )
+{
+    size_t batch_size = 0;
+    size_t group_count = group_size.size();
+    if (group_count == 0)
+        return;
+
+    blas_error_if( layout != Layout::ColMajor
+                   && layout != Layout::RowMajor );
+    blas_error_if( info.size() != 0
+                   && info.size() != group_count );
+
+    for (size_t ig = 0; ig < group_count; ++ig) {
+        batch_size += group_size[ ig ];
+    }
+
+    blas_error_if( transA.size() !=  group_count );
+    blas_error_if( transB.size() !=  group_count );
+    blas_error_if( m.size()      !=  group_count );
+    blas_error_if( n.size()      !=  group_count );
+    blas_error_if( k.size()      !=  group_count );
+    blas_error_if( alpha.size()  !=  group_count );
+    blas_error_if( lda.size()    !=  group_count );
+    blas_error_if( ldb.size()    !=  group_count );
+    blas_error_if( beta.size()   !=  group_count );
+    blas_error_if( ldc.size()    !=  group_count );
+
+    blas_error_if( Aarray.size() !=  batch_size );
+    blas_error_if( Barray.size() !=  batch_size );
+    blas_error_if( Carray.size() !=  batch_size );
+
+    if (info.size() > 0) {
+        // perform error checking
+        blas::batch::gemm_check(
+            layout, transA, transB, m, n, k,
+            alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
+            group_count, info );
+    }
+
+    // Arguments of one group, checked and converted to col-major.
+    struct Group {
+        char transA, transB;
+        blas_int m, n, k, lda, ldb, ldc;
+        scalar_t* const* Aarray;
+        scalar_t* const* Barray;
+        scalar_t* const* Carray;
+    };
+    // Chunk of count problems, starting at begin, in one group.
+    struct Chunk {
+        size_t group, begin;
+        blas_int count;
+    };
+    std::vector<Group> groups( group_count );
+    std::vector<Chunk> chunks;
+    std::vector<size_t> large;
+
+    #if defined(BLAS_HAVE_CBLAS_GEMM_BATCH)
+        const bool vendor_batch = true;
+    #else
+        const bool vendor_batch = false;
+    #endif
+
+    // threads are split between problems and BLAS calls by mean flops;
+    // the vendor's gemm_batch does its own threading
+    internal::BatchSplit split = { 1, 1 };
+    if (! vendor_batch && batch_size > 0) {
+        double gflop = 0;
+        for (size_t ig = 0; ig < group_count; ++ig) {
+            gflop += group_size[ ig ]
+                     * blas::Gflop< scalar_t >::gemm( m[ ig ], n[ ig ], k[ ig ] );
+        }
+        split = internal::batch_split( batch_size, gflop / batch_size );
+    }
+    int64_t nt = split.outer;
+    size_t ptr_begin = 0;  // First [ABC]array pointer in this group.
+    for (size_t ig = 0; ig < group_count; ++ig) {
+        blas_error_if( transA[ ig ] != Op::NoTrans &&
+                       transA[ ig ] != Op::Trans &&
+                       transA[ ig ] != Op::ConjTrans );
+        blas_error_if( transB[ ig ] != Op::NoTrans &&
+                       transB[ ig ] != Op::Trans &&
+                       transB[ ig ] != Op::ConjTrans );
+        blas_error_if( m[ ig ] < 0 );
+        blas_error_if( n[ ig ] < 0 );
+        blas_error_if( k[ ig ] < 0 );
+
+        if (layout == Layout::ColMajor) {
+            if (transA[ ig ] == Op::NoTrans)
+                blas_error_if( lda[ ig ] < m[ ig ] );
+            else
+                blas_error_if( lda[ ig ] < k[ ig ] );
+
+            if (transB[ ig ] == Op::NoTrans)
+                blas_error_if( ldb[ ig ] < k[ ig ] );
+            else
+                blas_error_if( ldb[ ig ] < n[ ig ] );
+
+            blas_error_if( ldc[ ig ] < m[ ig ] );
+        }
+        else {
+            if (transA[ ig ] != Op::NoTrans)
+                blas_error_if( lda[ ig ] < m[ ig ] );
+            else
+                blas_error_if( lda[ ig ] < k[ ig ] );
+
+            if (transB[ ig ] != Op::NoTrans)
+                blas_error_if( ldb[ ig ] < k[ ig ] );
+            else
+                blas_error_if( ldb[ ig ] < n[ ig ] );
+
+            blas_error_if( ldc[ ig ] < n[ ig ] );
+        }
+
+        Group& g = groups[ ig ];
+        g.transA = op2char( transA[ ig ] );
+        g.transB = op2char( transB[ ig ] );
+        g.m      = to_blas_int( m[ ig ] );
+        g.n      = to_blas_int( n[ ig ] );
+        g.k      = to_blas_int( k[ ig ] );
+        g.lda    = to_blas_int( lda[ ig ] );
+        g.ldb    = to_blas_int( ldb[ ig ] );
+        g.ldc    = to_blas_int( ldc[ ig ] );
+        g.Aarray = &Aarray[ ptr_begin ];
+        g.Barray = &Barray[ ptr_begin ];
+        g.Carray = &Carray[ ptr_begin ];
+        if (layout == Layout::RowMajor) {
+            // swap transA <=> transB, m <=> n, B <=> A
+            std::swap( g.transA, g.transB );
+            std::swap( g.m, g.n );
+            std::swap( g.lda, g.ldb );
+            std::swap( g.Aarray, g.Barray );
+        }
+
+        int64_t size = group_size[ ig ];
+        if (vendor_batch) {
+            // vendor threads and schedules the whole group itself
+            if (size > 0)
+                chunks.push_back( { ig, 0, to_blas_int( size ) } );
+        }
+        else if (internal::parallel_level3_threads( m[ ig ], n[ ig ] ) > 1) {
+            // large problems, run after the small ones
+            large.push_back( ig );
+        }
+        else {
+            // split into about one chunk per outer thread
+            int64_t chunk = (size + nt - 1) / nt;
+            for (int64_t i = 0; i < size; i += chunk) {
+                chunks.push_back( { ig, size_t( i ),
+                                    to_blas_int( blas::min( chunk, size - i ) ) } );
+            }
+        }
+        ptr_begin += size;
+    }
+
+    internal::batch_parallel( 0, chunks.size(), split, true, [&]( int64_t ic ) {
+        Chunk const& c = chunks[ ic ];
+        Group const& g = groups[ c.group ];
+        internal::gemm_batch(
+            g.transA, g.transB, g.m, g.n, g.k,
+            alpha[ c.group ], &g.Aarray[ c.begin ], g.lda,
+                              &g.Barray[ c.begin ], g.ldb,
+            beta[ c.group ],  &g.Carray[ c.begin ], g.ldc,
+            c.count );
+    } );
+
+    // each large problem is split into tiles over threads
+    for (size_t ig : large) {
+        Group const& g = groups[ ig ];
+        for (size_t i = 0; i < group_size[ ig ]; ++i) {
+            blas::gemm( Layout::ColMajor, char2op( g.transA ), char2op( g.transB ),
+                        g.m, g.n, g.k,
+                        alpha[ ig ], g.Aarray[ i ], g.lda, g.Barray[ i ], g.ldb,
+                        beta[ ig ],  g.Carray[ i ], g.ldc );
+        }
+    }
+}
+
+}  // namespace impl
+
+//==============================================================================
+// High-level overloaded wrappers call mid-level templated wrapper.
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// CPU, group batched, float version.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    std::vector<blas::Op>   const& transA,
+    std::vector<blas::Op>   const& transB,
+    std::vector<int64_t>    const& m,
+    std::vector<int64_t>    const& n,
+    std::vector<int64_t>    const& k,
+    std::vector<float >     const& alpha,
+    std::vector<float*>     const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<float*>     const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<float >     const& beta,
+    std::vector<float*>     const& Carray, std::vector<int64_t> const& ldc,
+    std::vector<size_t>     const& group_size,
+    std::vector<int64_t>& info )
+{
+    impl::gemm( layout, transA, transB, m, n, k,
+                alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
+                group_size, info );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, group batched, double version.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    std::vector<blas::Op>   const& transA,
+    std::vector<blas::Op>   const& transB,
+    std::vector<int64_t>    const& m,
+    std::vector<int64_t>    const& n,
+    std::vector<int64_t>    const& k,
+    std::vector<double >    const& alpha,
+    std::vector<double*>    const& Aarray, std::vector<int64_t> const& lda,
+    std::vector<double*>    const& Barray, std::vector<int64_t> const& ldb,
+    std::vector<double >    const& beta,
+    std::vector<double*>    const& Carray, std::vector<int64_t> const& ldc,
+    std::vector<size_t>     const& group_size,
+    std::vector<int64_t>& info )
+{
+    impl::gemm( layout, transA, transB, m, n, k,
+                alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
+                group_size, info );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, group batched, complex<float> version.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    std::vector<blas::Op>   const& transA,
+    std::vector<blas::Op>   const& transB,
+    std::vector<int64_t>    const& m,
+    std::vector<int64_t>    const& n,
+    std::vector<int64_t>    const& k,
+    std::vector< std::complex<float>  > const& alpha,
+    std::vector< std::complex<float>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<float>* > const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< std::complex<float>  > const& beta,
+    std::vector< std::complex<float>* > const& Carray, std::vector<int64_t> const& ldc,
+    std::vector<size_t>     const& group_size,
+    std::vector<int64_t>& info )
+{
+    impl::gemm( layout, transA, transB, m, n, k,
+                alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
+                group_size, info );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, group batched, complex<double> version.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    std::vector<blas::Op>   const& transA,
+    std::vector<blas::Op>   const& transB,
+    std::vector<int64_t>    const& m,
+    std::vector<int64_t>    const& n,
+    std::vector<int64_t>    const& k,
+    std::vector< std::complex<double>  > const& alpha,
+    std::vector< std::complex<double>* > const& Aarray, std::vector<int64_t> const& lda,
+    std::vector< std::complex<double>* > const& Barray, std::vector<int64_t> const& ldb,
+    std::vector< std::complex<double>  > const& beta,
+    std::vector< std::complex<double>* > const& Carray, std::vector<int64_t> const& ldc,
+    std::vector<size_t>     const& group_size,
+    std::vector<int64_t>& info )
+{
+    impl::gemm( layout, transA, transB, m, n, k,
+                alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
+                group_size, info );
+}
+
+}  // namespace batch
+}  // namespace blas
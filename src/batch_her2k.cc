@@ -3,8 +3,11 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "blas/fortran.h"
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
 #include "blas.hh"
+#include "blas_internal.hh"
 
 #include <limits>
 
@@ -48,23 +51,34 @@ void her2k(
             batch_size, info );
     }
 
-    #pragma omp parallel for schedule( dynamic )
-    for (size_t i = 0; i < batch_size; ++i) {
-        blas::Uplo uplo_   = blas::batch::extract( uplo,   i );
-        blas::Op   trans_  = blas::batch::extract( trans,  i );
-        int64_t    n_      = blas::batch::extract( n,      i );
-        int64_t    k_      = blas::batch::extract( k,      i );
-        int64_t    lda_    = blas::batch::extract( lda,    i );
-        int64_t    ldb_    = blas::batch::extract( ldb,    i );
-        int64_t    ldc_    = blas::batch::extract( ldc,    i );
-        scalar_t   alpha_  = blas::batch::extract( alpha,  i );
-        real_t     beta_   = blas::batch::extract( beta,   i );
-        scalar_t*  A_      = blas::batch::extract( Aarray, i );
-        scalar_t*  B_      = blas::batch::extract( Barray, i );
-        scalar_t*  C_      = blas::batch::extract( Carray, i );
-        blas::her2k( layout, uplo_, trans_, n_, k_,
-                     alpha_, A_, lda_, B_, ldb_, beta_, C_, ldc_ );
-    }
+    // uniform batches run in input order, others longest-first by flops
+    bool uniform = (n.size() == 1 && k.size() == 1);
+    internal::batch_schedule(
+        batch_size, uniform,
+        [&]( size_t i ) {
+            return blas::Gflop< scalar_t >::her2k(
+                blas::batch::extract( n, i ), blas::batch::extract( k, i ) );
+        },
+        [&]( size_t i ) {
+            return internal::parallel_level3_threads(
+                blas::batch::extract( n, i ), blas::batch::extract( n, i ) ) > 1;
+        },
+        [&]( size_t i ) {
+            blas::Uplo uplo_   = blas::batch::extract( uplo,   i );
+            blas::Op   trans_  = blas::batch::extract( trans,  i );
+            int64_t    n_      = blas::batch::extract( n,      i );
+            int64_t    k_      = blas::batch::extract( k,      i );
+            int64_t    lda_    = blas::batch::extract( lda,    i );
+            int64_t    ldb_    = blas::batch::extract( ldb,    i );
+            int64_t    ldc_    = blas::batch::extract( ldc,    i );
+            scalar_t   alpha_  = blas::batch::extract( alpha,  i );
+            real_t     beta_   = blas::batch::extract( beta,   i );
+            scalar_t*  A_      = blas::batch::extract( Aarray, i );
+            scalar_t*  B_      = blas::batch::extract( Barray, i );
+            scalar_t*  C_      = blas::batch::extract( Carray, i );
+            blas::her2k( layout, uplo_, trans_, n_, k_,
+                         alpha_, A_, lda_, B_, ldb_, beta_, C_, ldc_ );
+        } );
 }
 
 }  // namespace impl
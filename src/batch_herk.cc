@@ -3,8 +3,11 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "blas/fortran.h"
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
 #include "blas.hh"
+#include "blas_internal.hh"
 
 #include <limits>
 
@@ -47,21 +50,84 @@ void herk(
             batch_size, info );
     }
 
-    #pragma omp parallel for schedule( dynamic )
-    for (size_t i = 0; i < batch_size; ++i) {
-        blas::Uplo uplo_   = blas::batch::extract( uplo,   i );
-        blas::Op   trans_  = blas::batch::extract( trans,  i );
-        int64_t    n_      = blas::batch::extract( n,      i );
-        int64_t    k_      = blas::batch::extract( k,      i );
-        int64_t    lda_    = blas::batch::extract( lda,    i );
-        int64_t    ldc_    = blas::batch::extract( ldc,    i );
-        real_t     alpha_  = blas::batch::extract( alpha,  i );
-        real_t     beta_   = blas::batch::extract( beta,   i );
-        scalar_t*  A_      = blas::batch::extract( Aarray, i );
-        scalar_t*  C_      = blas::batch::extract( Carray, i );
-        blas::herk( layout, uplo_, trans_, n_, k_,
-                    alpha_, A_, lda_, beta_, C_, ldc_ );
-    }
+    // uniform batches run in input order, others longest-first by flops
+    bool uniform = (n.size() == 1 && k.size() == 1);
+    internal::batch_schedule(
+        batch_size, uniform,
+        [&]( size_t i ) {
+            return blas::Gflop< scalar_t >::herk(
+                blas::batch::extract( n, i ), blas::batch::extract( k, i ) );
+        },
+        [&]( size_t i ) {
+            return internal::parallel_level3_threads(
+                blas::batch::extract( n, i ), blas::batch::extract( n, i ) ) > 1;
+        },
+        [&]( size_t i ) {
+            blas::Uplo uplo_   = blas::batch::extract( uplo,   i );
+            blas::Op   trans_  = blas::batch::extract( trans,  i );
+            int64_t    n_      = blas::batch::extract( n,      i );
+            int64_t    k_      = blas::batch::extract( k,      i );
+            int64_t    lda_    = blas::batch::extract( lda,    i );
+            int64_t    ldc_    = blas::batch::extract( ldc,    i );
+            real_t     alpha_  = blas::batch::extract( alpha,  i );
+            real_t     beta_   = blas::batch::extract( beta,   i );
+            scalar_t*  A_      = blas::batch::extract( Aarray, i );
+            scalar_t*  C_      = blas::batch::extract( Carray, i );
+            blas::herk( layout, uplo_, trans_, n_, k_,
+                        alpha_, A_, lda_, beta_, C_, ldc_ );
+        } );
+}
+
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched version.
+/// Problem i uses matrices at offsets i*strideA, i*strideB, etc.
+/// from the base pointers, and all problems share the same options,
+/// dimensions, and scalars, so no pointer arrays are needed.
+/// Mid-level templated wrapper checks arguments once,
+/// then makes individual routine calls in parallel.
+/// @ingroup herk_internal
+///
+template <typename scalar_t>
+void herk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    real_type<scalar_t> alpha,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    real_type<scalar_t> beta,
+    scalar_t*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    blas_error_if( strideA < 0 );
+    // C of distinct problems must not overlap
+    blas_error_if( batch_size > 1
+                   && strideC < internal::matrix_stride_min( layout, n, n, ldc ) );
+    if (batch_size == 0)
+        return;
+
+    // stored dimensions of A
+    int64_t Am = (trans == Op::NoTrans ? n : k);
+    int64_t An = (trans == Op::NoTrans ? k : n);
+
+    // problem 0 checks the shared arguments on the calling thread
+    blas::herk( layout, uplo, trans, n, k,
+                alpha, A, lda, beta, C, ldc );
+
+    // static schedule gives each thread consecutive problems,
+    // so it can prefetch its next problem while computing this one
+    int64_t count = batch_size;
+    internal::BatchSplit split = internal::batch_split(
+        count - 1, blas::Gflop< scalar_t >::herk( n, k ) );
+    internal::batch_parallel( 1, count, split, false, [&]( int64_t i ) {
+        if (i + 1 < count) {
+            internal::prefetch_matrix( layout, Am, An, &A[ (i+1)*strideA ], lda );
+            internal::prefetch_matrix( layout, n,  n,  &C[ (i+1)*strideC ], ldc );
+        }
+        blas::herk( layout, uplo, trans, n, k,
+                    alpha, &A[ i*strideA ], lda, beta, &C[ i*strideC ], ldc );
+    } );
 }
 
 }  // namespace impl
@@ -154,5 +220,78 @@ void herk(
                 batch_size, info );
 }
 
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, float version.
+/// @ingroup herk
+void herk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float beta,
+    float*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    impl::herk( layout, uplo, trans, n, k,
+                alpha, A, lda, strideA, beta, C, ldc, strideC, batch_size );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, double version.
+/// @ingroup herk
+void herk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double beta,
+    double*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    impl::herk( layout, uplo, trans, n, k,
+                alpha, A, lda, strideA, beta, C, ldc, strideC, batch_size );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, complex<float> version.
+/// @ingroup herk
+void herk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    float alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    float beta,
+    std::complex<float>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    impl::herk( layout, uplo, trans, n, k,
+                alpha, A, lda, strideA, beta, C, ldc, strideC, batch_size );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, complex<double> version.
+/// @ingroup herk
+void herk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    double alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    double beta,
+    std::complex<double>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    impl::herk( layout, uplo, trans, n, k,
+                alpha, A, lda, strideA, beta, C, ldc, strideC, batch_size );
+}
+
 }  // namespace batch
 }  // namespace blas
@@ -3,8 +3,11 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "blas/fortran.h"
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
 #include "blas.hh"
+#include "blas_internal.hh"
 
 #include <limits>
 
@@ -46,23 +49,90 @@ void symm(
             batch_size, info );
     }
 
-    #pragma omp parallel for schedule( dynamic )
-    for (size_t i = 0; i < batch_size; ++i) {
-        blas::Side side_   = blas::batch::extract( side,   i );
-        blas::Uplo uplo_   = blas::batch::extract( uplo,   i );
-        int64_t    m_      = blas::batch::extract( m,      i );
-        int64_t    n_      = blas::batch::extract( n,      i );
-        int64_t    lda_    = blas::batch::extract( lda,    i );
-        int64_t    ldb_    = blas::batch::extract( ldb,    i );
-        int64_t    ldc_    = blas::batch::extract( ldc,    i );
-        scalar_t   alpha_  = blas::batch::extract( alpha,  i );
-        scalar_t   beta_   = blas::batch::extract( beta,   i );
-        scalar_t*  A_      = blas::batch::extract( Aarray, i );
-        scalar_t*  B_      = blas::batch::extract( Barray, i );
-        scalar_t*  C_      = blas::batch::extract( Carray, i );
-        blas::symm( layout, side_, uplo_, m_, n_,
-                    alpha_, A_, lda_, B_, ldb_, beta_,  C_, ldc_ );
-    }
+    // uniform batches run in input order, others longest-first by flops
+    bool uniform = (side.size() == 1 && m.size() == 1 && n.size() == 1);
+    internal::batch_schedule(
+        batch_size, uniform,
+        [&]( size_t i ) {
+            return blas::Gflop< scalar_t >::symm(
+                blas::batch::extract( side, i ), blas::batch::extract( m, i ),
+                blas::batch::extract( n, i ) );
+        },
+        [&]( size_t i ) {
+            return internal::parallel_level3_threads(
+                blas::batch::extract( m, i ), blas::batch::extract( n, i ) ) > 1;
+        },
+        [&]( size_t i ) {
+            blas::Side side_   = blas::batch::extract( side,   i );
+            blas::Uplo uplo_   = blas::batch::extract( uplo,   i );
+            int64_t    m_      = blas::batch::extract( m,      i );
+            int64_t    n_      = blas::batch::extract( n,      i );
+            int64_t    lda_    = blas::batch::extract( lda,    i );
+            int64_t    ldb_    = blas::batch::extract( ldb,    i );
+            int64_t    ldc_    = blas::batch::extract( ldc,    i );
+            scalar_t   alpha_  = blas::batch::extract( alpha,  i );
+            scalar_t   beta_   = blas::batch::extract( beta,   i );
+            scalar_t*  A_      = blas::batch::extract( Aarray, i );
+            scalar_t*  B_      = blas::batch::extract( Barray, i );
+            scalar_t*  C_      = blas::batch::extract( Carray, i );
+            blas::symm( layout, side_, uplo_, m_, n_,
+                        alpha_, A_, lda_, B_, ldb_, beta_,  C_, ldc_ );
+        } );
+}
+
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched version.
+/// Problem i uses matrices at offsets i*strideA, i*strideB, etc.
+/// from the base pointers, and all problems share the same options,
+/// dimensions, and scalars, so no pointer arrays are needed.
+/// Mid-level templated wrapper checks arguments once,
+/// then makes individual routine calls in parallel.
+/// @ingroup symm_internal
+///
+template <typename scalar_t>
+void symm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    scalar_t const* B, int64_t ldb, int64_t strideB,
+    scalar_t beta,
+    scalar_t*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    blas_error_if( strideA < 0 );
+    blas_error_if( strideB < 0 );
+    // C of distinct problems must not overlap
+    blas_error_if( batch_size > 1
+                   && strideC < internal::matrix_stride_min( layout, m, n, ldc ) );
+    if (batch_size == 0)
+        return;
+
+    // A is na-by-na
+    int64_t na = (side == Side::Left ? m : n);
+
+    // problem 0 checks the shared arguments on the calling thread
+    blas::symm( layout, side, uplo, m, n,
+                alpha, A, lda, B, ldb, beta, C, ldc );
+
+    // static schedule gives each thread consecutive problems,
+    // so it can prefetch its next problem while computing this one
+    int64_t count = batch_size;
+    internal::BatchSplit split = internal::batch_split(
+        count - 1, blas::Gflop< scalar_t >::symm( side, m, n ) );
+    internal::batch_parallel( 1, count, split, false, [&]( int64_t i ) {
+        if (i + 1 < count) {
+            internal::prefetch_matrix( layout, na, na, &A[ (i+1)*strideA ], lda );
+            internal::prefetch_matrix( layout, m,  n,  &B[ (i+1)*strideB ], ldb );
+            internal::prefetch_matrix( layout, m,  n,  &C[ (i+1)*strideC ], ldc );
+        }
+        blas::symm( layout, side, uplo, m, n,
+                    alpha, &A[ i*strideA ], lda, &B[ i*strideB ], ldb,
+                    beta, &C[ i*strideC ], ldc );
+    } );
 }
 
 }  // namespace impl
@@ -159,5 +229,86 @@ void symm(
                 batch_size, info );
 }
 
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, float version.
+/// @ingroup symm
+void symm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float const* B, int64_t ldb, int64_t strideB,
+    float beta,
+    float*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    impl::symm( layout, side, uplo, m, n,
+                alpha, A, lda, strideA, B, ldb, strideB,
+                beta, C, ldc, strideC, batch_size );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, double version.
+/// @ingroup symm
+void symm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double const* B, int64_t ldb, int64_t strideB,
+    double beta,
+    double*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    impl::symm( layout, side, uplo, m, n,
+                alpha, A, lda, strideA, B, ldb, strideB,
+                beta, C, ldc, strideC, batch_size );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, complex<float> version.
+/// @ingroup symm
+void symm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float> const* B, int64_t ldb, int64_t strideB,
+    std::complex<float> beta,
+    std::complex<float>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    impl::symm( layout, side, uplo, m, n,
+                alpha, A, lda, strideA, B, ldb, strideB,
+                beta, C, ldc, strideC, batch_size );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, complex<double> version.
+/// @ingroup symm
+void symm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double> const* B, int64_t ldb, int64_t strideB,
+    std::complex<double> beta,
+    std::complex<double>*       C, int64_t ldc, int64_t strideC,
+    size_t batch_size )
+{
+    impl::symm( layout, side, uplo, m, n,
+                alpha, A, lda, strideA, B, ldb, strideB,
+                beta, C, ldc, strideC, batch_size );
+}
+
 }  // namespace batch
 }  // namespace blas
@@ -3,8 +3,11 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "blas/fortran.h"
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
 #include "blas.hh"
+#include "blas_internal.hh"
 
 #include <limits>
 
@@ -45,22 +48,118 @@ void trsm(
             alpha, Aarray, lda, Barray, ldb, batch_size, info );
     }
 
-    #pragma omp parallel for schedule( dynamic )
-    for (size_t i = 0; i < batch_size; ++i) {
-        blas::Side side_   = blas::batch::extract( side,   i );
-        blas::Uplo uplo_   = blas::batch::extract( uplo,   i );
-        blas::Op   trans_  = blas::batch::extract( trans,  i );
-        blas::Diag diag_   = blas::batch::extract( diag,   i );
-        int64_t    m_      = blas::batch::extract( m,      i );
-        int64_t    n_      = blas::batch::extract( n,      i );
-        int64_t    lda_    = blas::batch::extract( lda,    i );
-        int64_t    ldb_    = blas::batch::extract( ldb,    i );
-        scalar_t   alpha_  = blas::batch::extract( alpha,  i );
-        scalar_t*  A_      = blas::batch::extract( Aarray, i );
-        scalar_t*  B_      = blas::batch::extract( Barray, i );
-        blas::trsm( layout, side_, uplo_, trans_, diag_, m_, n_,
-                    alpha_, A_, lda_, B_, ldb_ );
-    }
+    #if defined(BLAS_HAVE_CBLAS_TRSM_BATCH)
+        // Uniform batches go to the vendor as one group. Problem 0 runs
+        // first on this thread, checking the shared arguments.
+        if (side.size() == 1 && uplo.size() == 1 && trans.size() == 1
+            && diag.size() == 1 && m.size() == 1 && n.size() == 1
+            && alpha.size() == 1 && lda.size() == 1 && ldb.size() == 1
+            && Aarray.size() == batch_size && Barray.size() == batch_size
+            && batch_size > 1) {
+            blas::trsm( layout, side[0], uplo[0], trans[0], diag[0], m[0], n[0],
+                        alpha[0], Aarray[0], lda[0], Barray[0], ldb[0] );
+
+            blas::Side side_ = side[0];
+            blas::Uplo uplo_ = uplo[0];
+            int64_t m_ = m[0];
+            int64_t n_ = n[0];
+            if (layout == Layout::RowMajor) {
+                // swap lower <=> upper, left <=> right, m <=> n
+                uplo_ = (uplo_ == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+                side_ = (side_ == Side::Left ? Side::Right : Side::Left);
+                std::swap( m_, n_ );
+            }
+            internal::trsm_batch(
+                side2char( side_ ), uplo2char( uplo_ ),
+                op2char( trans[0] ), diag2char( diag[0] ),
+                to_blas_int( m_ ), to_blas_int( n_ ),
+                alpha[0], &Aarray[ 1 ], to_blas_int( lda[0] ),
+                          &Barray[ 1 ], to_blas_int( ldb[0] ),
+                to_blas_int( int64_t( batch_size - 1 ) ) );
+            return;
+        }
+    #endif
+
+    // uniform batches run in input order, others longest-first by flops
+    bool uniform = (side.size() == 1 && m.size() == 1 && n.size() == 1);
+    internal::batch_schedule(
+        batch_size, uniform,
+        [&]( size_t i ) {
+            return blas::Gflop< scalar_t >::trsm(
+                blas::batch::extract( side, i ), blas::batch::extract( m, i ),
+                blas::batch::extract( n, i ) );
+        },
+        [&]( size_t i ) {
+            return internal::parallel_level3_threads(
+                blas::batch::extract( m, i ), blas::batch::extract( n, i ) ) > 1;
+        },
+        [&]( size_t i ) {
+            blas::Side side_   = blas::batch::extract( side,   i );
+            blas::Uplo uplo_   = blas::batch::extract( uplo,   i );
+            blas::Op   trans_  = blas::batch::extract( trans,  i );
+            blas::Diag diag_   = blas::batch::extract( diag,   i );
+            int64_t    m_      = blas::batch::extract( m,      i );
+            int64_t    n_      = blas::batch::extract( n,      i );
+            int64_t    lda_    = blas::batch::extract( lda,    i );
+            int64_t    ldb_    = blas::batch::extract( ldb,    i );
+            scalar_t   alpha_  = blas::batch::extract( alpha,  i );
+            scalar_t*  A_      = blas::batch::extract( Aarray, i );
+            scalar_t*  B_      = blas::batch::extract( Barray, i );
+            blas::trsm( layout, side_, uplo_, trans_, diag_, m_, n_,
+                        alpha_, A_, lda_, B_, ldb_ );
+        } );
+}
+
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched version.
+/// Problem i uses matrices at offsets i*strideA, i*strideB, etc.
+/// from the base pointers, and all problems share the same options,
+/// dimensions, and scalars, so no pointer arrays are needed.
+/// Mid-level templated wrapper checks arguments once,
+/// then makes individual routine calls in parallel.
+/// @ingroup trsm_internal
+///
+template <typename scalar_t>
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    scalar_t*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size )
+{
+    blas_error_if( strideA < 0 );
+    // B of distinct problems must not overlap
+    blas_error_if( batch_size > 1
+                   && strideB < internal::matrix_stride_min( layout, m, n, ldb ) );
+    if (batch_size == 0)
+        return;
+
+    // A is na-by-na
+    int64_t na = (side == Side::Left ? m : n);
+
+    // problem 0 checks the shared arguments on the calling thread
+    blas::trsm( layout, side, uplo, trans, diag, m, n,
+                alpha, A, lda, B, ldb );
+
+    // static schedule gives each thread consecutive problems,
+    // so it can prefetch its next problem while computing this one
+    int64_t count = batch_size;
+    internal::BatchSplit split = internal::batch_split(
+        count - 1, blas::Gflop< scalar_t >::trsm( side, m, n ) );
+    internal::batch_parallel( 1, count, split, false, [&]( int64_t i ) {
+        if (i + 1 < count) {
+            internal::prefetch_matrix( layout, na, na, &A[ (i+1)*strideA ], lda );
+            internal::prefetch_matrix( layout, m,  n,  &B[ (i+1)*strideB ], ldb );
+        }
+        blas::trsm( layout, side, uplo, trans, diag, m, n,
+                    alpha, &A[ i*strideA ], lda, &B[ i*strideB ], ldb );
+    } );
 }
 
 }  // namespace impl
@@ -157,5 +256,82 @@ void trsm(
                 batch_size, info );
 }
 
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, float version.
+/// @ingroup trsm
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    float alpha,
+    float const* A, int64_t lda, int64_t strideA,
+    float*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size )
+{
+    impl::trsm( layout, side, uplo, trans, diag, m, n,
+                alpha, A, lda, strideA, B, ldb, strideB, batch_size );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, double version.
+/// @ingroup trsm
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    double alpha,
+    double const* A, int64_t lda, int64_t strideA,
+    double*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size )
+{
+    impl::trsm( layout, side, uplo, trans, diag, m, n,
+                alpha, A, lda, strideA, B, ldb, strideB, batch_size );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, complex<float> version.
+/// @ingroup trsm
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    std::complex<float>*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size )
+{
+    impl::trsm( layout, side, uplo, trans, diag, m, n,
+                alpha, A, lda, strideA, B, ldb, strideB, batch_size );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, strided batched, complex<double> version.
+/// @ingroup trsm
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    std::complex<double>*       B, int64_t ldb, int64_t strideB,
+    size_t batch_size )
+{
+    impl::trsm( layout, side, uplo, trans, diag, m, n,
+                alpha, A, lda, strideA, B, ldb, strideB, batch_size );
+}
+
 }  // namespace batch
 }  // namespace blas
@@ -6,8 +6,12 @@
 #ifndef BLAS_INTERNAL_HH
 #define BLAS_INTERNAL_HH
 
+#include "blas/defines.h"
 #include "blas/util.hh"
 
+#include <algorithm>
+#include <vector>
+
 namespace blas {
 
 //------------------------------------------------------------------------------
@@ -31,6 +35,400 @@ inline blas_int to_blas_int_( int64_t x, const char* x_str )
 ///
 #define to_blas_int( x ) to_blas_int_( x, #x )
 
+namespace internal {
+
+void* host_workspace_acquire( size_t bytes );
+void  host_workspace_release( void* ptr );
+
+//------------------------------------------------------------------------------
+/// Temporary host vector of n scalars, e.g., for conjugating x in
+/// RowMajor routines. Short vectors, up to stack_bytes, live on the stack.
+/// Longer ones use a workspace kept per thread between calls, up to 1 MiB,
+/// so repeated calls allocate only when n grows; longer vectors are freed
+/// after each call. If that workspace is already in use on this thread,
+/// falls back to a heap allocation. See blas::host_workspace_free.
+///
+template <typename scalar_t>
+class Workspace
+{
+public:
+    static constexpr size_t stack_bytes = 512;
+
+    explicit Workspace( int64_t n )
+    {
+        size_t bytes = size_t( n ) * sizeof( scalar_t );
+        if (bytes <= stack_bytes)
+            data_ = reinterpret_cast< scalar_t* >( stack_ );
+        else
+            data_ = static_cast< scalar_t* >( host_workspace_acquire( bytes ) );
+    }
+
+    ~Workspace()
+    {
+        if (data_ != reinterpret_cast< scalar_t* >( stack_ ))
+            host_workspace_release( data_ );
+    }
+
+    Workspace( Workspace const& ) = delete;
+    Workspace& operator = ( Workspace const& ) = delete;
+
+    scalar_t* data() { return data_; }
+
+private:
+    scalar_t* data_;
+    alignas( scalar_t ) char stack_[ stack_bytes ];
+};
+
+//------------------------------------------------------------------------------
+/// Minimum number of elements per chunk when splitting Level 1 calls.
+const int64_t level1_chunk_min = 4096;
+
+int64_t parallel_level1_chunks( int64_t n );
+
+//------------------------------------------------------------------------------
+/// @return offset in an array of the chunk of elements [i, i + len)
+/// of an n-element vector with stride inc. As in BLAS, if inc < 0,
+/// elements are stored in reverse, so chunks are taken from the end.
+///
+inline int64_t chunk_offset( int64_t i, int64_t len, int64_t n, int64_t inc )
+{
+    return (inc > 0 ? i*inc : (n - i - len)*(-inc));
+}
+
+//------------------------------------------------------------------------------
+/// Splits the elements [0, n) into nchunks nearly equal chunks and calls
+/// func( chunk, i, len ) on each, with chunks in parallel across OpenMP
+/// threads. See parallel_level1_chunks.
+///
+template <typename func_t>
+void parallel_level1( int64_t n, int64_t nchunks, func_t&& func )
+{
+    int64_t nb = (n + nchunks - 1) / nchunks;
+    #pragma omp parallel for schedule(static) num_threads( int( nchunks ) )
+    for (int64_t c = 0; c < nchunks; ++c) {
+        int64_t i = c*nb;
+        if (i < n)
+            func( c, i, blas::min( nb, n - i ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+int64_t parallel_level3_threads( int64_t m, int64_t n );
+
+//------------------------------------------------------------------------------
+/// @return tile size for splitting an m-by-n Level 3 output among nt
+/// threads: about 4 tiles per thread, a multiple of 32 in [64, 512],
+/// so each tile is still a reasonably efficient vendor BLAS call.
+///
+inline int64_t parallel_level3_tile( int64_t m, int64_t n, int64_t nt )
+{
+    int64_t nb = int64_t( std::sqrt( double( m ) * n / (4*nt) ) );
+    nb = (nb + 31) / 32 * 32;
+    return blas::max( int64_t( 64 ), blas::min( nb, int64_t( 512 ) ) );
+}
+
+//------------------------------------------------------------------------------
+/// Matrices up to this many bytes are prefetched by prefetch_matrix;
+/// larger ones wouldn't stay in cache alongside the current problem.
+const int64_t prefetch_max_bytes = 16384;
+
+//------------------------------------------------------------------------------
+/// Prefetches the m-by-n matrix A into cache, if it is small, so a batch
+/// of small problems loads the next problem's matrices while computing
+/// the current one. Does nothing if the compiler lacks __builtin_prefetch.
+///
+template <typename scalar_t>
+void prefetch_matrix(
+    blas::Layout layout, int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda )
+{
+    #if defined(__GNUC__)
+        if (layout == Layout::RowMajor)
+            std::swap( m, n );
+        int64_t bytes = m * int64_t( sizeof( scalar_t ) );
+        if (bytes * n > prefetch_max_bytes)
+            return;
+        const int64_t line = 64;
+        for (int64_t j = 0; j < n; ++j) {
+            char const* Aj = (char const*) &A[ j*lda ];
+            for (int64_t b = 0; b < bytes; b += line)
+                __builtin_prefetch( Aj + b );
+        }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// @return smallest stride between consecutive m-by-n matrices with
+/// leading dimension ld that keeps them from overlapping: the next matrix
+/// may start right after the last entry of this one, ld*(cols - 1) + rows,
+/// which is less than ld*cols if ld > rows. Empty matrices never overlap.
+///
+inline int64_t matrix_stride_min(
+    blas::Layout layout, int64_t m, int64_t n, int64_t ld )
+{
+    int64_t rows = (layout == Layout::ColMajor ? m : n);
+    int64_t cols = (layout == Layout::ColMajor ? n : m);
+    return (rows == 0 || cols == 0 ? 0 : ld*(cols - 1) + rows);
+}
+
+//------------------------------------------------------------------------------
+// Low-level group batched gemm, in gemm.cc.
+void gemm_batch(
+    char transA, char transB,
+    blas_int m, blas_int n, blas_int k,
+    float alpha,
+    float* const* Aarray, blas_int lda,
+    float* const* Barray, blas_int ldb,
+    float beta,
+    float* const* Carray, blas_int ldc,
+    blas_int count );
+
+void gemm_batch(
+    char transA, char transB,
+    blas_int m, blas_int n, blas_int k,
+    double alpha,
+    double* const* Aarray, blas_int lda,
+    double* const* Barray, blas_int ldb,
+    double beta,
+    double* const* Carray, blas_int ldc,
+    blas_int count );
+
+void gemm_batch(
+    char transA, char transB,
+    blas_int m, blas_int n, blas_int k,
+    std::complex<float> alpha,
+    std::complex<float>* const* Aarray, blas_int lda,
+    std::complex<float>* const* Barray, blas_int ldb,
+    std::complex<float> beta,
+    std::complex<float>* const* Carray, blas_int ldc,
+    blas_int count );
+
+void gemm_batch(
+    char transA, char transB,
+    blas_int m, blas_int n, blas_int k,
+    std::complex<double> alpha,
+    std::complex<double>* const* Aarray, blas_int lda,
+    std::complex<double>* const* Barray, blas_int ldb,
+    std::complex<double> beta,
+    std::complex<double>* const* Carray, blas_int ldc,
+    blas_int count );
+
+#if defined(BLAS_HAVE_CBLAS_TRSM_BATCH)
+//------------------------------------------------------------------------------
+// Low-level batched trsm calling the vendor, in trsm.cc.
+void trsm_batch(
+    char side, char uplo, char trans, char diag,
+    blas_int m, blas_int n,
+    float alpha,
+    float* const* Aarray, blas_int lda,
+    float* const* Barray, blas_int ldb,
+    blas_int count );
+
+void trsm_batch(
+    char side, char uplo, char trans, char diag,
+    blas_int m, blas_int n,
+    double alpha,
+    double* const* Aarray, blas_int lda,
+    double* const* Barray, blas_int ldb,
+    blas_int count );
+
+void trsm_batch(
+    char side, char uplo, char trans, char diag,
+    blas_int m, blas_int n,
+    std::complex<float> alpha,
+    std::complex<float>* const* Aarray, blas_int lda,
+    std::complex<float>* const* Barray, blas_int ldb,
+    blas_int count );
+
+void trsm_batch(
+    char side, char uplo, char trans, char diag,
+    blas_int m, blas_int n,
+    std::complex<double> alpha,
+    std::complex<double>* const* Aarray, blas_int lda,
+    std::complex<double>* const* Barray, blas_int ldb,
+    blas_int count );
+#endif
+
+//------------------------------------------------------------------------------
+int64_t batch_threads();
+
+//------------------------------------------------------------------------------
+/// Minimum Gflop per inner thread when splitting a batch problem over
+/// threads, about a 128^3 gemm; below that, starting the threads costs
+/// more than they save.
+const double nested_gflop_min = 0.004;
+
+//------------------------------------------------------------------------------
+/// Split of the batch threads into outer threads, each running whole
+/// problems, times inner threads used by each problem's BLAS call.
+struct BatchSplit {
+    int64_t outer, inner;
+};
+
+BatchSplit batch_split( size_t batch_size, double gflop );
+
+//------------------------------------------------------------------------------
+/// Sets up nested parallelism for a batch split while in scope,
+/// on the calling thread. See batch_parallel.
+class NestedRegion
+{
+public:
+    explicit NestedRegion( BatchSplit split );
+    ~NestedRegion();
+
+    NestedRegion( NestedRegion const& ) = delete;
+    NestedRegion& operator = ( NestedRegion const& ) = delete;
+
+private:
+    bool active_;
+};
+
+//------------------------------------------------------------------------------
+/// Limits BLAS calls from an outer batch thread to the inner threads
+/// of a batch split while in scope. See batch_parallel.
+class NestedThread
+{
+public:
+    explicit NestedThread( BatchSplit split );
+    ~NestedThread();
+
+    NestedThread( NestedThread const& ) = delete;
+    NestedThread& operator = ( NestedThread const& ) = delete;
+
+private:
+    bool active_;
+    int64_t inner_;
+    int vendor_;
+};
+
+//------------------------------------------------------------------------------
+/// Runs run( i ), for i in [begin, end), on split.outer OpenMP threads,
+/// each of whose BLAS calls use split.inner threads, with a dynamic or
+/// static schedule. Outer threads are bound spread out over the OpenMP
+/// places (if binding is enabled, e.g., by $OMP_PROC_BIND or $OMP_PLACES),
+/// so each one's inner threads run on the places nearest it.
+///
+template <typename run_t>
+void batch_parallel(
+    int64_t begin, int64_t end, BatchSplit split, bool dynamic,
+    run_t&& run )
+{
+    NestedRegion region( split );
+    #pragma omp parallel num_threads( int( split.outer ) ) proc_bind( spread )
+    {
+        NestedThread thread( split );
+        if (dynamic) {
+            #pragma omp for schedule( dynamic )
+            for (int64_t i = begin; i < end; ++i)
+                run( i );
+        }
+        else {
+            #pragma omp for schedule( static )
+            for (int64_t i = begin; i < end; ++i)
+                run( i );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Runs problems run( i ), for i in [0, batch_size), in parallel,
+/// ordered by cost( i ), typically Gflop from flops.hh.
+///
+/// With dynamic scheduling in input order, a large problem near the end
+/// starts late and leaves a long tail while other threads idle. Instead,
+/// problems start longest-first, so small problems fill in at the end.
+/// A problem costing at least one thread's share of the total is run
+/// first, on its own, over all threads: split into tiles by the routine
+/// if split( i ) says so (see parallel_level3_threads), otherwise by the
+/// vendor BLAS, if the problem is large enough to keep all threads busy;
+/// a smaller problem just starts first.
+///
+/// If the batch is uniform (all problems the same size), problems are run
+/// in input order, costing only the first.
+///
+/// Threads are split between problems and their BLAS calls by batch_split.
+/// Problems that would each get several BLAS threads on their own are run
+/// as one group, split by their mean cost, so a few large problems each
+/// get several threads even in a batch with many small ones; the rest
+/// then run with one thread each.
+///
+template <typename cost_t, typename split_t, typename run_t>
+void batch_schedule(
+    size_t batch_size, bool uniform,
+    cost_t&& cost, split_t&& split, run_t&& run )
+{
+    if (batch_size == 0)
+        return;
+
+    if (uniform) {
+        batch_parallel( 0, batch_size, batch_split( batch_size, cost( 0 ) ),
+                        true, run );
+        return;
+    }
+
+    std::vector<double> costs( batch_size );
+    double total = 0;
+    for (size_t i = 0; i < batch_size; ++i) {
+        costs[ i ] = cost( i );
+        total += costs[ i ];
+    }
+
+    // large problems each use all threads, one after another:
+    // split into tiles by the routine, or else by the vendor BLAS
+    int64_t nthreads = batch_threads();
+    std::vector<size_t> order;
+    order.reserve( batch_size );
+    double rest = 0;
+    for (size_t i = 0; i < batch_size; ++i) {
+        if (nthreads > 1 && costs[ i ] >= total / nthreads && split( i )) {
+            run( i );
+        }
+        else if (nthreads > 1 && costs[ i ] >= total / nthreads
+                 && batch_split( 1, costs[ i ] ).inner == nthreads) {
+            BatchSplit all = { 1, nthreads };
+            NestedRegion region( all );
+            NestedThread thread( all );
+            run( i );
+        }
+        else {
+            order.push_back( i );
+            rest += costs[ i ];
+        }
+    }
+    if (order.empty())
+        return;
+
+    // longest-first; stable, so equal costs stay in input order
+    std::stable_sort( order.begin(), order.end(),
+                      [&costs]( size_t a, size_t b ) {
+                          return costs[ a ] > costs[ b ];
+                      } );
+
+    // problems big enough for several BLAS threads each run first, split
+    // by their own mean cost, so the small tail doesn't average them down;
+    // then the small tail
+    size_t front = 0;
+    double front_cost = 0;
+    while (front < order.size()
+           && batch_split( 1, costs[ order[ front ] ] ).inner > 1) {
+        front_cost += costs[ order[ front ] ];
+        ++front;
+    }
+    size_t tail = order.size() - front;
+    auto run_order = [&]( int64_t j ) { run( order[ j ] ); };
+    if (front > 0) {
+        batch_parallel( 0, front, batch_split( front, front_cost / front ),
+                        true, run_order );
+    }
+    if (tail > 0) {
+        batch_parallel( front, order.size(),
+                        batch_split( tail, (rest - front_cost) / tail ),
+                        true, run_order );
+    }
+}
+
+}  // namespace internal
+
 }  // namespace blas
 
 #endif // BLAS_INTERNAL_HH
@@ -0,0 +1,111 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_CBLAS_INTERNAL_HH
+#define BLAS_CBLAS_INTERNAL_HH
+
+// Used when BLAS++ is configured with use_cblas, which defines
+// BLAS_USE_CBLAS. Then RowMajor CPU routines call the vendor's CBLAS with
+// CblasRowMajor instead of swapping arguments and conjugating copies.
+// Also used when configure finds the vendor's batch entry points,
+// which defines BLAS_HAVE_CBLAS_GEMM_BATCH or BLAS_HAVE_CBLAS_TRSM_BATCH.
+// Then CPU batch routines forward uniform batches to the vendor.
+
+#include "blas/defines.h"
+
+#if defined(BLAS_HAVE_CBLAS_GEMM_BATCH) || defined(BLAS_HAVE_CBLAS_TRSM_BATCH)
+    #define BLAS_USE_CBLAS_BATCH
+#endif
+
+#if defined(BLAS_USE_CBLAS) || defined(BLAS_USE_CBLAS_BATCH)
+
+#if defined(BLAS_HAVE_MKL)
+    #if defined(BLAS_ILP64) && ! defined(MKL_ILP64)
+        #define MKL_ILP64
+    #endif
+    #include <mkl_cblas.h>
+
+#elif defined(BLAS_HAVE_ESSL)
+    #if defined(BLAS_ILP64) && ! defined(_ESV6464)
+        #define _ESV6464
+    #endif
+    #include <essl.h>
+
+#elif defined(BLAS_HAVE_ACCELERATE)
+    #ifdef BLAS_HAVE_ACCELERATE_CBLAS_H
+        #include <cblas.h>
+    #else
+        #include <Accelerate/Accelerate.h>
+    #endif
+
+#else
+    // Some ancient cblas.h don't include extern C. It's okay to nest.
+    extern "C" {
+    #include <cblas.h>
+    }
+#endif
+
+#include "blas/util.hh"
+
+namespace blas {
+namespace internal {
+
+#if defined(BLAS_USE_CBLAS_BATCH)
+    // Integer type of the vendor's batch entry points; configure checks
+    // batch entry points only in MKL and OpenBLAS.
+    #if defined(BLAS_HAVE_MKL)
+        typedef MKL_INT cblas_int;
+    #else
+        typedef blasint cblas_int;
+    #endif
+#endif
+
+//------------------------------------------------------------------------------
+inline CBLAS_TRANSPOSE op2cblas( Op op )
+{
+    switch (op) {
+        case Op::NoTrans:   return CblasNoTrans;
+        case Op::Trans:     return CblasTrans;
+        case Op::ConjTrans: return CblasConjTrans;
+        default: throw Error( "unknown op" );
+    }
+}
+
+//------------------------------------------------------------------------------
+inline CBLAS_UPLO uplo2cblas( Uplo uplo )
+{
+    switch (uplo) {
+        case Uplo::Lower: return CblasLower;
+        case Uplo::Upper: return CblasUpper;
+        default: throw Error( "unknown uplo" );
+    }
+}
+
+//------------------------------------------------------------------------------
+inline CBLAS_SIDE side2cblas( Side side )
+{
+    switch (side) {
+        case Side::Left:  return CblasLeft;
+        case Side::Right: return CblasRight;
+        default: throw Error( "unknown side" );
+    }
+}
+
+//------------------------------------------------------------------------------
+inline CBLAS_DIAG diag2cblas( Diag diag )
+{
+    switch (diag) {
+        case Diag::NonUnit: return CblasNonUnit;
+        case Diag::Unit:    return CblasUnit;
+        default: throw Error( "unknown diag" );
+    }
+}
+
+}  // namespace internal
+}  // namespace blas
+
+#endif // BLAS_USE_CBLAS || BLAS_USE_CBLAS_BATCH
+
+#endif // BLAS_CBLAS_INTERNAL_HH
@@ -8,6 +8,7 @@
 #include "blas_internal.hh"
 
 #include <limits>
+#include <vector>
 
 namespace blas {
 
@@ -168,6 +169,24 @@ scalar_t dot(
     blas_int incx_ = to_blas_int( incx );
     blas_int incy_ = to_blas_int( incy );
 
+    // split long vectors across threads, if enabled;
+    // partial sums are added in chunk order, so results are reproducible
+    int64_t nchunks = internal::parallel_level1_chunks( n );
+    if (nchunks > 1) {
+        std::vector< scalar_t > partial( nchunks, scalar_t( 0 ) );
+        internal::parallel_level1( n, nchunks,
+            [&]( int64_t c, int64_t i, int64_t len ) {
+                partial[ c ] = internal::dot(
+                    blas_int( len ),
+                    &x[ internal::chunk_offset( i, len, n, incx ) ], incx_,
+                    &y[ internal::chunk_offset( i, len, n, incy ) ], incy_ );
+            } );
+        scalar_t result = 0;
+        for (int64_t c = 0; c < nchunks; ++c)
+            result += partial[ c ];
+        return result;
+    }
+
     // call low-level wrapper
     return internal::dot( n_, x, incx_, y, incy_ );
 }
@@ -194,6 +213,24 @@ scalar_t dotu(
     blas_int incx_ = to_blas_int( incx );
     blas_int incy_ = to_blas_int( incy );
 
+    // split long vectors across threads, if enabled;
+    // partial sums are added in chunk order, so results are reproducible
+    int64_t nchunks = internal::parallel_level1_chunks( n );
+    if (nchunks > 1) {
+        std::vector< scalar_t > partial( nchunks, scalar_t( 0 ) );
+        internal::parallel_level1( n, nchunks,
+            [&]( int64_t c, int64_t i, int64_t len ) {
+                partial[ c ] = internal::dotu(
+                    blas_int( len ),
+                    &x[ internal::chunk_offset( i, len, n, incx ) ], incx_,
+                    &y[ internal::chunk_offset( i, len, n, incy ) ], incy_ );
+            } );
+        scalar_t result = 0;
+        for (int64_t c = 0; c < nchunks; ++c)
+            result += partial[ c ];
+        return result;
+    }
+
     // call low-level wrapper
     return internal::dotu( n_, x, incx_, y, incy_ );
 }
@@ -6,6 +6,7 @@
 #include "blas/fortran.h"
 #include "blas.hh"
 #include "blas_internal.hh"
+#include "cblas_internal.hh"
 
 #include <limits>
 
@@ -86,6 +87,176 @@ inline void gemm(
                 (blas_complex_double*) C, &ldc );
 }
 
+//------------------------------------------------------------------------------
+/// Low-level overload applies one set of arguments to count problems,
+/// C_i = alpha op(A_i) op(B_i) + beta C_i, for a group batched gemm
+/// whose arguments are already checked and converted, float version.
+/// Calls the vendor's cblas_sgemm_batch if configure found it,
+/// otherwise loops over the problems.
+/// @ingroup gemm_internal
+void gemm_batch(
+    char transA, char transB,
+    blas_int m, blas_int n, blas_int k,
+    float alpha,
+    float* const* Aarray, blas_int lda,
+    float* const* Barray, blas_int ldb,
+    float beta,
+    float* const* Carray, blas_int ldc,
+    blas_int count )
+{
+#if defined(BLAS_HAVE_CBLAS_GEMM_BATCH)
+    // one group of count problems
+    CBLAS_TRANSPOSE transA_ = op2cblas( char2op( transA ) );
+    CBLAS_TRANSPOSE transB_ = op2cblas( char2op( transB ) );
+    cblas_int m_ = m, n_ = n, k_ = k, count_ = count;
+    cblas_int lda_ = lda, ldb_ = ldb, ldc_ = ldc;
+    cblas_sgemm_batch( CblasColMajor, &transA_, &transB_, &m_, &n_, &k_,
+                       &alpha, (float const**) Aarray, &lda_,
+                               (float const**) Barray, &ldb_,
+                       &beta,  (float**) Carray, &ldc_,
+                       1, &count_ );
+#else
+    for (blas_int i = 0; i < count; ++i) {
+        gemm( transA, transB, m, n, k,
+              alpha, Aarray[ i ], lda, Barray[ i ], ldb, beta, Carray[ i ], ldc );
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload applies one set of arguments to count problems,
+/// double version.
+/// @ingroup gemm_internal
+void gemm_batch(
+    char transA, char transB,
+    blas_int m, blas_int n, blas_int k,
+    double alpha,
+    double* const* Aarray, blas_int lda,
+    double* const* Barray, blas_int ldb,
+    double beta,
+    double* const* Carray, blas_int ldc,
+    blas_int count )
+{
+#if defined(BLAS_HAVE_CBLAS_GEMM_BATCH)
+    // one group of count problems
+    CBLAS_TRANSPOSE transA_ = op2cblas( char2op( transA ) );
+    CBLAS_TRANSPOSE transB_ = op2cblas( char2op( transB ) );
+    cblas_int m_ = m, n_ = n, k_ = k, count_ = count;
+    cblas_int lda_ = lda, ldb_ = ldb, ldc_ = ldc;
+    cblas_dgemm_batch( CblasColMajor, &transA_, &transB_, &m_, &n_, &k_,
+                       &alpha, (double const**) Aarray, &lda_,
+                               (double const**) Barray, &ldb_,
+                       &beta,  (double**) Carray, &ldc_,
+                       1, &count_ );
+#else
+    for (blas_int i = 0; i < count; ++i) {
+        gemm( transA, transB, m, n, k,
+              alpha, Aarray[ i ], lda, Barray[ i ], ldb, beta, Carray[ i ], ldc );
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload applies one set of arguments to count problems,
+/// complex<float> version.
+/// @ingroup gemm_internal
+void gemm_batch(
+    char transA, char transB,
+    blas_int m, blas_int n, blas_int k,
+    std::complex<float> alpha,
+    std::complex<float>* const* Aarray, blas_int lda,
+    std::complex<float>* const* Barray, blas_int ldb,
+    std::complex<float> beta,
+    std::complex<float>* const* Carray, blas_int ldc,
+    blas_int count )
+{
+#if defined(BLAS_HAVE_CBLAS_GEMM_BATCH)
+    // one group of count problems
+    CBLAS_TRANSPOSE transA_ = op2cblas( char2op( transA ) );
+    CBLAS_TRANSPOSE transB_ = op2cblas( char2op( transB ) );
+    cblas_int m_ = m, n_ = n, k_ = k, count_ = count;
+    cblas_int lda_ = lda, ldb_ = ldb, ldc_ = ldc;
+    cblas_cgemm_batch( CblasColMajor, &transA_, &transB_, &m_, &n_, &k_,
+                       &alpha, (void const**) Aarray, &lda_,
+                               (void const**) Barray, &ldb_,
+                       &beta,  (void**) Carray, &ldc_,
+                       1, &count_ );
+#else
+    for (blas_int i = 0; i < count; ++i) {
+        gemm( transA, transB, m, n, k,
+              alpha, Aarray[ i ], lda, Barray[ i ], ldb, beta, Carray[ i ], ldc );
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload applies one set of arguments to count problems,
+/// complex<double> version.
+/// @ingroup gemm_internal
+void gemm_batch(
+    char transA, char transB,
+    blas_int m, blas_int n, blas_int k,
+    std::complex<double> alpha,
+    std::complex<double>* const* Aarray, blas_int lda,
+    std::complex<double>* const* Barray, blas_int ldb,
+    std::complex<double> beta,
+    std::complex<double>* const* Carray, blas_int ldc,
+    blas_int count )
+{
+#if defined(BLAS_HAVE_CBLAS_GEMM_BATCH)
+    // one group of count problems
+    CBLAS_TRANSPOSE transA_ = op2cblas( char2op( transA ) );
+    CBLAS_TRANSPOSE transB_ = op2cblas( char2op( transB ) );
+    cblas_int m_ = m, n_ = n, k_ = k, count_ = count;
+    cblas_int lda_ = lda, ldb_ = ldb, ldc_ = ldc;
+    cblas_zgemm_batch( CblasColMajor, &transA_, &transB_, &m_, &n_, &k_,
+                       &alpha, (void const**) Aarray, &lda_,
+                               (void const**) Barray, &ldb_,
+                       &beta,  (void**) Carray, &ldc_,
+                       1, &count_ );
+#else
+    for (blas_int i = 0; i < count; ++i) {
+        gemm( transA, transB, m, n, k,
+              alpha, Aarray[ i ], lda, Barray[ i ], ldb, beta, Carray[ i ], ldc );
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Computes col-major C = alpha op(A) op(B) + beta C as independent
+/// nb-by-nb tiles of C, each a low-level gemm over the full k dimension,
+/// in parallel using nt OpenMP threads.
+/// @ingroup gemm_internal
+template <typename scalar_t>
+void gemm_tiled(
+    char transA, char transB,
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t beta,
+    scalar_t*       C, int64_t ldc,
+    int64_t nt )
+{
+    int64_t nb = parallel_level3_tile( m, n, nt );
+    int64_t mtiles = (m + nb - 1) / nb;
+    int64_t ntiles = (n + nb - 1) / nb;
+
+    #pragma omp parallel for collapse(2) schedule(dynamic) num_threads(int(nt))
+    for (int64_t j = 0; j < ntiles; ++j) {
+        for (int64_t i = 0; i < mtiles; ++i) {
+            int64_t i0 = i*nb, ib = blas::min( nb, m - i0 );
+            int64_t j0 = j*nb, jb = blas::min( nb, n - j0 );
+            // rows i0 of op(A), cols j0 of op(B)
+            scalar_t const* Ai = (transA == 'N' ? &A[ i0 ] : &A[ i0*lda ]);
+            scalar_t const* Bj = (transB == 'N' ? &B[ j0*ldb ] : &B[ j0 ]);
+            gemm( transA, transB, blas_int( ib ), blas_int( jb ), blas_int( k ),
+                  alpha, Ai, blas_int( lda ), Bj, blas_int( ldb ),
+                  beta, &C[ i0 + j0*ldc ], blas_int( ldc ) );
+        }
+    }
+}
+
 }  // namespace internal
 
 //==============================================================================
@@ -158,15 +329,26 @@ void gemm(
     char transA_ = op2char( transA );
     char transB_ = op2char( transB );
 
+    // large C is split into tiles over threads, if enabled
+    int64_t nt = internal::parallel_level3_threads( m, n );
+
     // call low-level wrapper
     if (layout == Layout::RowMajor) {
         // swap transA <=> transB, m <=> n, B <=> A
-        internal::gemm( transB_, transA_, n_, m_, k_,
-                        alpha, B, ldb_, A, lda_, beta, C, ldc_ );
+        if (nt > 1)
+            internal::gemm_tiled( transB_, transA_, n, m, k,
+                                  alpha, B, ldb, A, lda, beta, C, ldc, nt );
+        else
+            internal::gemm( transB_, transA_, n_, m_, k_,
+                            alpha, B, ldb_, A, lda_, beta, C, ldc_ );
     }
     else {
-        internal::gemm( transA_, transB_, m_, n_, k_,
-                        alpha, A, lda_, B, ldb_, beta, C, ldc_ );
+        if (nt > 1)
+            internal::gemm_tiled( transA_, transB_, m, n, k,
+                                  alpha, A, lda, B, ldb, beta, C, ldc, nt );
+        else
+            internal::gemm( transA_, transB_, m_, n_, k_,
+                            alpha, A, lda_, B, ldb_, beta, C, ldc_ );
     }
 }
 
@@ -6,6 +6,7 @@
 #include "blas/fortran.h"
 #include "blas.hh"
 #include "blas_internal.hh"
+#include "cblas_internal.hh"
 
 #include <limits>
 
@@ -86,6 +87,74 @@ inline void gemv(
                 (blas_complex_double*) y, &incy );
 }
 
+#if defined(BLAS_USE_CBLAS)
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, float version.
+/// @ingroup gemv_internal
+inline void gemv(
+    CBLAS_ORDER layout, CBLAS_TRANSPOSE trans,
+    blas_int m, blas_int n,
+    float alpha,
+    float const* A, blas_int lda,
+    float const* x, blas_int incx,
+    float beta,
+    float*       y, blas_int incy )
+{
+    cblas_sgemv( layout, trans, m, n,
+                 alpha, A, lda, x, incx, beta, y, incy );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, double version.
+/// @ingroup gemv_internal
+inline void gemv(
+    CBLAS_ORDER layout, CBLAS_TRANSPOSE trans,
+    blas_int m, blas_int n,
+    double alpha,
+    double const* A, blas_int lda,
+    double const* x, blas_int incx,
+    double beta,
+    double*       y, blas_int incy )
+{
+    cblas_dgemv( layout, trans, m, n,
+                 alpha, A, lda, x, incx, beta, y, incy );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<float> version.
+/// @ingroup gemv_internal
+inline void gemv(
+    CBLAS_ORDER layout, CBLAS_TRANSPOSE trans,
+    blas_int m, blas_int n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, blas_int lda,
+    std::complex<float> const* x, blas_int incx,
+    std::complex<float> beta,
+    std::complex<float>*       y, blas_int incy )
+{
+    cblas_cgemv( layout, trans, m, n,
+                 &alpha, A, lda, x, incx, &beta, y, incy );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<double> version.
+/// @ingroup gemv_internal
+inline void gemv(
+    CBLAS_ORDER layout, CBLAS_TRANSPOSE trans,
+    blas_int m, blas_int n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, blas_int lda,
+    std::complex<double> const* x, blas_int incx,
+    std::complex<double> beta,
+    std::complex<double>*       y, blas_int incy )
+{
+    cblas_zgemv( layout, trans, m, n,
+                 &alpha, A, lda, x, incx, &beta, y, incy );
+}
+
+#endif // BLAS_USE_CBLAS
+
 }  // namespace internal
 
 //==============================================================================
@@ -131,8 +200,22 @@ void gemv(
     blas_int incx_ = to_blas_int( incx );
     blas_int incy_ = to_blas_int( incy );
 
-    // Deal with layout. RowMajor ConjTrans needs copy of x in x2;
+    #if defined(BLAS_USE_CBLAS)
+        if (layout == Layout::RowMajor) {
+            // vendor's native row-major kernel; no swaps or conjugated copies
+            internal::gemv( CblasRowMajor, internal::op2cblas( trans ),
+                            m_, n_, alpha, A, lda_, x, incx_,
+                            beta, y, incy_ );
+            return;
+        }
+    #endif
+
+    // Deal with layout. RowMajor ConjTrans needs copy of x in x2,
+    // in workspace that is reused, not allocated per call;
     // in other cases, x2 == x.
+    internal::Workspace< scalar_t > work(
+        layout == Layout::RowMajor && trans == Op::ConjTrans
+        && is_complex<scalar_t>::value ? m : 0 );
     scalar_t* x2 = const_cast< scalar_t* >( x );
     Op trans2 = trans;
     if (layout == Layout::RowMajor) {
@@ -142,7 +225,7 @@ void gemv(
                 alpha = conj( alpha );
                 beta  = conj( beta );
 
-                x2 = new scalar_t[ m ];
+                x2 = work.data();
                 int64_t ix = (incx > 0 ? 0 : (-m + 1)*incx);
                 for (int64_t i = 0; i < m; ++i) {
                     x2[ i ] = conj( x[ ix ] );
@@ -175,7 +258,6 @@ void gemv(
                 y[ iy ] = conj( y[ iy ] );
                 iy += incy;
             }
-            delete[] x2;
         }
     }
 }
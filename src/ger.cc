@@ -6,6 +6,7 @@
 #include "blas/fortran.h"
 #include "blas.hh"
 #include "blas_internal.hh"
+#include "cblas_internal.hh"
 
 #include <limits>
 
@@ -115,6 +116,38 @@ inline void geru(
                 (blas_complex_double*) A, &lda );
 }
 
+#if defined(BLAS_USE_CBLAS)
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<float> version.
+/// @ingroup ger_internal
+inline void ger(
+    CBLAS_ORDER layout,
+    blas_int m, blas_int n,
+    std::complex<float> alpha,
+    std::complex<float> const* x, blas_int incx,
+    std::complex<float> const* y, blas_int incy,
+    std::complex<float>*       A, blas_int lda )
+{
+    cblas_cgerc( layout, m, n, &alpha, x, incx, y, incy, A, lda );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<double> version.
+/// @ingroup ger_internal
+inline void ger(
+    CBLAS_ORDER layout,
+    blas_int m, blas_int n,
+    std::complex<double> alpha,
+    std::complex<double> const* x, blas_int incx,
+    std::complex<double> const* y, blas_int incy,
+    std::complex<double>*       A, blas_int lda )
+{
+    cblas_zgerc( layout, m, n, &alpha, x, incx, y, incy, A, lda );
+}
+
+#endif // BLAS_USE_CBLAS
+
 }  // namespace internal
 
 //==============================================================================
@@ -157,10 +190,20 @@ void ger(
     blas_int incx_ = to_blas_int( incx );
     blas_int incy_ = to_blas_int( incy );
 
+    #if defined(BLAS_USE_CBLAS)
+        if (layout == Layout::RowMajor) {
+            // vendor's native row-major kernel; no swaps or conjugated copies
+            internal::ger( CblasRowMajor, m_, n_, alpha,
+                           x, incx_, y, incy_, A, lda_ );
+            return;
+        }
+    #endif
+
     // call low-level wrapper
     if (layout == Layout::RowMajor) {
-        // conjugate y (in y2)
-        scalar_t* y2 = new scalar_t[ n ];
+        // conjugate y (in y2, in workspace reused across calls)
+        internal::Workspace< scalar_t > work( n );
+        scalar_t* y2 = work.data();
         int64_t iy = (incy > 0 ? 0 : (-n + 1)*incy);
         for (int64_t i = 0; i < n; ++i) {
             y2[ i ] = conj( y[ iy ] );
@@ -170,8 +213,6 @@ void ger(
 
         // swap m <=> n, x <=> y, call geru
         internal::geru( n_, m_, alpha, y2, incy_, x, incx_, A, lda_ );
-
-        delete[] y2;
     }
     else {
         internal::ger( m_, n_, alpha, x, incx_, y, incy_, A, lda_ );
@@ -6,6 +6,7 @@
 #include "blas/fortran.h"
 #include "blas.hh"
 #include "blas_internal.hh"
+#include "cblas_internal.hh"
 
 #include <limits>
 
@@ -54,6 +55,42 @@ inline void hemv(
                 (blas_complex_double*) y, &incy );
 }
 
+#if defined(BLAS_USE_CBLAS)
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<float> version.
+/// @ingroup hemv_internal
+inline void hemv(
+    CBLAS_ORDER layout, CBLAS_UPLO uplo,
+    blas_int n,
+    std::complex<float> alpha,
+    std::complex<float> const* A, blas_int lda,
+    std::complex<float> const* x, blas_int incx,
+    std::complex<float> beta,
+    std::complex<float>*       y, blas_int incy )
+{
+    cblas_chemv( layout, uplo, n,
+                 &alpha, A, lda, x, incx, &beta, y, incy );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<double> version.
+/// @ingroup hemv_internal
+inline void hemv(
+    CBLAS_ORDER layout, CBLAS_UPLO uplo,
+    blas_int n,
+    std::complex<double> alpha,
+    std::complex<double> const* A, blas_int lda,
+    std::complex<double> const* x, blas_int incx,
+    std::complex<double> beta,
+    std::complex<double>*       y, blas_int incy )
+{
+    cblas_zhemv( layout, uplo, n,
+                 &alpha, A, lda, x, incx, &beta, y, incy );
+}
+
+#endif // BLAS_USE_CBLAS
+
 }  // namespace internal
 
 //==============================================================================
@@ -93,8 +130,20 @@ void hemv(
     blas_int incx_ = to_blas_int( incx );
     blas_int incy_ = to_blas_int( incy );
 
-    // Deal with layout. RowMajor needs copy of x in x2;
+    #if defined(BLAS_USE_CBLAS)
+        if (layout == Layout::RowMajor) {
+            // vendor's native row-major kernel; no swaps or conjugated copies
+            internal::hemv( CblasRowMajor, internal::uplo2cblas( uplo ),
+                            n_, alpha, A, lda_, x, incx_,
+                            beta, y, incy_ );
+            return;
+        }
+    #endif
+
+    // Deal with layout. RowMajor needs copy of x in x2,
+    // in workspace that is reused, not allocated per call;
     // in other cases, x2 == x.
+    internal::Workspace< scalar_t > work( layout == Layout::RowMajor ? n : 0 );
     scalar_t* x2 = const_cast< scalar_t* >( x );
     if (layout == Layout::RowMajor) {
         // swap lower <=> upper
@@ -104,7 +153,7 @@ void hemv(
         alpha = conj( alpha );
         beta  = conj( beta );
 
-        x2 = new scalar_t[ n ];
+        x2 = work.data();
         int64_t ix = (incx > 0 ? 0 : (-n + 1)*incx);
         for (int64_t i = 0; i < n; ++i) {
             x2[ i ] = conj( x[ ix ] );
@@ -131,7 +180,6 @@ void hemv(
             y[ iy ] = conj( y[ iy ] );
             iy += incy;
         }
-        delete[] x2;
     }
 }
 
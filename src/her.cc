@@ -6,6 +6,7 @@
 #include "blas/fortran.h"
 #include "blas.hh"
 #include "blas_internal.hh"
+#include "cblas_internal.hh"
 
 #include <limits>
 
@@ -46,6 +47,36 @@ inline void her(
                (blas_complex_double*) A, &lda );
 }
 
+#if defined(BLAS_USE_CBLAS)
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<float> version.
+/// @ingroup her_internal
+inline void her(
+    CBLAS_ORDER layout, CBLAS_UPLO uplo,
+    blas_int n,
+    float alpha,
+    std::complex<float> const* x, blas_int incx,
+    std::complex<float>*       A, blas_int lda )
+{
+    cblas_cher( layout, uplo, n, alpha, x, incx, A, lda );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<double> version.
+/// @ingroup her_internal
+inline void her(
+    CBLAS_ORDER layout, CBLAS_UPLO uplo,
+    blas_int n,
+    double alpha,
+    std::complex<double> const* x, blas_int incx,
+    std::complex<double>*       A, blas_int lda )
+{
+    cblas_zher( layout, uplo, n, alpha, x, incx, A, lda );
+}
+
+#endif // BLAS_USE_CBLAS
+
 }  // namespace internal
 
 //==============================================================================
@@ -79,15 +110,26 @@ void her(
     blas_int lda_  = to_blas_int( lda );
     blas_int incx_ = to_blas_int( incx );
 
-    // Deal with layout. RowMajor needs copy of x in x2;
+    #if defined(BLAS_USE_CBLAS)
+        if (layout == Layout::RowMajor) {
+            // vendor's native row-major kernel; no swaps or conjugated copies
+            internal::her( CblasRowMajor, internal::uplo2cblas( uplo ),
+                           n_, alpha, x, incx_, A, lda_ );
+            return;
+        }
+    #endif
+
+    // Deal with layout. RowMajor needs copy of x in x2,
+    // in workspace that is reused, not allocated per call;
     // in other cases, x2 == x.
+    internal::Workspace< scalar_t > work( layout == Layout::RowMajor ? n : 0 );
     scalar_t* x2 = const_cast< scalar_t* >( x );
     if (layout == Layout::RowMajor) {
         // swap lower <=> upper
         uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
 
         // conjugate x (in x2)
-        x2 = new scalar_t[ n ];
+        x2 = work.data();
         int64_t ix = (incx > 0 ? 0 : (-n + 1)*incx);
         for (int64_t i = 0; i < n; ++i) {
             x2[ i ] = conj( x[ ix ] );
@@ -100,10 +142,6 @@ void her(
     // call low-level wrapper
     internal::her( uplo_, n_,
                    alpha, x2, incx_, A, lda_ );
-
-    if (layout == Layout::RowMajor) {
-        delete[] x2;
-    }
 }
 
 }  // namespace impl
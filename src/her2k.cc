@@ -56,6 +56,65 @@ inline void her2k(
                  (blas_complex_double*) C, &ldc );
 }
 
+//------------------------------------------------------------------------------
+/// Computes the uplo triangle of
+/// col-major C = alpha op(A) op(B)^H + conj(alpha) op(B) op(A)^H + beta C
+/// in parallel using nt OpenMP threads, as independent nb-by-nb tiles
+/// of that triangle: diagonal tiles are low-level her2k calls,
+/// off-diagonal tiles are a pair of gemm calls, each over the full
+/// k dimension.
+/// @ingroup her2k_internal
+template <typename scalar_t>
+void her2k_tiled(
+    char uplo, char trans,
+    int64_t n, int64_t k,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    real_type<scalar_t> beta,  // note: real
+    scalar_t*       C, int64_t ldc,
+    int64_t nt )
+{
+    int64_t nb = parallel_level3_tile( n, n, nt );
+    int64_t tiles = (n + nb - 1) / nb;
+    bool notrans = (trans == 'N');
+    Op transA = (notrans ? Op::NoTrans : Op::ConjTrans);
+    Op transB = (notrans ? Op::ConjTrans : Op::NoTrans);
+
+    // tiles (i, j) of the triangle: i >= j if lower, i <= j if upper
+    std::vector< std::pair< int64_t, int64_t > > ij;
+    for (int64_t j = 0; j < tiles; ++j) {
+        for (int64_t i = 0; i < tiles; ++i) {
+            if (uplo == 'L' ? i >= j : i <= j)
+                ij.push_back( { i, j } );
+        }
+    }
+
+    #pragma omp parallel for schedule(dynamic) num_threads(int(nt))
+    for (size_t t = 0; t < ij.size(); ++t) {
+        int64_t i = ij[ t ].first, j = ij[ t ].second;
+        int64_t ib = blas::min( nb, n - i*nb );
+        int64_t jb = blas::min( nb, n - j*nb );
+        // rows i*nb and j*nb of op(A) and op(B)
+        scalar_t const* Ai = (notrans ? &A[ i*nb ] : &A[ i*nb*lda ]);
+        scalar_t const* Aj = (notrans ? &A[ j*nb ] : &A[ j*nb*lda ]);
+        scalar_t const* Bi = (notrans ? &B[ i*nb ] : &B[ i*nb*ldb ]);
+        scalar_t const* Bj = (notrans ? &B[ j*nb ] : &B[ j*nb*ldb ]);
+        scalar_t*       Cij = &C[ i*nb + j*nb*ldc ];
+        if (i == j) {
+            her2k( uplo, trans, blas_int( ib ), blas_int( k ),
+                   alpha, Ai, blas_int( lda ), Bi, blas_int( ldb ),
+                   beta, Cij, blas_int( ldc ) );
+        }
+        else {
+            blas::gemm( Layout::ColMajor, transA, transB, ib, jb, k,
+                        alpha, Ai, lda, Bj, ldb, scalar_t( beta ), Cij, ldc );
+            blas::gemm( Layout::ColMajor, transA, transB, ib, jb, k,
+                        conj( alpha ), Bi, ldb, Aj, lda, scalar_t( 1 ), Cij, ldc );
+        }
+    }
+}
+
 }  // namespace internal
 
 //==============================================================================
@@ -116,9 +175,16 @@ void her2k(
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
 
+    // large C is split into tiles over threads, if enabled
+    int64_t nt = internal::parallel_level3_threads( n, n );
+
     // call low-level wrapper
-    internal::her2k( uplo_, trans_, n_, k_,
-                     alpha, A, lda_, B, ldb_, beta, C, ldc_ );
+    if (nt > 1)
+        internal::her2k_tiled( uplo_, trans_, n, k,
+                               alpha, A, lda, B, ldb, beta, C, ldc, nt );
+    else
+        internal::her2k( uplo_, trans_, n_, k_,
+                         alpha, A, lda_, B, ldb_, beta, C, ldc_ );
 }
 
 }  // namespace impl
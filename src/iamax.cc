@@ -83,6 +83,25 @@ int64_t iamax(
     return internal::iamax( n_, x, incx_ ) - 1;
 }
 
+//------------------------------------------------------------------------------
+/// Mid-level templated wrapper checks arguments, calls iamax,
+/// then returns the max entry in value.
+/// @ingroup iamax_internal
+///
+template <typename scalar_t>
+int64_t amax(
+    int64_t n,
+    scalar_t const* x, int64_t incx,
+    scalar_t* value )
+{
+    // check arguments
+    blas_error_if( value == nullptr );
+
+    int64_t index = iamax( n, x, incx );
+    *value = (index >= 0 ? x[ index*incx ] : scalar_t( 0 ));
+    return index;
+}
+
 }  // namespace impl
 
 //==============================================================================
@@ -128,4 +147,48 @@ int64_t iamax(
     return impl::iamax( n, x, incx );
 }
 
+//------------------------------------------------------------------------------
+/// CPU, float version.
+/// @ingroup iamax
+int64_t amax(
+    int64_t n,
+    float const* x, int64_t incx,
+    float* value )
+{
+    return impl::amax( n, x, incx, value );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, double version.
+/// @ingroup iamax
+int64_t amax(
+    int64_t n,
+    double const* x, int64_t incx,
+    double* value )
+{
+    return impl::amax( n, x, incx, value );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, complex<float> version.
+/// @ingroup iamax
+int64_t amax(
+    int64_t n,
+    std::complex<float> const* x, int64_t incx,
+    std::complex<float>* value )
+{
+    return impl::amax( n, x, incx, value );
+}
+
+//------------------------------------------------------------------------------
+/// CPU, complex<double> version.
+/// @ingroup iamax
+int64_t amax(
+    int64_t n,
+    std::complex<double> const* x, int64_t incx,
+    std::complex<double>* value )
+{
+    return impl::amax( n, x, incx, value );
+}
+
 }  // namespace blas
@@ -8,6 +8,7 @@
 #include "blas_internal.hh"
 
 #include <limits>
+#include <vector>
 
 namespace blas {
 
@@ -77,6 +78,31 @@ real_type<scalar_t> nrm2(
     blas_int n_    = to_blas_int( n );
     blas_int incx_ = to_blas_int( incx );
 
+    // split long vectors across threads, if enabled;
+    // combine partial norms scaled by the largest, to avoid overflow
+    int64_t nchunks = internal::parallel_level1_chunks( n );
+    if (nchunks > 1) {
+        typedef real_type<scalar_t> real_t;
+        std::vector< real_t > partial( nchunks, 0 );
+        internal::parallel_level1( n, nchunks,
+            [&]( int64_t c, int64_t i, int64_t len ) {
+                partial[ c ] = internal::nrm2(
+                    blas_int( len ), &x[ i*incx ], incx_ );
+            } );
+        real_t scale = 0;
+        for (int64_t c = 0; c < nchunks; ++c) {
+            if (std::isnan( partial[ c ] ))
+                return partial[ c ];
+            scale = blas::max( scale, partial[ c ] );
+        }
+        if (scale == 0 || std::isinf( scale ))
+            return scale;
+        real_t sumsq = 0;
+        for (int64_t c = 0; c < nchunks; ++c)
+            sumsq += (partial[ c ] / scale) * (partial[ c ] / scale);
+        return scale * std::sqrt( sumsq );
+    }
+
     // call low-level wrapper
     return internal::nrm2( n_, x, incx_ );
 }
@@ -0,0 +1,320 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/fortran.h"
+#include "blas.hh"
+#include "blas_internal.hh"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#if defined(BLAS_HAVE_MKL)
+    #include <mkl_service.h>
+#elif defined(BLAS_HAVE_OPENBLAS_THREADS_LOCAL)
+    // Some ancient cblas.h don't include extern C. It's okay to nest.
+    extern "C" {
+    #include <cblas.h>  // openblas_set_num_threads_local
+    }
+#endif
+
+namespace blas {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// @return initial Level 1 threshold from $BLASPP_PARALLEL_LEVEL1_THRESHOLD,
+/// or 0 (disabled) if unset.
+int64_t parallel_level1_threshold_env()
+{
+    const char* env = std::getenv( "BLASPP_PARALLEL_LEVEL1_THRESHOLD" );
+    return env ? std::strtoll( env, nullptr, 10 ) : 0;
+}
+
+std::atomic< int64_t >& parallel_level1_threshold()
+{
+    static std::atomic< int64_t > threshold( parallel_level1_threshold_env() );
+    return threshold;
+}
+
+//------------------------------------------------------------------------------
+/// @return initial Level 3 threshold from $BLASPP_PARALLEL_LEVEL3_THRESHOLD,
+/// or 0 (disabled) if unset.
+int64_t parallel_level3_threshold_env()
+{
+    const char* env = std::getenv( "BLASPP_PARALLEL_LEVEL3_THRESHOLD" );
+    return env ? std::strtoll( env, nullptr, 10 ) : 0;
+}
+
+std::atomic< int64_t >& parallel_level3_threshold()
+{
+    static std::atomic< int64_t > threshold( parallel_level3_threshold_env() );
+    return threshold;
+}
+
+//------------------------------------------------------------------------------
+/// Threads a Level 3 call may split into when made from an outer batch
+/// thread; see internal::NestedThread.
+thread_local int64_t nested_inner_threads = 1;
+
+//------------------------------------------------------------------------------
+/// Process-wide settings changed by internal::NestedRegion. Batches may run
+/// concurrently on several std::threads, so the first active region saves
+/// and changes the settings, and the last one restores them.
+struct NestedGlobals {
+    std::mutex mutex;
+    int64_t regions = 0;    ///< number of active regions
+    int max_levels = 0;     ///< saved OpenMP max active levels
+    int vendor = 0;         ///< saved MKL dynamic
+};
+
+NestedGlobals& nested_globals()
+{
+    static NestedGlobals globals;
+    return globals;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Sets the vector length n at or above which the CPU Level 1 routines
+/// axpy, scal, copy, swap, dot, dotu, nrm2, and asum split the vector into
+/// chunks, one per OpenMP thread, and call the vendor BLAS on each chunk.
+/// This helps when the vendor BLAS is sequential; with a threaded vendor
+/// BLAS it would oversubscribe cores, so it is off by default.
+/// The initial value is read from $BLASPP_PARALLEL_LEVEL1_THRESHOLD.
+///
+/// @param[in] n
+///     Threshold; n <= 0 disables splitting.
+///     Has no effect if BLAS++ was compiled without OpenMP.
+///
+void set_parallel_level1_threshold( int64_t n )
+{
+    parallel_level1_threshold().store( n, std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+/// @return threshold set by set_parallel_level1_threshold; 0 if disabled.
+///
+int64_t get_parallel_level1_threshold()
+{
+    return parallel_level1_threshold().load( std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+/// Sets the dimension n such that CPU Level 3 calls gemm, hemm, symm,
+/// trsm, trmm, syrk, herk, syr2k, and her2k whose output matrix has at
+/// least n*n entries are split into tiles, computed in parallel by OpenMP
+/// threads, each calling the vendor BLAS. This lets a sequential vendor BLAS use all cores; with a
+/// threaded vendor BLAS it would oversubscribe cores, so it is off by
+/// default. The initial value is read from $BLASPP_PARALLEL_LEVEL3_THRESHOLD.
+///
+/// @param[in] n
+///     Threshold; n <= 0 disables tiling.
+///     Has no effect if BLAS++ was compiled without OpenMP.
+///
+void set_parallel_level3_threshold( int64_t n )
+{
+    parallel_level3_threshold().store( n, std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+/// @return threshold set by set_parallel_level3_threshold; 0 if disabled.
+///
+int64_t get_parallel_level3_threshold()
+{
+    return parallel_level3_threshold().load( std::memory_order_relaxed );
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return number of chunks to split a Level 1 call of length n into:
+/// 1 if n is below the threshold, OpenMP is unavailable, or the caller
+/// is already in a parallel region; otherwise up to one chunk per thread,
+/// with at least level1_chunk_min elements per chunk.
+///
+int64_t parallel_level1_chunks( int64_t n )
+{
+    int64_t threshold = get_parallel_level1_threshold();
+    if (threshold <= 0 || n < threshold)
+        return 1;
+
+    #ifdef _OPENMP
+        if (omp_in_parallel())
+            return 1;
+        int64_t nt = omp_get_max_threads();
+        return blas::max( int64_t( 1 ),
+                          blas::min( nt, n / level1_chunk_min ) );
+    #else
+        return 1;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// @return number of threads to compute an m-by-n Level 3 output with:
+/// 1 if m*n is below threshold^2 or OpenMP is unavailable; if the caller is
+/// already in a parallel region, the inner threads of a nested batch split
+/// (1 outside a batch); otherwise the OpenMP max threads.
+///
+int64_t parallel_level3_threads( int64_t m, int64_t n )
+{
+    int64_t threshold = get_parallel_level3_threshold();
+    if (threshold <= 0 || m*n < threshold*threshold)
+        return 1;
+
+    #ifdef _OPENMP
+        if (omp_in_parallel())
+            return nested_inner_threads;
+        return omp_get_max_threads();
+    #else
+        return 1;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// @return number of threads that batch routines run with:
+/// the OpenMP max threads, or 1 without OpenMP.
+///
+int64_t batch_threads()
+{
+    #ifdef _OPENMP
+        return omp_get_max_threads();
+    #else
+        return 1;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// @return split of the batch threads between batch_size problems of
+/// about gflop Gflop each: outer threads each run whole problems, with
+/// inner threads in the vendor BLAS (or Level 3 tiling) per problem.
+/// Outer threads go to problems first, up to one per problem, so many
+/// problems get single-threaded BLAS; the leftover threads are shared out
+/// to the problems, but only as many as their size keeps busy, so a few
+/// small problems don't start threads that cost more than they save.
+/// Inside a parallel region, returns { 1, 1 }: problems run sequentially.
+///
+BatchSplit batch_split( size_t batch_size, double gflop )
+{
+    #ifdef _OPENMP
+        if (omp_in_parallel())
+            return { 1, 1 };
+    #endif
+
+    int64_t nthreads = batch_threads();
+    int64_t outer = blas::max( int64_t( 1 ),
+                               blas::min( nthreads, int64_t( batch_size ) ) );
+    int64_t inner = blas::min( nthreads / outer,
+                               int64_t( gflop / nested_gflop_min ) );
+    return { outer, blas::max( int64_t( 1 ), inner ) };
+}
+
+//------------------------------------------------------------------------------
+/// On the calling thread, before the outer parallel region of a batch,
+/// adjusts global settings so outer threads can each use split.inner
+/// threads: allows 2 levels of active OpenMP parallelism, and stops MKL
+/// from dropping to 1 thread inside parallel regions.
+/// OpenBLAS's global thread count is left alone; see NestedThread.
+/// Does nothing if split is { 1, 1 }, leaving the vendor's own threading.
+///
+/// These settings are process-wide, so only the first of concurrently
+/// active regions (e.g., batches called from several std::threads)
+/// changes them; later regions run with its settings, and the last one
+/// to end restores them.
+///
+NestedRegion::NestedRegion( BatchSplit split )
+    : active_( split.outer > 1 || split.inner > 1 )
+{
+    if (! active_)
+        return;
+
+    NestedGlobals& globals = nested_globals();
+    std::lock_guard< std::mutex > lock( globals.mutex );
+    if (globals.regions++ > 0)
+        return;
+
+    #ifdef _OPENMP
+        globals.max_levels = omp_get_max_active_levels();
+        if (split.inner > 1 && globals.max_levels < 2)
+            omp_set_max_active_levels( 2 );
+    #endif
+
+    #if defined(BLAS_HAVE_MKL)
+        globals.vendor = mkl_get_dynamic();
+        if (split.inner > 1)
+            mkl_set_dynamic( 0 );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Restores the global settings changed by the constructor,
+/// if this is the last active region.
+///
+NestedRegion::~NestedRegion()
+{
+    if (! active_)
+        return;
+
+    NestedGlobals& globals = nested_globals();
+    std::lock_guard< std::mutex > lock( globals.mutex );
+    if (--globals.regions == 0) {
+        #if defined(BLAS_HAVE_MKL)
+            mkl_set_dynamic( globals.vendor );
+        #endif
+
+        #ifdef _OPENMP
+            omp_set_max_active_levels( globals.max_levels );
+        #endif
+    }
+}
+
+//------------------------------------------------------------------------------
+/// On each outer thread of a batch, limits the vendor BLAS and Level 3
+/// tiling, for calls made from this thread, to split.inner threads.
+/// Only MKL and OpenBLAS >= 0.3.27 (openblas_set_num_threads_local) have
+/// a thread-local setting; other vendors keep their own threading, and
+/// the inner split is done by Level 3 tiling only.
+/// Does nothing if split is { 1, 1 }.
+///
+NestedThread::NestedThread( BatchSplit split )
+    : active_( split.outer > 1 || split.inner > 1 ),
+      inner_( nested_inner_threads ),
+      vendor_( 0 )
+{
+    if (! active_)
+        return;
+
+    nested_inner_threads = split.inner;
+    #if defined(BLAS_HAVE_MKL)
+        vendor_ = mkl_set_num_threads_local( int( split.inner ) );
+    #elif defined(BLAS_HAVE_OPENBLAS_THREADS_LOCAL)
+        vendor_ = openblas_set_num_threads_local( int( split.inner ) );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Restores the settings changed by the constructor.
+///
+NestedThread::~NestedThread()
+{
+    if (! active_)
+        return;
+
+    nested_inner_threads = inner_;
+    #if defined(BLAS_HAVE_MKL)
+        mkl_set_num_threads_local( vendor_ );
+    #elif defined(BLAS_HAVE_OPENBLAS_THREADS_LOCAL)
+        openblas_set_num_threads_local( vendor_ );
+    #endif
+}
+
+}  // namespace internal
+
+}  // namespace blas
@@ -86,6 +86,16 @@ void scal(
     blas_int n_    = to_blas_int( n );
     blas_int incx_ = to_blas_int( incx );
 
+    // split long vectors across threads, if enabled
+    int64_t nchunks = internal::parallel_level1_chunks( n );
+    if (nchunks > 1) {
+        internal::parallel_level1( n, nchunks,
+            [&]( int64_t, int64_t i, int64_t len ) {
+                internal::scal( blas_int( len ), alpha, &x[ i*incx ], incx_ );
+            } );
+        return;
+    }
+
     // call low-level wrapper
     internal::scal( n_, alpha, x, incx_ );
 }
@@ -88,6 +88,19 @@ void swap(
     blas_int incx_ = to_blas_int( incx );
     blas_int incy_ = to_blas_int( incy );
 
+    // split long vectors across threads, if enabled
+    int64_t nchunks = internal::parallel_level1_chunks( n );
+    if (nchunks > 1) {
+        internal::parallel_level1( n, nchunks,
+            [&]( int64_t, int64_t i, int64_t len ) {
+                internal::swap(
+                    blas_int( len ),
+                    &x[ internal::chunk_offset( i, len, n, incx ) ], incx_,
+                    &y[ internal::chunk_offset( i, len, n, incy ) ], incy_ );
+            } );
+        return;
+    }
+
     // call low-level wrapper
     internal::swap( n_, x, incx_, y, incy_ );
 }
@@ -90,6 +90,38 @@ inline void symm(
                 (blas_complex_double*) C, &ldc );
 }
 
+//------------------------------------------------------------------------------
+/// Computes col-major C = alpha A B + beta C or C = alpha B A + beta C,
+/// with symmetric A, in parallel using nt OpenMP threads, each calling
+/// the vendor symm on a chunk of B and C along the independent dimension
+/// (columns for side = Left, rows for side = Right), sharing all of A.
+/// @ingroup symm_internal
+template <typename scalar_t>
+void symm_tiled(
+    char side, char uplo,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t beta,
+    scalar_t*       C, int64_t ldc,
+    int64_t nt )
+{
+    bool left = (side == 'L');
+    int64_t len = (left ? n : m);  // independent dimension
+    int64_t cb  = blas::max( int64_t( 32 ), (len + nt - 1) / nt );
+
+    #pragma omp parallel for schedule(static) num_threads(int(nt))
+    for (int64_t c = 0; c < len; c += cb) {
+        int64_t cl = blas::min( cb, len - c );
+        symm( side, uplo,
+              blas_int( left ? m : cl ), blas_int( left ? cl : n ),
+              alpha, A, blas_int( lda ),
+              (left ? &B[ c*ldb ] : &B[ c ]), blas_int( ldb ),
+              beta, (left ? &C[ c*ldc ] : &C[ c ]), blas_int( ldc ) );
+    }
+}
+
 }  // namespace internal
 
 //==============================================================================
@@ -154,9 +186,16 @@ void symm(
     char side_ = side2char( side );
     char uplo_ = uplo2char( uplo );
 
+    // large C is split into chunks over threads, if enabled
+    int64_t nt = internal::parallel_level3_threads( m, n );
+
     // call low-level wrapper
-    internal::symm( side_, uplo_, m_, n_,
-                    alpha, A, lda_, B, ldb_, beta, C, ldc_ );
+    if (nt > 1)
+        internal::symm_tiled( side_, uplo_, m_, n_,
+                              alpha, A, lda, B, ldb, beta, C, ldc, nt );
+    else
+        internal::symm( side_, uplo_, m_, n_,
+                        alpha, A, lda_, B, ldb_, beta, C, ldc_ );
 }
 
 }  // namespace impl
@@ -138,6 +138,10 @@ void syr2(
         scalar_t* x2 = const_cast< scalar_t* >( x );
         scalar_t* y2 = const_cast< scalar_t* >( y );
 
+        // workspace for copies of x and y, reused across calls
+        internal::Workspace< scalar_t > work(
+            incx < 1 || incy < 1 ? 2*n : 0 );
+
         // no [cz]syr2 in BLAS or LAPACK, so use [cz]syr2k with k=1 and beta=1.
         // if   inc == 1, consider x and y as n-by-1 matrices in n-by-1 arrays,
         // elif inc >= 1, consider x and y as 1-by-n matrices in inc-by-n arrays,
@@ -156,8 +160,8 @@ void syr2(
             ldy_ = incy_;
         }
         else {
-            x2 = new scalar_t[ n ];
-            y2 = new scalar_t[ n ];
+            x2 = work.data();
+            y2 = x2 + n;
             int64_t ix = (incx > 0 ? 0 : (-n + 1)*incx);
             int64_t iy = (incy > 0 ? 0 : (-n + 1)*incy);
             for (int64_t i = 0; i < n; ++i) {
@@ -175,11 +179,6 @@ void syr2(
         // call low-level wrapper
         internal::syr2k( uplo_, trans_, n_, k_,
                          alpha, x2, ldx_, y2, ldy_, beta, A, lda_ );
-
-        if (x2 != x) {
-            delete[] x2;
-            delete[] y2;
-        }
     }
 }
 
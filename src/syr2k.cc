@@ -90,6 +90,65 @@ inline void syr2k(
                  (blas_complex_double*) C, &ldc );
 }
 
+//------------------------------------------------------------------------------
+/// Computes the uplo triangle of
+/// col-major C = alpha op(A) op(B)^T + alpha op(B) op(A)^T + beta C
+/// in parallel using nt OpenMP threads, as independent nb-by-nb tiles
+/// of that triangle: diagonal tiles are low-level syr2k calls,
+/// off-diagonal tiles are a pair of gemm calls, each over the full
+/// k dimension.
+/// @ingroup syr2k_internal
+template <typename scalar_t>
+void syr2k_tiled(
+    char uplo, char trans,
+    int64_t n, int64_t k,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* B, int64_t ldb,
+    scalar_t beta,
+    scalar_t*       C, int64_t ldc,
+    int64_t nt )
+{
+    int64_t nb = parallel_level3_tile( n, n, nt );
+    int64_t tiles = (n + nb - 1) / nb;
+    bool notrans = (trans == 'N');
+    Op transA = (notrans ? Op::NoTrans : Op::Trans);
+    Op transB = (notrans ? Op::Trans : Op::NoTrans);
+
+    // tiles (i, j) of the triangle: i >= j if lower, i <= j if upper
+    std::vector< std::pair< int64_t, int64_t > > ij;
+    for (int64_t j = 0; j < tiles; ++j) {
+        for (int64_t i = 0; i < tiles; ++i) {
+            if (uplo == 'L' ? i >= j : i <= j)
+                ij.push_back( { i, j } );
+        }
+    }
+
+    #pragma omp parallel for schedule(dynamic) num_threads(int(nt))
+    for (size_t t = 0; t < ij.size(); ++t) {
+        int64_t i = ij[ t ].first, j = ij[ t ].second;
+        int64_t ib = blas::min( nb, n - i*nb );
+        int64_t jb = blas::min( nb, n - j*nb );
+        // rows i*nb and j*nb of op(A) and op(B)
+        scalar_t const* Ai = (notrans ? &A[ i*nb ] : &A[ i*nb*lda ]);
+        scalar_t const* Aj = (notrans ? &A[ j*nb ] : &A[ j*nb*lda ]);
+        scalar_t const* Bi = (notrans ? &B[ i*nb ] : &B[ i*nb*ldb ]);
+        scalar_t const* Bj = (notrans ? &B[ j*nb ] : &B[ j*nb*ldb ]);
+        scalar_t*       Cij = &C[ i*nb + j*nb*ldc ];
+        if (i == j) {
+            syr2k( uplo, trans, blas_int( ib ), blas_int( k ),
+                   alpha, Ai, blas_int( lda ), Bi, blas_int( ldb ),
+                   beta, Cij, blas_int( ldc ) );
+        }
+        else {
+            blas::gemm( Layout::ColMajor, transA, transB, ib, jb, k,
+                        alpha, Ai, lda, Bj, ldb, beta, Cij, ldc );
+            blas::gemm( Layout::ColMajor, transA, transB, ib, jb, k,
+                        alpha, Bi, ldb, Aj, lda, scalar_t( 1 ), Cij, ldc );
+        }
+    }
+}
+
 }  // namespace internal
 
 //==============================================================================
@@ -157,9 +216,16 @@ void syr2k(
     char uplo_ = uplo2char( uplo );
     char trans_ = op2char( trans );
 
+    // large C is split into tiles over threads, if enabled
+    int64_t nt = internal::parallel_level3_threads( n, n );
+
     // call low-level wrapper
-    internal::syr2k( uplo_, trans_, n_, k_,
-                     alpha, A, lda_, B, ldb_, beta, C, ldc_ );
+    if (nt > 1)
+        internal::syr2k_tiled( uplo_, trans_, n, k,
+                               alpha, A, lda, B, ldb, beta, C, ldc, nt );
+    else
+        internal::syr2k( uplo_, trans_, n_, k_,
+                         alpha, A, lda_, B, ldb_, beta, C, ldc_ );
 }
 
 }  // namespace impl
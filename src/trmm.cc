@@ -86,6 +86,37 @@ inline void trmm(
                 (blas_complex_double*) B, &ldb );
 }
 
+//------------------------------------------------------------------------------
+/// Computes col-major B = alpha op(A) B or B = alpha B op(A) in parallel
+/// using nt OpenMP threads, each calling the vendor trmm on a chunk of B
+/// along the independent dimension (columns for side = Left, rows for
+/// side = Right). Unlike trsm, splitting the triangular dimension would
+/// not expose more parallelism: updating B in place, each block must be
+/// read by its own product before it is overwritten.
+/// @ingroup trmm_internal
+template <typename scalar_t>
+void trmm_tiled(
+    char side, char uplo, char trans, char diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t*       B, int64_t ldb,
+    int64_t nt )
+{
+    bool left = (side == 'L');
+    int64_t len = (left ? n : m);  // independent dimension
+    int64_t cb  = blas::max( int64_t( 32 ), (len + nt - 1) / nt );
+
+    #pragma omp parallel for schedule(static) num_threads(int(nt))
+    for (int64_t c = 0; c < len; c += cb) {
+        int64_t cl = blas::min( cb, len - c );
+        trmm( side, uplo, trans, diag,
+              blas_int( left ? m : cl ), blas_int( left ? cl : n ),
+              alpha, A, blas_int( lda ),
+              (left ? &B[ c*ldb ] : &B[ c ]), blas_int( ldb ) );
+    }
+}
+
 }  // namespace internal
 
 //==============================================================================
@@ -150,9 +181,16 @@ void trmm(
     char trans_ = op2char( trans );
     char diag_  = diag2char( diag );
 
+    // large B is split into chunks over threads, if enabled
+    int64_t nt = internal::parallel_level3_threads( m, n );
+
     // call low-level wrapper
-    internal::trmm( side_, uplo_, trans_, diag_, m_, n_,
-                    alpha, A, lda_, B, ldb_ );
+    if (nt > 1)
+        internal::trmm_tiled( side_, uplo_, trans_, diag_, m_, n_,
+                              alpha, A, lda, B, ldb, nt );
+    else
+        internal::trmm( side_, uplo_, trans_, diag_, m_, n_,
+                        alpha, A, lda_, B, ldb_ );
 }
 
 }  // namespace impl
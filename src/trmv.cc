@@ -6,6 +6,7 @@
 #include "blas/fortran.h"
 #include "blas.hh"
 #include "blas_internal.hh"
+#include "cblas_internal.hh"
 
 #include <limits>
 
@@ -74,6 +75,62 @@ inline void trmv(
                 (blas_complex_double*) x, &incx );
 }
 
+#if defined(BLAS_USE_CBLAS)
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, float version.
+/// @ingroup trmv_internal
+inline void trmv(
+    CBLAS_ORDER layout,
+    CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag,
+    blas_int n,
+    float const* A, blas_int lda,
+    float*       x, blas_int incx )
+{
+    cblas_strmv( layout, uplo, trans, diag, n, A, lda, x, incx );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, double version.
+/// @ingroup trmv_internal
+inline void trmv(
+    CBLAS_ORDER layout,
+    CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag,
+    blas_int n,
+    double const* A, blas_int lda,
+    double*       x, blas_int incx )
+{
+    cblas_dtrmv( layout, uplo, trans, diag, n, A, lda, x, incx );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<float> version.
+/// @ingroup trmv_internal
+inline void trmv(
+    CBLAS_ORDER layout,
+    CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag,
+    blas_int n,
+    std::complex<float> const* A, blas_int lda,
+    std::complex<float>*       x, blas_int incx )
+{
+    cblas_ctrmv( layout, uplo, trans, diag, n, A, lda, x, incx );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload wrapper calls CBLAS, complex<double> version.
+/// @ingroup trmv_internal
+inline void trmv(
+    CBLAS_ORDER layout,
+    CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag,
+    blas_int n,
+    std::complex<double> const* A, blas_int lda,
+    std::complex<double>*       x, blas_int incx )
+{
+    cblas_ztrmv( layout, uplo, trans, diag, n, A, lda, x, incx );
+}
+
+#endif // BLAS_USE_CBLAS
+
 }  // namespace internal
 
 //==============================================================================
@@ -113,6 +170,17 @@ void trmv(
     blas_int lda_  = to_blas_int( lda );
     blas_int incx_ = to_blas_int( incx );
 
+    #if defined(BLAS_USE_CBLAS)
+        if (layout == Layout::RowMajor) {
+            // vendor's native row-major kernel; no swaps or conjugated copies
+            internal::trmv( CblasRowMajor, internal::uplo2cblas( uplo ),
+                            internal::op2cblas( trans ),
+                            internal::diag2cblas( diag ),
+                            n_, A, lda_, x, incx_ );
+            return;
+        }
+    #endif
+
     blas::Op trans2 = trans;
     if (layout == Layout::RowMajor) {
         // swap lower <=> upper
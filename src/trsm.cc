@@ -6,6 +6,7 @@
 #include "blas/fortran.h"
 #include "blas.hh"
 #include "blas_internal.hh"
+#include "cblas_internal.hh"
 
 #include <limits>
 
@@ -86,6 +87,205 @@ inline void trsm(
                 (blas_complex_double*) B, &ldb );
 }
 
+#if defined(BLAS_HAVE_CBLAS_TRSM_BATCH)
+
+//------------------------------------------------------------------------------
+/// Low-level overload solves count problems sharing one set of
+/// arguments, op(A_i) X_i = alpha B_i or X_i op(A_i) = alpha B_i,
+/// as one group of the vendor's cblas_strsm_batch, float version.
+/// @ingroup trsm_internal
+void trsm_batch(
+    char side,
+    char uplo,
+    char trans,
+    char diag,
+    blas_int m, blas_int n,
+    float alpha,
+    float* const* Aarray, blas_int lda,
+    float* const* Barray, blas_int ldb,
+    blas_int count )
+{
+    CBLAS_SIDE      side_  = side2cblas( char2side( side ) );
+    CBLAS_UPLO      uplo_  = uplo2cblas( char2uplo( uplo ) );
+    CBLAS_TRANSPOSE trans_ = op2cblas( char2op( trans ) );
+    CBLAS_DIAG      diag_  = diag2cblas( char2diag( diag ) );
+    cblas_int m_ = m, n_ = n, count_ = count;
+    cblas_int lda_ = lda, ldb_ = ldb;
+    cblas_strsm_batch( CblasColMajor, &side_, &uplo_, &trans_, &diag_, &m_, &n_,
+                       &alpha, (float const**) Aarray, &lda_,
+                               (float**) Barray, &ldb_,
+                       1, &count_ );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload calls vendor's cblas_dtrsm_batch, double version.
+/// @ingroup trsm_internal
+void trsm_batch(
+    char side,
+    char uplo,
+    char trans,
+    char diag,
+    blas_int m, blas_int n,
+    double alpha,
+    double* const* Aarray, blas_int lda,
+    double* const* Barray, blas_int ldb,
+    blas_int count )
+{
+    CBLAS_SIDE      side_  = side2cblas( char2side( side ) );
+    CBLAS_UPLO      uplo_  = uplo2cblas( char2uplo( uplo ) );
+    CBLAS_TRANSPOSE trans_ = op2cblas( char2op( trans ) );
+    CBLAS_DIAG      diag_  = diag2cblas( char2diag( diag ) );
+    cblas_int m_ = m, n_ = n, count_ = count;
+    cblas_int lda_ = lda, ldb_ = ldb;
+    cblas_dtrsm_batch( CblasColMajor, &side_, &uplo_, &trans_, &diag_, &m_, &n_,
+                       &alpha, (double const**) Aarray, &lda_,
+                               (double**) Barray, &ldb_,
+                       1, &count_ );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload calls vendor's cblas_ctrsm_batch, complex<float> version.
+/// @ingroup trsm_internal
+void trsm_batch(
+    char side,
+    char uplo,
+    char trans,
+    char diag,
+    blas_int m, blas_int n,
+    std::complex<float> alpha,
+    std::complex<float>* const* Aarray, blas_int lda,
+    std::complex<float>* const* Barray, blas_int ldb,
+    blas_int count )
+{
+    CBLAS_SIDE      side_  = side2cblas( char2side( side ) );
+    CBLAS_UPLO      uplo_  = uplo2cblas( char2uplo( uplo ) );
+    CBLAS_TRANSPOSE trans_ = op2cblas( char2op( trans ) );
+    CBLAS_DIAG      diag_  = diag2cblas( char2diag( diag ) );
+    cblas_int m_ = m, n_ = n, count_ = count;
+    cblas_int lda_ = lda, ldb_ = ldb;
+    cblas_ctrsm_batch( CblasColMajor, &side_, &uplo_, &trans_, &diag_, &m_, &n_,
+                       &alpha, (void const**) Aarray, &lda_,
+                               (void**) Barray, &ldb_,
+                       1, &count_ );
+}
+
+//------------------------------------------------------------------------------
+/// Low-level overload calls vendor's cblas_ztrsm_batch, complex<double> version.
+/// @ingroup trsm_internal
+void trsm_batch(
+    char side,
+    char uplo,
+    char trans,
+    char diag,
+    blas_int m, blas_int n,
+    std::complex<double> alpha,
+    std::complex<double>* const* Aarray, blas_int lda,
+    std::complex<double>* const* Barray, blas_int ldb,
+    blas_int count )
+{
+    CBLAS_SIDE      side_  = side2cblas( char2side( side ) );
+    CBLAS_UPLO      uplo_  = uplo2cblas( char2uplo( uplo ) );
+    CBLAS_TRANSPOSE trans_ = op2cblas( char2op( trans ) );
+    CBLAS_DIAG      diag_  = diag2cblas( char2diag( diag ) );
+    cblas_int m_ = m, n_ = n, count_ = count;
+    cblas_int lda_ = lda, ldb_ = ldb;
+    cblas_ztrsm_batch( CblasColMajor, &side_, &uplo_, &trans_, &diag_, &m_, &n_,
+                       &alpha, (void const**) Aarray, &lda_,
+                               (void**) Barray, &ldb_,
+                       1, &count_ );
+}
+
+#endif // BLAS_HAVE_CBLAS_TRSM_BATCH
+
+//------------------------------------------------------------------------------
+/// Solves col-major op(A) X = alpha B or X op(A) = alpha B in parallel
+/// using nt OpenMP threads, each calling the vendor BLAS.
+/// B is split into blocks along the triangular dimension (rows for
+/// side = Left, columns for side = Right) and into nt chunks along the
+/// other, independent, dimension. Block step kk solves the diagonal block
+/// in each chunk, then all remaining blocks are updated with gemm, in
+/// parallel over (block, chunk) pairs; steps are ordered by the implicit
+/// barrier at the end of each parallel loop.
+/// Alpha is applied on each block's first use: in its first update,
+/// or, for the first block, in its solve.
+/// @ingroup trsm_internal
+template <typename scalar_t>
+void trsm_tiled(
+    char side, char uplo, char trans, char diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* A, int64_t lda,
+    scalar_t*       B, int64_t ldb,
+    int64_t nt )
+{
+    const scalar_t one = 1;
+    bool left = (side == 'L');
+    int64_t mn  = (left ? m : n);  // triangular dimension
+    int64_t len = (left ? n : m);  // independent dimension
+
+    int64_t nb = parallel_level3_tile( m, n, nt );
+    int64_t tiles  = (mn + nb - 1) / nb;
+    int64_t cb     = blas::max( int64_t( 32 ), (len + nt - 1) / nt );
+    int64_t chunks = (len + cb - 1) / cb;
+
+    // forward if op(A) is lower (left) or upper (right)
+    bool lower_op = ((uplo == 'L') == (trans == 'N'));
+    bool forward  = (left == lower_op);
+    Op transA = char2op( trans );
+
+    // block t of B in chunk c
+    auto Btile = [&]( int64_t t, int64_t c ) {
+        return (left ? &B[ t*nb + c*cb*ldb ] : &B[ c*cb + t*nb*ldb ]);
+    };
+    // block (i, k) of op(A), with i, k block indices
+    auto Atile = [&]( int64_t i, int64_t k ) {
+        return (trans == 'N' ? &A[ i*nb + k*nb*lda ] : &A[ k*nb + i*nb*lda ]);
+    };
+
+    for (int64_t step = 0; step < tiles; ++step) {
+        int64_t kk = (forward ? step : tiles-1 - step);
+        int64_t kb = blas::min( nb, mn - kk*nb );
+        scalar_t alpha_k = (step == 0 ? alpha : one);
+
+        #pragma omp parallel for schedule(static) num_threads(int(nt))
+        for (int64_t c = 0; c < chunks; ++c) {
+            int64_t cl = blas::min( cb, len - c*cb );
+            trsm( side, uplo, trans, diag,
+                  blas_int( left ? kb : cl ), blas_int( left ? cl : kb ),
+                  alpha_k, &A[ kk*nb + kk*nb*lda ], blas_int( lda ),
+                  Btile( kk, c ), blas_int( ldb ) );
+        }
+
+        // remaining blocks i after kk (forward) or before kk (backward)
+        int64_t remain = (forward ? tiles-1 - kk : kk);
+        int64_t first  = (forward ? kk+1 : 0);
+        #pragma omp parallel for collapse(2) schedule(dynamic) \
+                num_threads(int(nt))
+        for (int64_t i = first; i < first + remain; ++i) {
+            for (int64_t c = 0; c < chunks; ++c) {
+                int64_t ib = blas::min( nb, mn - i*nb );
+                int64_t cl = blas::min( cb, len - c*cb );
+                if (left) {
+                    // B_i = alpha_k B_i - op(A)_ik X_k
+                    blas::gemm( Layout::ColMajor, transA, Op::NoTrans,
+                                ib, cl, kb,
+                                -one, Atile( i, kk ), lda,
+                                      Btile( kk, c ), ldb,
+                                alpha_k, Btile( i, c ), ldb );
+                }
+                else {
+                    // B_i = alpha_k B_i - X_k op(A)_ki
+                    blas::gemm( Layout::ColMajor, Op::NoTrans, transA,
+                                cl, ib, kb,
+                                -one, Btile( kk, c ), ldb,
+                                      Atile( kk, i ), lda,
+                                alpha_k, Btile( i, c ), ldb );
+                }
+            }
+        }
+    }
+}
+
 }  // namespace internal
 
 //==============================================================================
@@ -150,9 +350,25 @@ void trsm(
     char trans_ = op2char( trans );
     char diag_  = diag2char( diag );
 
+    // alpha = 0: B = 0, without reading A, as in reference trsm.
+    // Tiling would otherwise read A in its gemm updates of B.
+    if (alpha == scalar_t( 0 )) {
+        for (int64_t j = 0; j < n_; ++j)
+            for (int64_t i = 0; i < m_; ++i)
+                B[ i + j*ldb ] = 0;
+        return;
+    }
+
+    // large B is split into blocks over threads, if enabled
+    int64_t nt = internal::parallel_level3_threads( m, n );
+
     // call low-level wrapper
-    internal::trsm( side_, uplo_, trans_, diag_, m_, n_,
-                    alpha, A, lda_, B, ldb_ );
+    if (nt > 1)
+        internal::trsm_tiled( side_, uplo_, trans_, diag_, m_, n_,
+                              alpha, A, lda, B, ldb, nt );
+    else
+        internal::trsm( side_, uplo_, trans_, diag_, m_, n_,
+                        alpha, A, lda_, B, ldb_ );
 }
 
 }  // namespace impl
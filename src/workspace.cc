@@ -0,0 +1,101 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/fortran.h"
+#include "blas.hh"
+#include "blas_internal.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace blas {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Host workspace owned by one thread, kept between calls.
+struct ThreadWorkspace
+{
+    std::unique_ptr< char[] > data;
+    size_t size = 0;
+    bool busy = false;
+};
+
+thread_local ThreadWorkspace thread_workspace;
+
+/// Largest workspace, in bytes, kept by a thread between calls; a larger
+/// one is freed on release, so one long vector doesn't pin that much
+/// memory in every thread (e.g., each OpenMP worker) for good.
+const size_t workspace_keep_bytes = 1024*1024;
+
+std::atomic< int64_t > workspace_allocs( 0 );
+
+}  // namespace
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return host workspace of at least bytes, aligned for any scalar type.
+/// Reuses the calling thread's workspace, growing it geometrically if
+/// needed. If it is already in use (nested call), allocates a new buffer.
+/// Release with host_workspace_release, which keeps the workspace only
+/// up to workspace_keep_bytes.
+///
+void* host_workspace_acquire( size_t bytes )
+{
+    ThreadWorkspace& ws = thread_workspace;
+    if (ws.busy) {
+        ++workspace_allocs;
+        return new char[ bytes ];
+    }
+    if (ws.size < bytes) {
+        size_t size = std::max( bytes, 2*ws.size );
+        ws.data.reset();
+        ws.data.reset( new char[ size ] );
+        ws.size = size;
+        ++workspace_allocs;
+    }
+    ws.busy = true;
+    return ws.data.get();
+}
+
+//------------------------------------------------------------------------------
+/// Releases workspace returned by host_workspace_acquire.
+///
+void host_workspace_release( void* ptr )
+{
+    ThreadWorkspace& ws = thread_workspace;
+    if (ws.busy && ptr == ws.data.get()) {
+        ws.busy = false;
+        if (ws.size > workspace_keep_bytes) {
+            ws.data.reset();
+            ws.size = 0;
+        }
+    }
+    else {
+        delete[] static_cast< char* >( ptr );
+    }
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+void host_workspace_free()
+{
+    ThreadWorkspace& ws = thread_workspace;
+    if (! ws.busy) {
+        ws.data.reset();
+        ws.size = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+int64_t host_workspace_allocs()
+{
+    return workspace_allocs.load( std::memory_order_relaxed );
+}
+
+}  // namespace blas
@@ -10,15 +10,19 @@
 #include <cassert>
 #include <complex>
 
+#include "blas/util.hh"
+
 // This is a temporary file giving simple LAPACK wrappers,
 // until the real lapackpp wrappers are available.
 
 // -----------------------------------------------------------------------------
+// Divides in real_type< TX >, since RAND_MAX overflows 16-bit types.
 template <typename TX>
 void lapack_larnv( int64_t idist, int iseed[4], int64_t size, TX *x )
 {
+    using real_t = blas::real_type< TX >;
     for (int64_t i = 0; i < size; ++i) {
-        x[i] = rand() / TX ( RAND_MAX );
+        x[i] = TX( rand() / real_t( RAND_MAX ) );
     }
 }
 
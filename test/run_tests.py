@@ -87,6 +87,8 @@ group_opt.add_argument( '--trans',  action='store', help='default=%(default)s',
 group_opt.add_argument( '--uplo',   action='store', help='default=%(default)s', default='l,u' )
 group_opt.add_argument( '--diag',   action='store', help='default=%(default)s', default='n,u' )
 group_opt.add_argument( '--side',   action='store', help='default=%(default)s', default='l,r' )
+group_opt.add_argument( '--direction', action='store', help='default=%(default)s', default='f,b' )
+group_opt.add_argument( '--generic', action='store', help='default=%(default)s', default='n,y' )
 group_opt.add_argument( '--alpha',  action='store', help='default=%(default)s', default='' )
 group_opt.add_argument( '--beta',   action='store', help='default=%(default)s', default='' )
 group_opt.add_argument( '--incx',   action='store', help='default=%(default)s', default='1,2,-1,-2' )
@@ -95,6 +97,8 @@ group_opt.add_argument( '--batch',  action='store', help='default=%(default)s',
 group_opt.add_argument( '--align',  action='store', help='default=%(default)s', default='32' )
 group_opt.add_argument( '--check',  action='store', help='default=y', default='' )  # default in test.cc
 group_opt.add_argument( '--ref',    action='store', help='default=y', default='' )  # default in test.cc
+group_opt.add_argument( '--level1-threshold', action='store', help='rerun chunked Level 1 routines with $BLASPP_PARALLEL_LEVEL1_THRESHOLD set to this; 0 to skip; default=%(default)s', default='8192' )
+group_opt.add_argument( '--level3-threshold', action='store', help='rerun tiled Level 3 routines with $BLASPP_PARALLEL_LEVEL3_THRESHOLD set to this; 0 to skip; default=%(default)s', default='64' )
 
 parser.add_argument( 'tests', nargs=argparse.REMAINDER )
 opts = parser.parse_args()
@@ -221,6 +225,9 @@ if (not opts.dim):
         mnk = mn
 # end
 
+# long vectors, summed in several blocks by generic Level 1 reductions
+n_long = dim if (opts.dim) else ' --dim 300000'
+
 # BLAS and LAPACK
 dtype  = ' --type '   + opts.type   if (opts.type)   else ''
 layout = ' --layout ' + opts.layout if (opts.layout) else ''
@@ -230,6 +237,8 @@ trans  = ' --trans '  + opts.trans  if (opts.trans)  else ''
 uplo   = ' --uplo '   + opts.uplo   if (opts.uplo)   else ''
 diag   = ' --diag '   + opts.diag   if (opts.diag)   else ''
 side   = ' --side '   + opts.side   if (opts.side)   else ''
+direction = ' --direction ' + opts.direction if (opts.direction) else ''
+generic   = ' --generic '   + opts.generic   if (opts.generic)   else ''
 a      = ' --alpha '  + opts.alpha  if (opts.alpha)  else ''
 ab     = a+' --beta ' + opts.beta   if (opts.beta)   else a
 incx   = ' --incx '   + opts.incx   if (opts.incx)   else ''
@@ -255,6 +264,11 @@ dtype_real    = ' --type ' + filter_csv( ('s', 'd'), opts.type )
 dtype_complex = ' --type ' + filter_csv( ('c', 'z'), opts.type )
 dtype_double  = ' --type ' + filter_csv( ('d', 'z'), opts.type )
 
+# 16-bit storage (float16, bfloat16) computes in float,
+# so it runs only if s is among the types
+run_half      = 's' in opts.type.split( ',' )
+dtype_half    = ' --type s --storage h,b'
+
 trans_nt = ' --trans ' + filter_csv( ('n', 't'), opts.trans )
 trans_nc = ' --trans ' + filter_csv( ('n', 'c'), opts.trans )
 
@@ -268,13 +282,14 @@ cmds = []
 # Level 1
 if (opts.blas1):
     cmds += [
-    [ 'asum',  dtype      + n + incx_pos ],
+    [ 'asum',  dtype      + n + incx_pos + generic ],
     [ 'axpy',  dtype      + n + incx + incy ],
     [ 'copy',  dtype      + n + incx + incy ],
-    [ 'dot',   dtype      + n + incx + incy ],
-    [ 'dotu',  dtype      + n + incx + incy ],
-    [ 'iamax', dtype      + n + incx_pos ],
-    [ 'nrm2',  dtype      + n + incx_pos ],
+    [ 'dot',   dtype      + n + incx + incy + generic ],
+    [ 'dot',   dtype      + n_long + incx + incy + generic ],
+    [ 'dotu',  dtype      + n + incx + incy + generic ],
+    [ 'iamax', dtype      + n + incx_pos + generic ],
+    [ 'nrm2',  dtype      + n + incx_pos + generic ],
     [ 'rot',   dtype      + n + incx + incy ],
     [ 'rotg',  dtype ],
     [ 'rotm',  dtype_real + n + incx + incy ],
@@ -283,6 +298,31 @@ if (opts.blas1):
     [ 'swap',  dtype      + n + incx + incy ],
     ]
 
+# Level 1 with 16-bit storage
+if (opts.blas1 and run_half):
+    cmds += [
+    [ 'axpy',  dtype_half + n + incx + incy ],
+    [ 'dot',   dtype_half + n + incx + incy ],
+    ]
+
+# Level 1 again, long enough and with a low threshold so the chunked
+# versions run, including with negative increments.
+# Chunking needs at least 2 OpenMP threads.
+run_chunked = opts.level1_threshold not in ('', '0')
+chunked = { 'BLASPP_PARALLEL_LEVEL1_THRESHOLD': opts.level1_threshold,
+            'OMP_NUM_THREADS': os.environ.get( 'OMP_NUM_THREADS', '4' ) }
+if (opts.blas1 and run_chunked):
+    cmds += [
+    [ 'asum',  dtype      + n_long + incx_pos + generic, chunked ],
+    [ 'axpy',  dtype      + n_long + incx + incy, chunked ],
+    [ 'copy',  dtype      + n_long + incx + incy, chunked ],
+    [ 'dot',   dtype      + n_long + incx + incy + generic, chunked ],
+    [ 'dotu',  dtype      + n_long + incx + incy + generic, chunked ],
+    [ 'nrm2',  dtype      + n_long + incx_pos + generic, chunked ],
+    [ 'scal',  dtype      + n_long + incx_pos, chunked ],
+    [ 'swap',  dtype      + n_long + incx + incy, chunked ],
+    ]
+
 if (opts.blas1_device):
     cmds += [
     [ 'dev-axpy',  dtype + n + incx + incy ],
@@ -297,41 +337,79 @@ if (opts.blas1_device):
 # Level 2
 if (opts.blas2):
     cmds += [
-    [ 'gemv',  dtype      + layout + align + trans + mn + incx + incy ],
+    [ 'gemv',  dtype      + layout + align + trans + mn + incx + incy + generic ],
     [ 'ger',   dtype      + layout + align + mn + incx + incy ],
     [ 'geru',  dtype      + layout + align + mn + incx + incy ],
-    [ 'hemv',  dtype      + layout + align + uplo + n + incx + incy ],
+    [ 'hemv',  dtype      + layout + align + uplo + n + incx + incy + generic ],
     [ 'her',   dtype      + layout + align + uplo + n + incx ],
     [ 'her2',  dtype      + layout + align + uplo + n + incx + incy ],
-    [ 'symv',  dtype_real + layout + align + uplo + n + incx + incy ], # complex is in lapack++
+    [ 'symv',  dtype_real + layout + align + uplo + n + incx + incy + generic ], # complex is in lapack++
     [ 'syr',   dtype_real + layout + align + uplo + n + incx ], # complex is in lapack++
     [ 'syr2',  dtype      + layout + align + uplo + n + incx + incy ],
-    [ 'trmv',  dtype      + layout + align + uplo + trans + diag + n + incx ],
-    [ 'trsv',  dtype      + layout + align + uplo + trans + diag + n + incx ],
+    [ 'trmv',  dtype      + layout + align + uplo + trans + diag + n + incx + generic ],
+    [ 'trsv',  dtype      + layout + align + uplo + trans + diag + n + incx + generic ],
+    [ 'rot-sequence', dtype + layout + align + side + direction + mn ],
+    ]
+
+# Level 2 with 16-bit storage
+if (opts.blas2 and run_half):
+    cmds += [
+    [ 'gemv',  dtype_half + layout + align + trans + mn + incx + incy ],
     ]
 
 # Level 3
 if (opts.blas3):
     cmds += [
     [ 'gemm',  dtype         + layout + align + transA + transB + mnk ],
-    [ 'hemm',  dtype         + layout + align + side + uplo + mn ],
-    [ 'symm',  dtype         + layout + align + side + uplo + mn ],
-    [ 'trmm',  dtype         + layout + align + side + uplo + trans + diag + mn ],
-    [ 'trsm',  dtype         + layout + align + side + uplo + trans + diag + mn ],
-    [ 'herk',  dtype_real    + layout + align + uplo + trans    + mn ],
-    [ 'herk',  dtype_complex + layout + align + uplo + trans_nc + mn ],
-    [ 'syrk',  dtype_real    + layout + align + uplo + trans    + mn ],
-    [ 'syrk',  dtype_complex + layout + align + uplo + trans_nt + mn ],
-    [ 'her2k', dtype_real    + layout + align + uplo + trans    + mn ],
-    [ 'her2k', dtype_complex + layout + align + uplo + trans_nc + mn ],
-    [ 'syr2k', dtype_real    + layout + align + uplo + trans    + mn ],
-    [ 'syr2k', dtype_complex + layout + align + uplo + trans_nt + mn ],
+    [ 'gemm-mixed', dtype    + layout + align + transA + transB + mnk ],
+    [ 'hemm',  dtype         + layout + align + side + uplo + mn + generic ],
+    [ 'symm',  dtype         + layout + align + side + uplo + mn + generic ],
+    [ 'trmm',  dtype         + layout + align + side + uplo + trans + diag + mn + generic ],
+    [ 'trsm',  dtype         + layout + align + side + uplo + trans + diag + mn + generic ],
+    [ 'herk',  dtype_real    + layout + align + uplo + trans    + mn + generic ],
+    [ 'herk',  dtype_complex + layout + align + uplo + trans_nc + mn + generic ],
+    [ 'syrk',  dtype_real    + layout + align + uplo + trans    + mn + generic ],
+    [ 'syrk',  dtype_complex + layout + align + uplo + trans_nt + mn + generic ],
+    [ 'her2k', dtype_real    + layout + align + uplo + trans    + mn + generic ],
+    [ 'her2k', dtype_complex + layout + align + uplo + trans_nc + mn + generic ],
+    [ 'syr2k', dtype_real    + layout + align + uplo + trans    + mn + generic ],
+    [ 'syr2k', dtype_complex + layout + align + uplo + trans_nt + mn + generic ],
+    ]
+
+# Level 3 with 16-bit storage
+if (opts.blas3 and run_half):
+    cmds += [
+    [ 'gemm',  dtype_half    + layout + align + transA + transB + mnk ],
+    ]
+
+# Level 3 again, with a low threshold so the tiled versions run.
+# Tiling needs at least 2 OpenMP threads.
+run_tiled = opts.level3_threshold not in ('', '0')
+tiled = { 'BLASPP_PARALLEL_LEVEL3_THRESHOLD': opts.level3_threshold,
+          'OMP_NUM_THREADS': os.environ.get( 'OMP_NUM_THREADS', '4' ) }
+if (opts.blas3 and run_tiled):
+    cmds += [
+    [ 'gemm',  dtype         + layout + align + transA + transB + mnk, tiled ],
+    [ 'hemm',  dtype         + layout + align + side + uplo + mn + generic, tiled ],
+    [ 'symm',  dtype         + layout + align + side + uplo + mn + generic, tiled ],
+    [ 'trmm',  dtype         + layout + align + side + uplo + trans + diag + mn + generic, tiled ],
+    [ 'trsm',  dtype         + layout + align + side + uplo + trans + diag + mn + generic, tiled ],
+    [ 'herk',  dtype_real    + layout + align + uplo + trans    + mn + generic, tiled ],
+    [ 'herk',  dtype_complex + layout + align + uplo + trans_nc + mn + generic, tiled ],
+    [ 'syrk',  dtype_real    + layout + align + uplo + trans    + mn + generic, tiled ],
+    [ 'syrk',  dtype_complex + layout + align + uplo + trans_nt + mn + generic, tiled ],
+    [ 'her2k', dtype_real    + layout + align + uplo + trans    + mn + generic, tiled ],
+    [ 'her2k', dtype_complex + layout + align + uplo + trans_nc + mn + generic, tiled ],
+    [ 'syr2k', dtype_real    + layout + align + uplo + trans    + mn + generic, tiled ],
+    [ 'syr2k', dtype_complex + layout + align + uplo + trans_nt + mn + generic, tiled ],
     ]
 
 # Batch Level 3
 if (opts.batch_blas3):
     cmds += [
     [ 'batch-gemm',  dtype         + batch + layout + align + transA + transB + mnk ],
+    [ 'batch-gemm',  dtype         + batch + layout + align + transA + transB + mnk + ' --mode v' ],
+    [ 'batch-gemm-group', dtype    + batch + layout + align + transA + transB + mnk ],
     [ 'batch-hemm',  dtype         + batch + layout + align + side + uplo + mn ],
     [ 'batch-symm',  dtype         + batch + layout + align + side + uplo + mn ],
     [ 'batch-trmm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn ],
@@ -344,6 +422,41 @@ if (opts.batch_blas3):
     [ 'batch-her2k', dtype_complex + batch + layout + align + uplo + trans_nc + mn ],
     [ 'batch-syr2k', dtype_real    + batch + layout + align + uplo + trans    + mn ],
     [ 'batch-syr2k', dtype_complex + batch + layout + align + uplo + trans_nt + mn ],
+    [ 'batch-hemm',  dtype         + batch + layout + align + side + uplo + mn + ' --mode v' ],
+    [ 'batch-symm',  dtype         + batch + layout + align + side + uplo + mn + ' --mode v' ],
+    [ 'batch-trmm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn + ' --mode v' ],
+    [ 'batch-trsm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn + ' --mode v' ],
+    [ 'batch-herk',  dtype_real    + batch + layout + align + uplo + trans    + mn + ' --mode v' ],
+    [ 'batch-herk',  dtype_complex + batch + layout + align + uplo + trans_nc + mn + ' --mode v' ],
+    [ 'batch-syrk',  dtype_real    + batch + layout + align + uplo + trans    + mn + ' --mode v' ],
+    [ 'batch-syrk',  dtype_complex + batch + layout + align + uplo + trans_nt + mn + ' --mode v' ],
+    [ 'batch-her2k', dtype_real    + batch + layout + align + uplo + trans    + mn + ' --mode v' ],
+    [ 'batch-her2k', dtype_complex + batch + layout + align + uplo + trans_nc + mn + ' --mode v' ],
+    [ 'batch-syr2k', dtype_real    + batch + layout + align + uplo + trans    + mn + ' --mode v' ],
+    [ 'batch-syr2k', dtype_complex + batch + layout + align + uplo + trans_nt + mn + ' --mode v' ],
+    [ 'batch-gemm',  dtype         + batch + layout + align + transA + transB + mnk + ' --mode c' ],
+    [ 'batch-trmm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn + ' --mode c' ],
+    [ 'batch-trsm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn + ' --mode c' ],
+    [ 'batch-gemm',  dtype         + batch + layout + align + transA + transB + mnk + ' --mode s' ],
+    [ 'batch-hemm',  dtype         + batch + layout + align + side + uplo + mn + ' --mode s' ],
+    [ 'batch-symm',  dtype         + batch + layout + align + side + uplo + mn + ' --mode s' ],
+    [ 'batch-trmm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn + ' --mode s' ],
+    [ 'batch-trsm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn + ' --mode s' ],
+    [ 'batch-herk',  dtype_real    + batch + layout + align + uplo + trans    + mn + ' --mode s' ],
+    [ 'batch-herk',  dtype_complex + batch + layout + align + uplo + trans_nc + mn + ' --mode s' ],
+    [ 'batch-syrk',  dtype_real    + batch + layout + align + uplo + trans    + mn + ' --mode s' ],
+    [ 'batch-syrk',  dtype_complex + batch + layout + align + uplo + trans_nt + mn + ' --mode s' ],
+    ]
+
+# variable sizes again, so the largest problem is split over tiles
+if (opts.batch_blas3 and run_tiled):
+    cmds += [
+    [ 'batch-gemm',  dtype         + batch + layout + align + transA + transB + mnk + ' --mode v', tiled ],
+    [ 'batch-hemm',  dtype         + batch + layout + align + side + uplo + mn + ' --mode v', tiled ],
+    [ 'batch-trmm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn + ' --mode v', tiled ],
+    [ 'batch-trsm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn + ' --mode v', tiled ],
+    [ 'batch-herk',  dtype_complex + batch + layout + align + uplo + trans_nc + mn + ' --mode v', tiled ],
+    [ 'batch-her2k', dtype_complex + batch + layout + align + uplo + trans_nc + mn + ' --mode v', tiled ],
     ]
 
 if (opts.blas3_device):
@@ -409,17 +522,23 @@ def print_tee( *args ):
 # end
 
 # ------------------------------------------------------------------------------
-# cmd is a pair of strings: (function, args)
+# cmd is a pair of strings: (function, args),
+# optionally followed by a dict of environment variables to set.
 
 def run_test( cmd ):
+    env = dict( os.environ )
+    env_str = ''
+    if (len( cmd ) > 2):
+        env.update( cmd[2] )
+        env_str = ' '.join( [k +'='+ v for (k, v) in cmd[2].items()] ) +' '
     cmd = opts.test +' '+ cmd[1] +' '+ cmd[0]
-    print_tee( cmd )
+    print_tee( env_str + cmd )
     if (opts.dry_run):
         return (None, None)
 
     output = ''
     p = subprocess.Popen( cmd.split(), stdout=subprocess.PIPE,
-                                       stderr=subprocess.STDOUT )
+                                       stderr=subprocess.STDOUT, env=env )
     p_out = p.stdout
     if (sys.version_info.major >= 3):
         p_out = io.TextIOWrapper(p.stdout, encoding='utf-8')
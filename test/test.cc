@@ -90,8 +90,12 @@ std::vector< testsweeper::routines_t > routines = {
     { "trsv",   test_trsv,   Section::blas2   },
     { "",       nullptr,     Section::newline },
 
+    { "rot-sequence", test_rot_sequence, Section::blas2 },
+    { "",       nullptr,     Section::newline },
+
     // Level 3 BLAS
     { "gemm",   test_gemm,   Section::blas3   },
+    { "gemm-mixed", test_gemm_mixed, Section::blas3 },
     { "",       nullptr,     Section::newline },
 
     { "hemm",   test_hemm,   Section::blas3   },
@@ -109,6 +113,7 @@ std::vector< testsweeper::routines_t > routines = {
     { "",       nullptr,     Section::newline },
 
     { "batch-gemm",   test_batch_gemm,   Section::blas3   },
+    { "batch-gemm-group", test_batch_gemm_group, Section::blas3 },
     { "",             nullptr,           Section::newline },
 
     { "batch-hemm",   test_batch_hemm,   Section::blas3   },
@@ -213,6 +218,7 @@ Params::Params():
     // ----- routine parameters
     //          name,      w,    type,            def,                    char2enum,         enum2char,         enum2str,         help
     datatype  ( "type",    4,    ParamType::List, DataType::Double,       char2datatype,     datatype2char,     datatype2str,     "s=single (float), d=double, c=complex-single, z=complex-double" ),
+    storage   ( "storage", 8,    ParamType::List, Storage::Native,        char2storage,      storage2char,      storage2str,      "storage: n=native (--type), h=half (float16), b=bfloat16; h and b need --type s" ),
     layout    ( "layout",  6,    ParamType::List, blas::Layout::ColMajor, blas::char2layout, blas::layout2char, blas::layout2str, "layout: r=row major, c=column major" ),
     format    ( "format",  6,    ParamType::List, blas::Format::LAPACK,   blas::char2format, blas::format2char, blas::format2str, "format: l=lapack, t=tile" ),
     side      ( "side",    6,    ParamType::List, blas::Side::Left,       blas::char2side,   blas::side2char,   blas::side2str,   "side: l=left, r=right" ),
@@ -221,6 +227,7 @@ Params::Params():
     transA    ( "transA",  7,    ParamType::List, blas::Op::NoTrans,      blas::char2op,     blas::op2char,     blas::op2str,     "transpose of A: n=no-trans, t=trans, c=conj-trans" ),
     transB    ( "transB",  7,    ParamType::List, blas::Op::NoTrans,      blas::char2op,     blas::op2char,     blas::op2str,     "transpose of B: n=no-trans, t=trans, c=conj-trans" ),
     diag      ( "diag",    7,    ParamType::List, blas::Diag::NonUnit,    blas::char2diag,   blas::diag2char,   blas::diag2str,   "diagonal: n=non-unit, u=unit" ),
+    direction ( "direction", 9,  ParamType::List, Direction::Forward,     char2direction,    direction2char,    direction2str, "direction: f=forward, b=backward" ),
 
     //          name,      w, p, type,            def,   min,     max, help
     dim       ( "dim",     6,    ParamType::List,          0,     1e9, "m by n by k dimensions" ),
@@ -232,6 +239,8 @@ Params::Params():
     batch     ( "batch",   6,    ParamType::List, 100,     0,     1e6, "batch size" ),
     device    ( "device",  6,    ParamType::List,   0,     0,     100, "device id" ),
     pointer_mode ( "pointer-mode",  3,    ParamType::List, 'h',  "hd",          "h == host, d == device" ),
+    generic   ( "generic", 7,    ParamType::List, 'n',  "ny",          "call generic template with explicit types instead of vendor wrapper: n=no, y=yes" ),
+    mode      ( "mode",    4,    ParamType::List, 'u',  "uvcs",        "batch mode: u=uniform sizes, v=variable sizes, mixing tiny and large problems, c=compact format (gemm, trmm, trsm), s=strided, sharing one A where possible (gemm, hemm, herk, symm, syrk, trmm, trsm)" ),
 
     // ----- output parameters
     // min, max are ignored
@@ -263,6 +272,9 @@ Params::Params():
     ref_gflops( "ref gflop/s",  12, 3, PT_Output, no_data, 0, 0, "reference Gflop/s rate" ),
     ref_gbytes( "ref gbyte/s",  12, 3, PT_Output, no_data, 0, 0, "reference Gbyte/s rate" ),
 
+    // heap allocations by BLAS++ host workspace during the timed call
+    allocs    ( "allocs",        6,    ParamType::Output,   0,   0,   0, "heap allocations during call" ),
+
     // default -1 means "no check"
     okay      ( "status",              6,    ParamType::Output,  -1,   0,   0, "success indicator" ),
     msg       ( "",       1, ParamType::Output,  "",           "error message" )
@@ -15,6 +15,68 @@
 // Cast to llong to ensure printing 64 bits.
 using llong = long long;
 
+// -----------------------------------------------------------------------------
+// Storage type of vectors and matrices, for types TestSweeper's DataType
+// lacks. 16-bit types compute in float, so they run with --type s.
+enum class Storage : char {
+    Native   = 'n',  ///< type given by --type
+    Half     = 'h',  ///< blas::float16
+    BFloat16 = 'b',  ///< blas::bfloat16
+};
+
+inline char storage2char( Storage storage )
+{
+    return char( storage );
+}
+
+inline const char* storage2str( Storage storage )
+{
+    switch (storage) {
+        case Storage::Native:   return "native";
+        case Storage::Half:     return "half";
+        case Storage::BFloat16: return "bfloat16";
+    }
+    return "?";
+}
+
+inline Storage char2storage( char storage )
+{
+    storage = char( tolower( storage ) );
+    if (storage != 'n' && storage != 'h' && storage != 'b')
+        throw blas::Error( "unknown storage" );
+    return Storage( storage );
+}
+
+// -----------------------------------------------------------------------------
+// Order of rotations in rot_sequence, with the same values as LAPACK++'s
+// lapack::Direction, which BLAS++ doesn't depend on.
+enum class Direction : char {
+    Forward  = 'F',
+    Backward = 'B',
+};
+
+inline char direction2char( Direction direction )
+{
+    return char( direction );
+}
+
+inline const char* direction2str( Direction direction )
+{
+    switch (direction) {
+        case Direction::Forward:  return "forward";
+        case Direction::Backward: return "backward";
+    }
+    return "?";
+}
+
+inline Direction char2direction( char direction )
+{
+    direction = char( toupper( direction ) );
+    if (direction != 'F' && direction != 'B')
+        throw blas::Error( "unknown direction" );
+    return Direction( direction );
+}
+
 // -----------------------------------------------------------------------------
 class Params: public testsweeper::ParamsBase
 {
@@ -38,6 +100,7 @@ public:
 
     // ----- routine parameters
     testsweeper::ParamEnum< testsweeper::DataType > datatype;
+    testsweeper::ParamEnum< Storage >           storage;
     testsweeper::ParamEnum< blas::Layout >      layout;
     testsweeper::ParamEnum< blas::Format >      format;
     testsweeper::ParamEnum< blas::Side >        side;
@@ -46,6 +109,7 @@ public:
     testsweeper::ParamEnum< blas::Op >          transA;
     testsweeper::ParamEnum< blas::Op >          transB;
     testsweeper::ParamEnum< blas::Diag >        diag;
+    testsweeper::ParamEnum< Direction >         direction;
 
     testsweeper::ParamInt3   dim;
     testsweeper::ParamDouble alpha;
@@ -56,6 +120,8 @@ public:
     testsweeper::ParamInt    batch;
     testsweeper::ParamInt    device;
     testsweeper::ParamChar   pointer_mode;
+    testsweeper::ParamChar   generic;
+    testsweeper::ParamChar   mode;
 
     // ----- output parameters
     testsweeper::ParamScientific error;
@@ -81,6 +147,8 @@ public:
     testsweeper::ParamDouble     ref_gflops;
     testsweeper::ParamDouble     ref_gbytes;
 
+    testsweeper::ParamInt        allocs;
+
     testsweeper::ParamOkay       okay;
     testsweeper::ParamString     msg;
 
@@ -94,6 +162,52 @@ inline T roundup( T x, T y )
     return T( (x + y - 1) / y ) * y;
 }
 
+// -----------------------------------------------------------------------------
+/// @return unit roundoff of type T, half the machine epsilon of its real type.
+template <typename T>
+inline double unit_roundoff()
+{
+    return 0.5 * std::numeric_limits< blas::real_type< T > >::epsilon();
+}
+
+template <>
+inline double unit_roundoff< blas::float16 >()
+{
+    return std::ldexp( 1.0, -11 );
+}
+
+template <>
+inline double unit_roundoff< blas::bfloat16 >()
+{
+    return std::ldexp( 1.0, -8 );
+}
+
+// -----------------------------------------------------------------------------
+/// @return dimension of problem i in a batch of batch_size problems, for
+/// --mode (batch mode) and full dimension dim. With mode 'v' (variable
+/// sizes), most problems are tiny, 1 to 4, every 8th is half size, and the
+/// last is full size, so the largest problem comes last in input order and
+/// costs a good share of the batch. Otherwise, all problems are full size.
+inline int64_t batch_dim( char mode, size_t i, size_t batch_size, int64_t dim )
+{
+    if (mode != 'v' || i == batch_size - 1)
+        return dim;
+    if (i % 8 == 3)
+        return (dim + 1) / 2;
+    return std::min( dim, int64_t( 1 + i % 4 ) );
+}
+
+// -----------------------------------------------------------------------------
+// Defines a local lambda named routine that calls the vendor wrapper
+// blas::routine or, with --generic y (the tester's local bool generic),
+// the template blas::routine< types... > with explicit types.
+// Example: generic_routine( gemv, TA, TX, TY );
+#define generic_routine( routine, ... ) \
+    auto routine = [&]( auto... args ) { \
+        return generic ? blas::routine< __VA_ARGS__ >( args... ) \
+                       : blas::routine( args... ); \
+    }
+
 // -----------------------------------------------------------------------------
 #ifndef assert_throw
     #if defined(BLAS_ERROR_NDEBUG) || (defined(BLAS_ERROR_ASSERT) && defined(NDEBUG))
@@ -161,6 +275,7 @@ void test_geru  ( Params& params, bool run );
 void test_hemv  ( Params& params, bool run );
 void test_her   ( Params& params, bool run );
 void test_her2  ( Params& params, bool run );
+void test_rot_sequence( Params& params, bool run );
 void test_symv  ( Params& params, bool run );
 void test_syr   ( Params& params, bool run );
 void test_syr2  ( Params& params, bool run );
@@ -170,6 +285,7 @@ void test_trsv  ( Params& params, bool run );
 // -----------------------------------------------------------------------------
 // Level 3 BLAS
 void test_gemm  ( Params& params, bool run );
+void test_gemm_mixed( Params& params, bool run );
 void test_hemm  ( Params& params, bool run );
 void test_her2k ( Params& params, bool run );
 void test_herk  ( Params& params, bool run );
@@ -182,6 +298,7 @@ void test_trsm  ( Params& params, bool run );
 // -----------------------------------------------------------------------------
 // Level 3 Batch BLAS
 void test_batch_gemm  ( Params& params, bool run );
+void test_batch_gemm_group ( Params& params, bool run );
 void test_batch_hemm  ( Params& params, bool run );
 void test_batch_her2k ( Params& params, bool run );
 void test_batch_herk  ( Params& params, bool run );
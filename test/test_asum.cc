@@ -21,6 +21,7 @@ void test_asum_work( Params& params, bool run )
     int64_t n       = params.dim.n();
     int64_t incx    = params.incx();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -37,6 +38,8 @@ void test_asum_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( asum, T );
+
     // setup
     size_t size_x = (n - 1) * std::abs(incx) + 1;
     T* x = new T[ size_x ];
@@ -46,9 +49,9 @@ void test_asum_work( Params& params, bool run )
     lapack_larnv( idist, iseed, size_x, x );
 
     // test error exits
-    assert_throw( blas::asum( -1, x, incx ), blas::Error );
-    assert_throw( blas::asum(  n, x,    0 ), blas::Error );
-    assert_throw( blas::asum(  n, x,   -1 ), blas::Error );
+    assert_throw( asum( -1, x, incx ), blas::Error );
+    assert_throw( asum(  n, x,    0 ), blas::Error );
+    assert_throw( asum(  n, x,   -1 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -62,7 +65,7 @@ void test_asum_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    real_t result = blas::asum( n, x, incx );
+    real_t result = asum( n, x, incx );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< T >::asum( n );
@@ -47,15 +47,18 @@ void test_axpy_work( Params& params, bool run )
     size_t size_y = (n - 1) * std::abs(incy) + 1;
     TX* x    = new TX[ size_x ];
     TY* y    = new TY[ size_y ];
-    TY* yref = new TY[ size_y ];
-    TY* y0   = new TY[ size_y ];
+    // same values in scalar_t, for reference
+    scalar_t* xref = new scalar_t[ size_x ];
+    scalar_t* yref = new scalar_t[ size_y ];
+    scalar_t* y0   = new scalar_t[ size_y ];
 
     int64_t idist = 1;
     int iseed[4] = { 0, 0, 0, 1 };
     lapack_larnv( idist, iseed, size_x, x );
     lapack_larnv( idist, iseed, size_y, y );
-    cblas_copy( n, y, incy, yref, incy );
-    cblas_copy( n, y, incy, y0,   incy );
+    std::copy( x, x + size_x, xref );
+    std::copy( y, y + size_y, yref );
+    std::copy( y, y + size_y, y0 );
 
     // test error exits
     assert_throw( blas::axpy( -1, alpha, x, incx, y, incy ), blas::Error );
@@ -72,8 +75,8 @@ void test_axpy_work( Params& params, bool run )
     if (verbose >= 2) {
         printf( "alpha = %.4e + %.4ei;\n",
                 real(alpha), imag(alpha) );
-        printf( "x    = " ); print_vector( n, x, incx );
-        printf( "y    = " ); print_vector( n, y, incy );
+        printf( "x    = " ); print_vector( n, xref, incx );
+        printf( "y    = " ); print_vector( n, y0,   incy );
     }
 
     // run test
@@ -88,15 +91,19 @@ void test_axpy_work( Params& params, bool run )
     params.gflops() = gflop / time;
     params.gbytes() = gbyte / time;
 
+    // result widened to scalar_t
+    scalar_t* yout = new scalar_t[ size_y ];
+    std::copy( y, y + size_y, yout );
+
     if (verbose >= 2) {
-        printf( "y2   = " ); print_vector( n, y, incy );
+        printf( "y2   = " ); print_vector( n, yout, incy );
     }
 
     if (params.check() == 'y') {
         // run reference
         testsweeper::flush_cache( params.cache() );
         time = get_wtime();
-        cblas_axpy( n, alpha, x, incx, yref, incy );
+        cblas_axpy( n, alpha, xref, incx, yref, incy );
         time = get_wtime() - time;
 
         params.ref_time()   = time * 1000;  // msec
@@ -109,19 +116,20 @@ void test_axpy_work( Params& params, bool run )
 
         // maximum component-wise forward error:
         // | fl(yi) - yi | / (2 |alpha xi| + |y0_i|)
+        // overwrites yout with component-wise errors
         real_t error = 0;
         int64_t ix = (incx > 0 ? 0 : (-n + 1)*incx);
         int64_t iy = (incy > 0 ? 0 : (-n + 1)*incy);
         for (int64_t i = 0; i < n; ++i) {
-            y[iy] = std::abs( y[iy] - yref[iy] )
-                  / (2*(std::abs( alpha * x[ix] ) + std::abs( y0[iy] )));
-            error = std::max( error, real( y[iy] ) );
+            yout[iy] = std::abs( yout[iy] - yref[iy] )
+                     / (2*(std::abs( alpha * xref[ix] ) + std::abs( y0[iy] )));
+            error = std::max( error, real( yout[iy] ) );
             ix += incx;
             iy += incy;
         }
 
         if (verbose >= 2) {
-            printf( "err  = " ); print_vector( n, y, incy, "%9.2e" );
+            printf( "err  = " ); print_vector( n, yout, incy, "%9.2e" );
         }
 
         // complex needs extra factor; see Higham, 2002, sec. 3.6.
@@ -129,19 +137,34 @@ void test_axpy_work( Params& params, bool run )
             error /= 2*sqrt(2);
         }
 
-        real_t u = 0.5 * std::numeric_limits< real_t >::epsilon();
+        // rounding y to its storage dominates for 16-bit types
+        real_t u = unit_roundoff< TY >();
         params.error() = error;
         params.okay() = (error < u);
     }
 
     delete[] x;
     delete[] y;
+    delete[] xref;
     delete[] yref;
+    delete[] y0;
+    delete[] yout;
 }
 
 // -----------------------------------------------------------------------------
+// With --storage h or b, x and y are stored in float16 or bfloat16
+// and computed in float, so it requires --type s.
 void test_axpy( Params& params, bool run )
 {
+    if (params.storage() != Storage::Native) {
+        require( params.datatype() == testsweeper::DataType::Single );
+        if (params.storage() == Storage::Half)
+            test_axpy_work< blas::float16, blas::float16 >( params, run );
+        else
+            test_axpy_work< blas::bfloat16, blas::bfloat16 >( params, run );
+        return;
+    }
+
     switch (params.datatype()) {
         case testsweeper::DataType::Single:
             test_axpy_work< float, float >( params, run );
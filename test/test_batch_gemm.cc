@@ -34,6 +34,7 @@ void test_batch_gemm_work( Params& params, bool run )
     size_t  batch   = params.batch();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    char    mode    = params.mode();
 
     // mark non-standard output values
     params.gflops();
@@ -44,28 +45,46 @@ void test_batch_gemm_work( Params& params, bool run )
         return;
 
     // setup
-    int64_t Am = (transA_ == Op::NoTrans ? m_ : k_);
-    int64_t An = (transA_ == Op::NoTrans ? k_ : m_);
-    int64_t Bm = (transB_ == Op::NoTrans ? k_ : n_);
-    int64_t Bn = (transB_ == Op::NoTrans ? n_ : k_);
-    int64_t Cm = m_;
-    int64_t Cn = n_;
-    if (layout == Layout::RowMajor) {
-        std::swap( Am, An );
-        std::swap( Bm, Bn );
-        std::swap( Cm, Cn );
+    // Uniform, compact, and strided batches have one size; variable batches,
+    // one size per problem.
+    size_t nsizes = (mode == 'v' ? batch : 1);
+    std::vector<int64_t> m( nsizes ), n( nsizes ), k( nsizes );
+    std::vector<int64_t> lda( nsizes ), ldb( nsizes ), ldc( nsizes );
+    std::vector<int64_t> Am( nsizes ), An( nsizes ), Bm( nsizes ), Bn( nsizes );
+    std::vector<int64_t> Cm( nsizes ), Cn( nsizes );
+    for (size_t s = 0; s < nsizes; ++s) {
+        m[s] = batch_dim( mode, s, batch, m_ );
+        n[s] = batch_dim( mode, s, batch, n_ );
+        k[s] = batch_dim( mode, s, batch, k_ );
+        Am[s] = (transA_ == Op::NoTrans ? m[s] : k[s]);
+        An[s] = (transA_ == Op::NoTrans ? k[s] : m[s]);
+        Bm[s] = (transB_ == Op::NoTrans ? k[s] : n[s]);
+        Bn[s] = (transB_ == Op::NoTrans ? n[s] : k[s]);
+        Cm[s] = m[s];
+        Cn[s] = n[s];
+        if (layout == Layout::RowMajor) {
+            std::swap( Am[s], An[s] );
+            std::swap( Bm[s], Bn[s] );
+            std::swap( Cm[s], Cn[s] );
+        }
+        lda[s] = roundup( blas::max( Am[s], int64_t( 1 ) ), align );
+        ldb[s] = roundup( blas::max( Bm[s], int64_t( 1 ) ), align );
+        ldc[s] = roundup( blas::max( Cm[s], int64_t( 1 ) ), align );
     }
 
-    int64_t lda_ = roundup( Am, align );
-    int64_t ldb_ = roundup( Bm, align );
-    int64_t ldc_ = roundup( Cm, align );
-    size_t size_A = size_t(lda_)*An;
-    size_t size_B = size_t(ldb_)*Bn;
-    size_t size_C = size_t(ldc_)*Cn;
-    TA* A    = new TA[ batch * size_A ];
-    TB* B    = new TB[ batch * size_B ];
-    TC* C    = new TC[ batch * size_C ];
-    TC* Cref = new TC[ batch * size_C ];
+    // offsets of each problem's matrices
+    std::vector<size_t> offset_A( batch+1 ), offset_B( batch+1 ), offset_C( batch+1 );
+    offset_A[0] = offset_B[0] = offset_C[0] = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        offset_A[i+1] = offset_A[i] + size_t(lda[s])*An[s];
+        offset_B[i+1] = offset_B[i] + size_t(ldb[s])*Bn[s];
+        offset_C[i+1] = offset_C[i] + size_t(ldc[s])*Cn[s];
+    }
+    TA* A    = new TA[ offset_A[batch] ];
+    TB* B    = new TB[ offset_B[batch] ];
+    TC* C    = new TC[ offset_C[batch] ];
+    TC* Cref = new TC[ offset_C[batch] ];
 
     // pointer arrays
     std::vector<TA*>    Aarray( batch );
@@ -73,11 +92,12 @@ void test_batch_gemm_work( Params& params, bool run )
     std::vector<TC*>    Carray( batch );
     std::vector<TC*> Crefarray( batch );
 
+    // strided batches share one A, with stride 0
     for (size_t i = 0; i < batch; ++i) {
-         Aarray[i]   =  A   + i * size_A;
-         Barray[i]   =  B   + i * size_B;
-         Carray[i]   =  C   + i * size_C;
-        Crefarray[i] = Cref + i * size_C;
+         Aarray[i]   =  A   + (mode == 's' ? 0 : offset_A[i]);
+         Barray[i]   =  B   + offset_B[i];
+         Carray[i]   =  C   + offset_C[i];
+        Crefarray[i] = Cref + offset_C[i];
     }
 
     // info
@@ -86,21 +106,15 @@ void test_batch_gemm_work( Params& params, bool run )
     // wrap scalar arguments in std::vector
     std::vector<blas::Op> transA(1, transA_);
     std::vector<blas::Op> transB(1, transB_);
-    std::vector<int64_t>  m(1, m_);
-    std::vector<int64_t>  n(1, n_);
-    std::vector<int64_t>  k(1, k_);
-    std::vector<int64_t>  lda(1, lda_);
-    std::vector<int64_t>  ldb(1, ldb_);
-    std::vector<int64_t>  ldc(1, ldc_);
     std::vector<scalar_t> alpha(1, alpha_);
     std::vector<scalar_t> beta(1, beta_);
 
     int64_t idist = 1;
     int iseed[4] = { 0, 0, 0, 1 };
-    lapack_larnv( idist, iseed, batch * size_A, A );
-    lapack_larnv( idist, iseed, batch * size_B, B );
-    lapack_larnv( idist, iseed, batch * size_C, C );
-    lapack_lacpy( "g", Cm, batch * Cn, C, ldc_, Cref, ldc_ );
+    lapack_larnv( idist, iseed, offset_A[batch], A );
+    lapack_larnv( idist, iseed, offset_B[batch], B );
+    lapack_larnv( idist, iseed, offset_C[batch], C );
+    std::copy( C, C + offset_C[batch], Cref );
 
     // norms for error check
     real_t work[1];
@@ -109,23 +123,75 @@ void test_batch_gemm_work( Params& params, bool run )
     real_t* Cnorm = new real_t[ batch ];
 
     for (size_t i = 0; i < batch; ++i) {
-        Anorm[i] = lapack_lange( "f", Am, An, Aarray[i], lda_, work );
-        Bnorm[i] = lapack_lange( "f", Bm, Bn, Barray[i], ldb_, work );
-        Cnorm[i] = lapack_lange( "f", Cm, Cn, Carray[i], ldc_, work );
+        size_t s = (nsizes == 1 ? 0 : i);
+        Anorm[i] = lapack_lange( "f", Am[s], An[s], Aarray[i], lda[s], work );
+        Bnorm[i] = lapack_lange( "f", Bm[s], Bn[s], Barray[i], ldb[s], work );
+        Cnorm[i] = lapack_lange( "f", Cm[s], Cn[s], Carray[i], ldc[s], work );
     }
 
     // decide error checking mode
     info.resize( 0 );
 
     // run test
-    testsweeper::flush_cache( params.cache() );
-    double time = get_wtime();
-    blas::batch::gemm( layout, transA, transB, m, n, k,
-                       alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
-                       batch, info );
-    time = get_wtime() - time;
-
-    double gflop = batch * blas::Gflop< scalar_t >::gemm( m_, n_, k_ );
+    double time;
+    if (mode == 'c') {
+        // pack into compact format, by dimensions of the stored matrices
+        int64_t Arows = (transA_ == Op::NoTrans ? m_ : k_);
+        int64_t Acols = (transA_ == Op::NoTrans ? k_ : m_);
+        int64_t Brows = (transB_ == Op::NoTrans ? k_ : n_);
+        int64_t Bcols = (transB_ == Op::NoTrans ? n_ : k_);
+        std::vector<TA> Ac( compact_size<TA>( Arows, Acols, batch ) );
+        std::vector<TB> Bc( compact_size<TB>( Brows, Bcols, batch ) );
+        std::vector<TC> Cc( compact_size<TC>( m_, n_, batch ) );
+        pack_compact( layout, Arows, Acols, Aarray, lda[0], Ac.data(), batch );
+        pack_compact( layout, Brows, Bcols, Barray, ldb[0], Bc.data(), batch );
+        pack_compact( layout, m_, n_, Carray, ldc[0], Cc.data(), batch );
+
+        // time excludes packing
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::gemm_compact( transA_, transB_, m_, n_, k_,
+                                   alpha_, Ac.data(), Bc.data(), beta_, Cc.data(),
+                                   batch );
+        time = get_wtime() - time;
+
+        unpack_compact( layout, m_, n_, Cc.data(), Carray, ldc[0], batch );
+    }
+    else if (mode == 's') {
+        int64_t strideB = ldb[0]*Bn[0];
+        int64_t strideC = ldc[0]*Cn[0];
+
+        // test error exits: C of consecutive problems overlap, by one
+        // entry with the smallest valid stride, ldc*(cols - 1) + rows
+        if (batch > 1) {
+            int64_t strideC_min = ldc[0]*(Cn[0] - 1) + Cm[0];
+            assert_throw( blas::batch::gemm( layout, transA_, transB_, m_, n_, k_,
+                                             alpha_, A, lda[0], 0, B, ldb[0], strideB,
+                                             beta_, C, ldc[0], strideC_min - 1, batch ),
+                          blas::Error );
+        }
+
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::gemm( layout, transA_, transB_, m_, n_, k_,
+                           alpha_, A, lda[0], 0, B, ldb[0], strideB,
+                           beta_, C, ldc[0], strideC, batch );
+        time = get_wtime() - time;
+    }
+    else {
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::gemm( layout, transA, transB, m, n, k,
+                           alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
+                           batch, info );
+        time = get_wtime() - time;
+    }
+
+    double gflop = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        gflop += blas::Gflop< scalar_t >::gemm( m[s], n[s], k[s] );
+    }
     params.time()   = time;
     params.gflops() = gflop / time;
 
@@ -134,22 +200,24 @@ void test_batch_gemm_work( Params& params, bool run )
         testsweeper::flush_cache( params.cache() );
         time = get_wtime();
         for (size_t i = 0; i < batch; ++i) {
+            size_t s = (nsizes == 1 ? 0 : i);
             cblas_gemm( cblas_layout_const(layout),
                         cblas_trans_const(transA_),
                         cblas_trans_const(transB_),
-                        m_, n_, k_, alpha_, Aarray[i], lda_, Barray[i], ldb_, beta_, Crefarray[i], ldc_ );
+                        m[s], n[s], k[s], alpha_, Aarray[i], lda[s], Barray[i], ldb[s], beta_, Crefarray[i], ldc[s] );
         }
         time = get_wtime() - time;
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
 
-        // check error compared to reference
+        // check error compared to reference, for every problem
         real_t err, error = 0;
         bool ok, okay = true;
         for (size_t i = 0; i < batch; ++i) {
-            check_gemm( Cm, Cn, k_, alpha_, beta_, Anorm[i], Bnorm[i], Cnorm[i],
-                        Crefarray[i], ldc_, Carray[i], ldc_, verbose, &err, &ok );
+            size_t s = (nsizes == 1 ? 0 : i);
+            check_gemm( Cm[s], Cn[s], k[s], alpha_, beta_, Anorm[i], Bnorm[i], Cnorm[i],
+                        Crefarray[i], ldc[s], Carray[i], ldc[s], verbose, &err, &ok );
             error = std::max( error, err );
             okay &= ok;
         }
@@ -0,0 +1,230 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas_wrappers.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+#include "blas.hh"
+// -----------------------------------------------------------------------------
+template <typename TA, typename TB, typename TC>
+void test_batch_gemm_group_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas::batch;
+    using blas::Op;
+    using blas::Layout;
+    using scalar_t = blas::scalar_type< TA, TB, TC >;
+    using real_t   = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA_ = params.transA();
+    blas::Op transB_ = params.transB();
+    scalar_t alpha_  = params.alpha();
+    scalar_t beta_   = params.beta();
+    int64_t m_       = params.dim.m();
+    int64_t n_       = params.dim.n();
+    int64_t k_       = params.dim.k();
+    size_t  batch   = params.batch();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    // setup
+    // Split batch into 4 groups, differing in sizes, ops, alpha, and beta.
+    // Group 0 uses the given sizes and ops; group 1 is empty; group 2 has
+    // m = 0; group 3 has other sizes and both ops flipped.
+    auto flip = []( Op trans ) {
+        if (trans != Op::NoTrans)
+            return Op::NoTrans;
+        return (blas::is_complex< scalar_t >::value ? Op::ConjTrans : Op::Trans);
+    };
+    const size_t group_count = 4;
+    std::vector<size_t> group_size = {
+        (batch + 2) / 3, 0, (batch + 1) / 3, batch / 3 };
+    std::vector<blas::Op> transA = {
+        transA_, flip( transA_ ), transA_, flip( transA_ ) };
+    std::vector<blas::Op> transB = {
+        transB_, flip( transB_ ), flip( transB_ ), flip( transB_ ) };
+    std::vector<int64_t> m = { m_, m_, 0,  m_/2 + 1 };
+    std::vector<int64_t> n = { n_, n_, n_, n_ + 1   };
+    std::vector<int64_t> k = { k_, k_, k_, k_/2 + 1 };
+    std::vector<scalar_t> alpha( group_count ), beta( group_count );
+    std::vector<int64_t> lda( group_count ), ldb( group_count ), ldc( group_count );
+    std::vector<int64_t> Am( group_count ), An( group_count ), Bm( group_count );
+    std::vector<int64_t> Bn( group_count ), Cm( group_count ), Cn( group_count );
+    for (size_t ig = 0; ig < group_count; ++ig) {
+        alpha[ ig ] = alpha_ * real_t( ig + 1 );
+        beta[ ig ]  = beta_  / real_t( ig + 1 );
+        Am[ ig ] = (transA[ ig ] == Op::NoTrans ? m[ ig ] : k[ ig ]);
+        An[ ig ] = (transA[ ig ] == Op::NoTrans ? k[ ig ] : m[ ig ]);
+        Bm[ ig ] = (transB[ ig ] == Op::NoTrans ? k[ ig ] : n[ ig ]);
+        Bn[ ig ] = (transB[ ig ] == Op::NoTrans ? n[ ig ] : k[ ig ]);
+        Cm[ ig ] = m[ ig ];
+        Cn[ ig ] = n[ ig ];
+        if (layout == Layout::RowMajor) {
+            std::swap( Am[ ig ], An[ ig ] );
+            std::swap( Bm[ ig ], Bn[ ig ] );
+            std::swap( Cm[ ig ], Cn[ ig ] );
+        }
+        lda[ ig ] = roundup( blas::max( Am[ ig ], int64_t( 1 ) ), align );
+        ldb[ ig ] = roundup( blas::max( Bm[ ig ], int64_t( 1 ) ), align );
+        ldc[ ig ] = roundup( blas::max( Cm[ ig ], int64_t( 1 ) ), align );
+    }
+
+    // group and offsets of each problem's matrices
+    std::vector<size_t> group_of( batch );
+    std::vector<size_t> offset_A( batch+1 ), offset_B( batch+1 ), offset_C( batch+1 );
+    offset_A[0] = offset_B[0] = offset_C[0] = 0;
+    for (size_t ig = 0, i = 0; ig < group_count; ++ig) {
+        for (size_t j = 0; j < group_size[ ig ]; ++j, ++i) {
+            group_of[ i ] = ig;
+            offset_A[i+1] = offset_A[i] + size_t(lda[ ig ])*An[ ig ];
+            offset_B[i+1] = offset_B[i] + size_t(ldb[ ig ])*Bn[ ig ];
+            offset_C[i+1] = offset_C[i] + size_t(ldc[ ig ])*Cn[ ig ];
+        }
+    }
+    TA* A    = new TA[ offset_A[batch] ];
+    TB* B    = new TB[ offset_B[batch] ];
+    TC* C    = new TC[ offset_C[batch] ];
+    TC* Cref = new TC[ offset_C[batch] ];
+
+    // pointer arrays
+    std::vector<TA*>    Aarray( batch );
+    std::vector<TB*>    Barray( batch );
+    std::vector<TC*>    Carray( batch );
+    std::vector<TC*> Crefarray( batch );
+
+    for (size_t i = 0; i < batch; ++i) {
+         Aarray[i]   =  A   + offset_A[i];
+         Barray[i]   =  B   + offset_B[i];
+         Carray[i]   =  C   + offset_C[i];
+        Crefarray[i] = Cref + offset_C[i];
+    }
+
+    // info
+    std::vector<int64_t> info( group_count );
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, offset_A[batch], A );
+    lapack_larnv( idist, iseed, offset_B[batch], B );
+    lapack_larnv( idist, iseed, offset_C[batch], C );
+    std::copy( C, C + offset_C[batch], Cref );
+
+    // norms for error check
+    real_t work[1];
+    real_t* Anorm = new real_t[ batch ];
+    real_t* Bnorm = new real_t[ batch ];
+    real_t* Cnorm = new real_t[ batch ];
+
+    for (size_t i = 0; i < batch; ++i) {
+        size_t ig = group_of[ i ];
+        Anorm[i] = lapack_lange( "f", Am[ ig ], An[ ig ], Aarray[i], lda[ ig ], work );
+        Bnorm[i] = lapack_lange( "f", Bm[ ig ], Bn[ ig ], Barray[i], ldb[ ig ], work );
+        Cnorm[i] = lapack_lange( "f", Cm[ ig ], Cn[ ig ], Carray[i], ldc[ ig ], work );
+    }
+
+    // decide error checking mode
+    info.resize( 0 );
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::batch::gemm( layout, transA, transB, m, n, k,
+                       alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
+                       group_size, info );
+    time = get_wtime() - time;
+
+    double gflop = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t ig = group_of[ i ];
+        gflop += blas::Gflop< scalar_t >::gemm( m[ ig ], n[ ig ], k[ ig ] );
+    }
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        for (size_t i = 0; i < batch; ++i) {
+            size_t ig = group_of[ i ];
+            cblas_gemm( cblas_layout_const(layout),
+                        cblas_trans_const(transA[ ig ]),
+                        cblas_trans_const(transB[ ig ]),
+                        m[ ig ], n[ ig ], k[ ig ], alpha[ ig ], Aarray[i], lda[ ig ],
+                        Barray[i], ldb[ ig ], beta[ ig ], Crefarray[i], ldc[ ig ] );
+        }
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        // check error compared to reference;
+        // problems with empty C have nothing to check
+        real_t err, error = 0;
+        bool ok, okay = true;
+        for (size_t i = 0; i < batch; ++i) {
+            size_t ig = group_of[ i ];
+            if (m[ ig ] == 0 || n[ ig ] == 0)
+                continue;
+            check_gemm( Cm[ ig ], Cn[ ig ], k[ ig ], alpha[ ig ], beta[ ig ],
+                        Anorm[i], Bnorm[i], Cnorm[i],
+                        Crefarray[i], ldc[ ig ], Carray[i], ldc[ ig ], verbose, &err, &ok );
+            error = std::max( error, err );
+            okay &= ok;
+        }
+        params.error() = error;
+        params.okay() = okay;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cref;
+    delete[] Anorm;
+    delete[] Bnorm;
+    delete[] Cnorm;
+}
+
+// -----------------------------------------------------------------------------
+void test_batch_gemm_group( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_batch_gemm_group_work< float, float, float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_batch_gemm_group_work< double, double, double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_batch_gemm_group_work< std::complex<float>, std::complex<float>,
+                            std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_batch_gemm_group_work< std::complex<double>, std::complex<double>,
+                            std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -31,6 +31,7 @@ void test_batch_herk_work( Params& params, bool run )
     size_t  batch       = params.batch();
     int64_t align       = params.align();
     int64_t verbose     = params.verbose();
+    char    mode        = params.mode();
 
     // mark non-standard output values
     params.ref_time();
@@ -39,18 +40,39 @@ void test_batch_herk_work( Params& params, bool run )
     if (! run)
         return;
 
+    if (mode == 'c') {
+        params.msg() = "skipping: compact format is tested by batch-gemm, batch-trmm, and batch-trsm";
+        return;
+    }
+
     // setup
-    int64_t Am = (trans_ == Op::NoTrans ? n_ : k_);
-    int64_t An = (trans_ == Op::NoTrans ? k_ : n_);
-    if (layout == Layout::RowMajor)
-        std::swap( Am, An );
-    int64_t lda_ = roundup( Am, align );
-    int64_t ldc_ = roundup( n_, align );
-    size_t size_A = size_t(lda_)*An;
-    size_t size_C = size_t(ldc_)*n_;
-    TA* A    = new TA[ batch * size_A ];
-    TC* C    = new TC[ batch * size_C ];
-    TC* Cref = new TC[ batch * size_C ];
+    // Uniform and strided batches have one size; variable batches, one size
+    // per problem.
+    size_t nsizes = (mode == 'v' ? batch : 1);
+    std::vector<int64_t> n( nsizes ), k( nsizes ), lda( nsizes ), ldc( nsizes );
+    std::vector<int64_t> Am( nsizes ), An( nsizes );
+    for (size_t s = 0; s < nsizes; ++s) {
+        n[s] = batch_dim( mode, s, batch, n_ );
+        k[s] = batch_dim( mode, s, batch, k_ );
+        Am[s] = (trans_ == Op::NoTrans ? n[s] : k[s]);
+        An[s] = (trans_ == Op::NoTrans ? k[s] : n[s]);
+        if (layout == Layout::RowMajor)
+            std::swap( Am[s], An[s] );
+        lda[s] = roundup( blas::max( Am[s], int64_t( 1 ) ), align );
+        ldc[s] = roundup( blas::max( n[s],  int64_t( 1 ) ), align );
+    }
+
+    // offsets of each problem's matrices
+    std::vector<size_t> offset_A( batch+1 ), offset_C( batch+1 );
+    offset_A[0] = offset_C[0] = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        offset_A[i+1] = offset_A[i] + size_t(lda[s])*An[s];
+        offset_C[i+1] = offset_C[i] + size_t(ldc[s])*n[s];
+    }
+    TA* A    = new TA[ offset_A[batch] ];
+    TC* C    = new TC[ offset_C[batch] ];
+    TC* Cref = new TC[ offset_C[batch] ];
 
     // pointer arrays
     std::vector<TA*>    Aarray( batch );
@@ -58,9 +80,9 @@ void test_batch_herk_work( Params& params, bool run )
     std::vector<TC*> Crefarray( batch );
 
     for (size_t i = 0; i < batch; ++i) {
-         Aarray[i]   =  A   + i * size_A;
-         Carray[i]   =  C   + i * size_C;
-        Crefarray[i] = Cref + i * size_C;
+         Aarray[i]   =  A   + offset_A[i];
+         Carray[i]   =  C   + offset_C[i];
+        Crefarray[i] = Cref + offset_C[i];
     }
 
     // info
@@ -69,40 +91,64 @@ void test_batch_herk_work( Params& params, bool run )
     // wrap scalar arguments in std::vector
     std::vector<blas::Uplo> uplo(1, uplo_);
     std::vector<blas::Op>   trans(1, trans_);
-    std::vector<int64_t>    n(1, n_);
-    std::vector<int64_t>    k(1, k_);
-    std::vector<int64_t>    lda(1, lda_);
-    std::vector<int64_t>    ldc(1, ldc_);
     std::vector<real_t>     alpha(1, alpha_);
     std::vector<real_t>     beta(1, beta_);
 
     int64_t idist = 1;
     int iseed[4] = { 0, 0, 0, 1 };
-    lapack_larnv( idist, iseed, batch * size_A, A );
-    lapack_larnv( idist, iseed, batch * size_C, C );
-    lapack_lacpy( "g", n_, batch * n_, C, ldc_, Cref, ldc_ );
+    lapack_larnv( idist, iseed, offset_A[batch], A );
+    lapack_larnv( idist, iseed, offset_C[batch], C );
+    std::copy( C, C + offset_C[batch], Cref );
 
     // norms for error check
     real_t work[1];
     real_t* Anorm = new real_t[ batch ];
     real_t* Cnorm = new real_t[ batch ];
 
-    for (size_t s = 0; s < batch; ++s) {
-        Anorm[s] = lapack_lange( "f", Am, An, Aarray[s], lda_, work );
-        Cnorm[s] = lapack_lansy( "f", uplo2str(uplo_), n_, Carray[s], ldc_, work );
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        Anorm[i] = lapack_lange( "f", Am[s], An[s], Aarray[i], lda[s], work );
+        Cnorm[i] = lapack_lansy( "f", uplo2str(uplo_), n[s], Carray[i], ldc[s], work );
     }
 
     // decide error checking mode
     info.resize( 0 );
 
     // run test
-    testsweeper::flush_cache( params.cache() );
-    double time = get_wtime();
-    blas::batch::herk( layout, uplo, trans, n, k, alpha, Aarray, lda, beta, Carray, ldc,
-                       batch, info );
-    time = get_wtime() - time;
+    double time;
+    if (mode == 's') {
+        int64_t strideA = lda[0]*An[0];
+        int64_t strideC = ldc[0]*n[0];
+
+        // test error exits: C of consecutive problems overlap, by one
+        // entry with the smallest valid stride, ldc*(cols - 1) + rows
+        if (batch > 1) {
+            int64_t strideC_min = ldc[0]*(n[0] - 1) + n[0];
+            assert_throw( blas::batch::herk( layout, uplo_, trans_, n_, k_,
+                                             alpha_, A, lda[0], strideA,
+                                             beta_, C, ldc[0], strideC_min - 1, batch ),
+                          blas::Error );
+        }
 
-    double gflop = batch * blas::Gflop< scalar_t >::herk( n_, k_ );
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::herk( layout, uplo_, trans_, n_, k_,
+                           alpha_, A, lda[0], strideA, beta_, C, ldc[0], strideC, batch );
+        time = get_wtime() - time;
+    }
+    else {
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::herk( layout, uplo, trans, n, k, alpha, Aarray, lda, beta, Carray, ldc,
+                           batch, info );
+        time = get_wtime() - time;
+    }
+
+    double gflop = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        gflop += blas::Gflop< scalar_t >::herk( n[s], k[s] );
+    }
     params.time()   = time;
     params.gflops() = gflop / time;
 
@@ -110,24 +156,25 @@ void test_batch_herk_work( Params& params, bool run )
         // run reference
         testsweeper::flush_cache( params.cache() );
         time = get_wtime();
-        for (size_t s = 0; s < batch; ++s) {
+        for (size_t i = 0; i < batch; ++i) {
+            size_t s = (nsizes == 1 ? 0 : i);
             cblas_herk( cblas_layout_const(layout),
                         cblas_uplo_const(uplo_),
                         cblas_trans_const(trans_),
-                        n_, k_, alpha_, Aarray[s], lda_, beta_, Crefarray[s], ldc_ );
+                        n[s], k[s], alpha_, Aarray[i], lda[s], beta_, Crefarray[i], ldc[s] );
         }
         time = get_wtime() - time;
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
 
-        // check error compared to reference
+        // check error compared to reference, for every problem
         real_t err, error = 0;
         bool ok, okay = true;
-        for (size_t s = 0; s < batch; ++s) {
-            check_herk( uplo_, n_, k_, alpha_, beta_, Anorm[s], Anorm[s], Cnorm[s],
-                        Crefarray[s], ldc_, Carray[s], ldc_, verbose, &err, &ok );
-
+        for (size_t i = 0; i < batch; ++i) {
+            size_t s = (nsizes == 1 ? 0 : i);
+            check_herk( uplo_, n[s], k[s], alpha_, beta_, Anorm[i], Anorm[i], Cnorm[i],
+                        Crefarray[i], ldc[s], Carray[i], ldc[s], verbose, &err, &ok );
             error = std::max( error, err );
             okay &= ok;
         }
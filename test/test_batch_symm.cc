@@ -31,6 +31,7 @@ void test_batch_symm_work( Params& params, bool run )
     size_t  batch       = params.batch();
     int64_t align       = params.align();
     int64_t verbose     = params.verbose();
+    char    mode        = params.mode();
 
     // mark non-standard output values
     params.ref_time();
@@ -39,22 +40,44 @@ void test_batch_symm_work( Params& params, bool run )
     if (! run)
         return;
 
+    if (mode == 'c') {
+        params.msg() = "skipping: compact format is tested by batch-gemm, batch-trmm, and batch-trsm";
+        return;
+    }
+
     // setup
-    int64_t An = (side_ == Side::Left ? m_ : n_);
-    int64_t Cm = m_;
-    int64_t Cn = n_;
-    if (layout == Layout::RowMajor)
-        std::swap( Cm, Cn );
-    int64_t lda_ = roundup( An, align );
-    int64_t ldb_ = roundup( Cm, align );
-    int64_t ldc_ = roundup( Cm, align );
-    size_t size_A = size_t(lda_)*An;
-    size_t size_B = size_t(ldb_)*Cn;
-    size_t size_C = size_t(ldc_)*Cn;
-    TA* A    = new TA[ batch * size_A ];
-    TB* B    = new TB[ batch * size_B ];
-    TC* C    = new TC[ batch * size_C ];
-    TC* Cref = new TC[ batch * size_C ];
+    // Uniform and strided batches have one size; variable batches, one size
+    // per problem.
+    size_t nsizes = (mode == 'v' ? batch : 1);
+    std::vector<int64_t> m( nsizes ), n( nsizes );
+    std::vector<int64_t> lda( nsizes ), ldb( nsizes ), ldc( nsizes );
+    std::vector<int64_t> An( nsizes ), Cm( nsizes ), Cn( nsizes );
+    for (size_t s = 0; s < nsizes; ++s) {
+        m[s] = batch_dim( mode, s, batch, m_ );
+        n[s] = batch_dim( mode, s, batch, n_ );
+        An[s] = (side_ == Side::Left ? m[s] : n[s]);
+        Cm[s] = m[s];
+        Cn[s] = n[s];
+        if (layout == Layout::RowMajor)
+            std::swap( Cm[s], Cn[s] );
+        lda[s] = roundup( blas::max( An[s], int64_t( 1 ) ), align );
+        ldb[s] = roundup( blas::max( Cm[s], int64_t( 1 ) ), align );
+        ldc[s] = roundup( blas::max( Cm[s], int64_t( 1 ) ), align );
+    }
+
+    // offsets of each problem's matrices
+    std::vector<size_t> offset_A( batch+1 ), offset_B( batch+1 ), offset_C( batch+1 );
+    offset_A[0] = offset_B[0] = offset_C[0] = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        offset_A[i+1] = offset_A[i] + size_t(lda[s])*An[s];
+        offset_B[i+1] = offset_B[i] + size_t(ldb[s])*Cn[s];
+        offset_C[i+1] = offset_C[i] + size_t(ldc[s])*Cn[s];
+    }
+    TA* A    = new TA[ offset_A[batch] ];
+    TB* B    = new TB[ offset_B[batch] ];
+    TC* C    = new TC[ offset_C[batch] ];
+    TC* Cref = new TC[ offset_C[batch] ];
 
     // pointer arrays
     std::vector<TA*>    Aarray( batch );
@@ -62,11 +85,12 @@ void test_batch_symm_work( Params& params, bool run )
     std::vector<TC*>    Carray( batch );
     std::vector<TC*> Crefarray( batch );
 
-    for (size_t s = 0; s < batch; ++s) {
-         Aarray[s]   =  A   + s * size_A;
-         Barray[s]   =  B   + s * size_B;
-         Carray[s]   =  C   + s * size_C;
-        Crefarray[s] = Cref + s * size_C;
+    // strided batches share one A, with stride 0
+    for (size_t i = 0; i < batch; ++i) {
+         Aarray[i]   =  A   + (mode == 's' ? 0 : offset_A[i]);
+         Barray[i]   =  B   + offset_B[i];
+         Carray[i]   =  C   + offset_C[i];
+        Crefarray[i] = Cref + offset_C[i];
     }
 
     // info
@@ -75,20 +99,15 @@ void test_batch_symm_work( Params& params, bool run )
     // wrap scalar arguments in std::vector
     std::vector<blas::Side> side(1, side_);
     std::vector<blas::Uplo> uplo(1, uplo_);
-    std::vector<int64_t>    m(1, m_);
-    std::vector<int64_t>    n(1, n_);
-    std::vector<int64_t>    lda(1, lda_);
-    std::vector<int64_t>    ldb(1, ldb_);
-    std::vector<int64_t>    ldc(1, ldc_);
     std::vector<scalar_t>   alpha(1, alpha_);
     std::vector<scalar_t>   beta(1, beta_);
 
     int64_t idist = 1;
     int iseed[4] = { 0, 0, 0, 1 };
-    lapack_larnv( idist, iseed, batch * size_A, A );
-    lapack_larnv( idist, iseed, batch * size_B, B );
-    lapack_larnv( idist, iseed, batch * size_C, C );
-    lapack_lacpy( "g", Cm, batch * Cn, C, ldc_, Cref, ldc_ );
+    lapack_larnv( idist, iseed, offset_A[batch], A );
+    lapack_larnv( idist, iseed, offset_B[batch], B );
+    lapack_larnv( idist, iseed, offset_C[batch], C );
+    std::copy( C, C + offset_C[batch], Cref );
 
     // norms for error check
     real_t work[1];
@@ -96,23 +115,52 @@ void test_batch_symm_work( Params& params, bool run )
     real_t* Bnorm = new real_t[ batch ];
     real_t* Cnorm = new real_t[ batch ];
 
-    for (size_t s = 0; s < batch; ++s) {
-        Anorm[s] = lapack_lansy( "f", uplo2str(uplo_), An, Aarray[s], lda_, work );
-        Bnorm[s] = lapack_lange( "f", Cm, Cn, Barray[s], ldb_, work );
-        Cnorm[s] = lapack_lange( "f", Cm, Cn, Carray[s], ldc_, work );
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        Anorm[i] = lapack_lansy( "f", uplo2str(uplo_), An[s], Aarray[i], lda[s], work );
+        Bnorm[i] = lapack_lange( "f", Cm[s], Cn[s], Barray[i], ldb[s], work );
+        Cnorm[i] = lapack_lange( "f", Cm[s], Cn[s], Carray[i], ldc[s], work );
     }
 
     // decide error checking mode
     info.resize( 0 );
 
     // run test
-    testsweeper::flush_cache( params.cache() );
-    double time = get_wtime();
-    blas::batch::symm( layout, side, uplo, m, n, alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
-                       batch, info );
-    time = get_wtime() - time;
+    double time;
+    if (mode == 's') {
+        int64_t strideB = ldb[0]*Cn[0];
+        int64_t strideC = ldc[0]*Cn[0];
+
+        // test error exits: C of consecutive problems overlap, by one
+        // entry with the smallest valid stride, ldc*(cols - 1) + rows
+        if (batch > 1) {
+            int64_t strideC_min = ldc[0]*(Cn[0] - 1) + Cm[0];
+            assert_throw( blas::batch::symm( layout, side_, uplo_, m_, n_,
+                                             alpha_, A, lda[0], 0, B, ldb[0], strideB,
+                                             beta_, C, ldc[0], strideC_min - 1, batch ),
+                          blas::Error );
+        }
 
-    double gflop = batch * blas::Gflop< scalar_t >::symm( side_, m_, n_ );
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::symm( layout, side_, uplo_, m_, n_,
+                           alpha_, A, lda[0], 0, B, ldb[0], strideB,
+                           beta_, C, ldc[0], strideC, batch );
+        time = get_wtime() - time;
+    }
+    else {
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::symm( layout, side, uplo, m, n, alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc,
+                           batch, info );
+        time = get_wtime() - time;
+    }
+
+    double gflop = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        gflop += blas::Gflop< scalar_t >::symm( side_, m[s], n[s] );
+    }
     params.time()   = time;
     params.gflops() = gflop / time;
 
@@ -120,23 +168,26 @@ void test_batch_symm_work( Params& params, bool run )
         // run reference
         testsweeper::flush_cache( params.cache() );
         time = get_wtime();
-        for (size_t s = 0; s < batch; ++s) {
+        for (size_t i = 0; i < batch; ++i) {
+            size_t s = (nsizes == 1 ? 0 : i);
             cblas_symm( cblas_layout_const(layout),
                         cblas_side_const(side_),
                         cblas_uplo_const(uplo_),
-                        m_, n_, alpha_, Aarray[s], lda_, Barray[s], ldb_, beta_, Crefarray[s], ldc_ );
+                        m[s], n[s], alpha_, Aarray[i], lda[s], Barray[i], ldb[s],
+                        beta_, Crefarray[i], ldc[s] );
         }
         time = get_wtime() - time;
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
 
-        // check error compared to reference
+        // check error compared to reference, for every problem
         real_t err, error = 0;
         bool ok, okay = true;
-        for (size_t s = 0; s < batch; ++s) {
-            check_gemm( Cm, Cn, An, alpha_, beta_, Anorm[s], Bnorm[s], Cnorm[s],
-                        Crefarray[s], ldc_, Carray[s], ldc_, verbose, &err, &ok );
+        for (size_t i = 0; i < batch; ++i) {
+            size_t s = (nsizes == 1 ? 0 : i);
+            check_gemm( Cm[s], Cn[s], An[s], alpha_, beta_, Anorm[i], Bnorm[i], Cnorm[i],
+                        Crefarray[i], ldc[s], Carray[i], ldc[s], verbose, &err, &ok );
             error = std::max( error, err );
             okay &= ok;
         }
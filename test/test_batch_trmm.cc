@@ -32,6 +32,7 @@ void test_batch_trmm_work( Params& params, bool run )
     size_t  batch       = params.batch();
     int64_t align       = params.align();
     int64_t verbose     = params.verbose();
+    char    mode        = params.mode();
 
     // mark non-standard output values
     params.ref_time();
@@ -42,28 +43,45 @@ void test_batch_trmm_work( Params& params, bool run )
 
     // ----------
     // setup
-    int64_t Am = (side_ == Side::Left ? m_ : n_);
-    int64_t Bm = m_;
-    int64_t Bn = n_;
-    if (layout == Layout::RowMajor)
-        std::swap( Bm, Bn );
-    int64_t lda_ = roundup( Am, align );
-    int64_t ldb_ = roundup( Bm, align );
-    size_t size_A = size_t(lda_)*Am;
-    size_t size_B = size_t(ldb_)*Bn;
-    TA* A    = new TA[ batch * size_A ];
-    TB* B    = new TB[ batch * size_B ];
-    TB* Bref = new TB[ batch * size_B ];
+    // Uniform, compact, and strided batches have one size; variable batches,
+    // one size per problem.
+    size_t nsizes = (mode == 'v' ? batch : 1);
+    std::vector<int64_t> m( nsizes ), n( nsizes ), lda( nsizes ), ldb( nsizes );
+    std::vector<int64_t> Am( nsizes ), Bm( nsizes ), Bn( nsizes );
+    for (size_t s = 0; s < nsizes; ++s) {
+        m[s] = batch_dim( mode, s, batch, m_ );
+        n[s] = batch_dim( mode, s, batch, n_ );
+        Am[s] = (side_ == Side::Left ? m[s] : n[s]);
+        Bm[s] = m[s];
+        Bn[s] = n[s];
+        if (layout == Layout::RowMajor)
+            std::swap( Bm[s], Bn[s] );
+        lda[s] = roundup( blas::max( Am[s], int64_t( 1 ) ), align );
+        ldb[s] = roundup( blas::max( Bm[s], int64_t( 1 ) ), align );
+    }
+
+    // offsets of each problem's matrices
+    std::vector<size_t> offset_A( batch+1 ), offset_B( batch+1 );
+    offset_A[0] = offset_B[0] = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        offset_A[i+1] = offset_A[i] + size_t(lda[s])*Am[s];
+        offset_B[i+1] = offset_B[i] + size_t(ldb[s])*Bn[s];
+    }
+    TA* A    = new TA[ offset_A[batch] ];
+    TB* B    = new TB[ offset_B[batch] ];
+    TB* Bref = new TB[ offset_B[batch] ];
 
     // pointer arrays
     std::vector<TA*>    Aarray( batch );
     std::vector<TB*>    Barray( batch );
     std::vector<TB*> Brefarray( batch );
 
+    // strided batches share one A, with stride 0
     for (size_t i = 0; i < batch; ++i) {
-         Aarray[i]   =  A   + i * size_A;
-         Barray[i]   =  B   + i * size_B;
-        Brefarray[i] = Bref + i * size_B;
+         Aarray[i]   =  A   + (mode == 's' ? 0 : offset_A[i]);
+         Barray[i]   =  B   + offset_B[i];
+        Brefarray[i] = Bref + offset_B[i];
     }
 
     // info
@@ -74,39 +92,78 @@ void test_batch_trmm_work( Params& params, bool run )
     std::vector<blas::Uplo> uplo(1, uplo_);
     std::vector<blas::Op>   trans(1, trans_);
     std::vector<blas::Diag> diag(1, diag_);
-    std::vector<int64_t>    m(1, m_);
-    std::vector<int64_t>    n(1, n_);
-    std::vector<int64_t>    lda(1, lda_);
-    std::vector<int64_t>    ldb(1, ldb_);
     std::vector<scalar_t>   alpha(1, alpha_);
 
     int64_t idist = 1;
     int iseed[4] = { 0, 0, 0, 1 };
-    lapack_larnv( idist, iseed, batch * size_A, A );  // TODO: generate
-    lapack_larnv( idist, iseed, batch * size_B, B );  // TODO
-    lapack_lacpy( "g", Bm, batch * Bn, B, ldb_, Bref, ldb_ );
+    lapack_larnv( idist, iseed, offset_A[batch], A );  // TODO: generate
+    lapack_larnv( idist, iseed, offset_B[batch], B );  // TODO
+    std::copy( B, B + offset_B[batch], Bref );
 
     // norms for error check
     real_t work[1];
     real_t* Anorm = new real_t[ batch ];
     real_t* Bnorm = new real_t[ batch ];
 
-    for (size_t s = 0; s < batch; ++s) {
-        Anorm[s] = lapack_lantr( "f", uplo2str(uplo_), diag2str(diag_), Am, Am, Aarray[s], lda_, work );
-        Bnorm[s] = lapack_lange( "f", Bm, Bn, Barray[s], ldb_, work );
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        Anorm[i] = lapack_lantr( "f", uplo2str(uplo_), diag2str(diag_), Am[s], Am[s], Aarray[i], lda[s], work );
+        Bnorm[i] = lapack_lange( "f", Bm[s], Bn[s], Barray[i], ldb[s], work );
     }
 
     // decide error checking mode
     info.resize( 0 );
 
     // run test
-    testsweeper::flush_cache( params.cache() );
-    double time = get_wtime();
-    blas::batch::trmm( layout, side, uplo, trans, diag, m, n, alpha, Aarray, lda, Barray, ldb,
-                       batch, info );
-    time = get_wtime() - time;
+    double time;
+    if (mode == 'c') {
+        // pack into compact format
+        std::vector<TA> Ac( blas::batch::compact_size<TA>( Am[0], Am[0], batch ) );
+        std::vector<TB> Bc( blas::batch::compact_size<TB>( m_, n_, batch ) );
+        blas::batch::pack_compact( layout, Am[0], Am[0], Aarray, lda[0], Ac.data(), batch );
+        blas::batch::pack_compact( layout, m_, n_, Barray, ldb[0], Bc.data(), batch );
+
+        // time excludes packing
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::trmm_compact( side_, uplo_, trans_, diag_, m_, n_,
+                                   alpha_, Ac.data(), Bc.data(), batch );
+        time = get_wtime() - time;
+
+        blas::batch::unpack_compact( layout, m_, n_, Bc.data(), Barray, ldb[0], batch );
+    }
+    else if (mode == 's') {
+        int64_t strideB = ldb[0]*Bn[0];
+
+        // test error exits: B of consecutive problems overlap, by one
+        // entry with the smallest valid stride, ldb*(cols - 1) + rows
+        if (batch > 1) {
+            int64_t strideB_min = ldb[0]*(Bn[0] - 1) + Bm[0];
+            assert_throw( blas::batch::trmm( layout, side_, uplo_, trans_, diag_, m_, n_,
+                                             alpha_, A, lda[0], 0,
+                                             B, ldb[0], strideB_min - 1, batch ),
+                          blas::Error );
+        }
 
-    double gflop = batch * blas::Gflop< scalar_t >::trmm( side_, m_, n_ );
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::trmm( layout, side_, uplo_, trans_, diag_, m_, n_,
+                           alpha_, A, lda[0], 0, B, ldb[0], strideB, batch );
+        time = get_wtime() - time;
+    }
+    else {
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::trmm( layout, side, uplo, trans, diag, m, n, alpha, Aarray, lda, Barray, ldb,
+                           batch, info );
+        time = get_wtime() - time;
+    }
+
+    double gflop = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        gflop += blas::Gflop< scalar_t >::trmm( side_, m[s], n[s] );
+    }
     params.time()   = time;
     params.gflops() = gflop / time;
 
@@ -114,27 +171,29 @@ void test_batch_trmm_work( Params& params, bool run )
         // run reference
         testsweeper::flush_cache( params.cache() );
         time = get_wtime();
-        for (size_t s = 0; s < batch; ++s) {
+        for (size_t i = 0; i < batch; ++i) {
+            size_t s = (nsizes == 1 ? 0 : i);
             cblas_trmm( cblas_layout_const(layout),
                         cblas_side_const(side_),
                         cblas_uplo_const(uplo_),
                         cblas_trans_const(trans_),
                         cblas_diag_const(diag_),
-                        m_, n_, alpha_, Aarray[s], lda_, Brefarray[s], ldb_ );
+                        m[s], n[s], alpha_, Aarray[i], lda[s], Brefarray[i], ldb[s] );
         }
         time = get_wtime() - time;
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
 
-        // check error compared to reference
+        // check error compared to reference, for every problem
         // Am is reduction dimension
         // beta = 0, Cnorm = 0 (initial).
         real_t err, error = 0;
         bool ok, okay = true;
-        for (size_t s = 0; s < batch; ++s) {
-            check_gemm( Bm, Bn, Am, alpha_, scalar_t(0), Anorm[s], Bnorm[s], real_t(0),
-                        Brefarray[s], ldb_, Barray[s], ldb_, verbose, &err, &ok );
+        for (size_t i = 0; i < batch; ++i) {
+            size_t s = (nsizes == 1 ? 0 : i);
+            check_gemm( Bm[s], Bn[s], Am[s], alpha_, scalar_t(0), Anorm[i], Bnorm[i], real_t(0),
+                        Brefarray[i], ldb[s], Barray[i], ldb[s], verbose, &err, &ok );
             error = std::max( error, err );
             okay &= ok;
         }
@@ -33,6 +33,7 @@ void test_batch_trsm_work( Params& params, bool run )
     size_t  batch       = params.batch();
     int64_t align       = params.align();
     int64_t verbose     = params.verbose();
+    char    mode        = params.mode();
 
     // mark non-standard output values
     params.ref_time();
@@ -43,18 +44,34 @@ void test_batch_trsm_work( Params& params, bool run )
 
     // ----------
     // setup
-    int64_t Am = (side_ == Side::Left ? m_ : n_);
-    int64_t Bm = m_;
-    int64_t Bn = n_;
-    if (layout == Layout::RowMajor)
-        std::swap( Bm, Bn );
-    int64_t lda_ = roundup( Am, align );
-    int64_t ldb_ = roundup( Bm, align );
-    size_t size_A = size_t(lda_)*Am;
-    size_t size_B = size_t(ldb_)*Bn;
-    TA* A    = new TA[ batch * size_A ];
-    TB* B    = new TB[ batch * size_B ];
-    TB* Bref = new TB[ batch * size_B ];
+    // Uniform, compact, and strided batches have one size; variable batches,
+    // one size per problem.
+    size_t nsizes = (mode == 'v' ? batch : 1);
+    std::vector<int64_t> m( nsizes ), n( nsizes ), lda( nsizes ), ldb( nsizes );
+    std::vector<int64_t> Am( nsizes ), Bm( nsizes ), Bn( nsizes );
+    for (size_t s = 0; s < nsizes; ++s) {
+        m[s] = batch_dim( mode, s, batch, m_ );
+        n[s] = batch_dim( mode, s, batch, n_ );
+        Am[s] = (side_ == Side::Left ? m[s] : n[s]);
+        Bm[s] = m[s];
+        Bn[s] = n[s];
+        if (layout == Layout::RowMajor)
+            std::swap( Bm[s], Bn[s] );
+        lda[s] = roundup( blas::max( Am[s], int64_t( 1 ) ), align );
+        ldb[s] = roundup( blas::max( Bm[s], int64_t( 1 ) ), align );
+    }
+
+    // offsets of each problem's matrices
+    std::vector<size_t> offset_A( batch+1 ), offset_B( batch+1 );
+    offset_A[0] = offset_B[0] = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        size_t s = (nsizes == 1 ? 0 : i);
+        offset_A[i+1] = offset_A[i] + size_t(lda[s])*Am[s];
+        offset_B[i+1] = offset_B[i] + size_t(ldb[s])*Bn[s];
+    }
+    TA* A    = new TA[ offset_A[batch] ];
+    TB* B    = new TB[ offset_B[batch] ];
+    TB* Bref = new TB[ offset_B[batch] ];
 
     // pointer arrays
     std::vector<TA*>    Aarray( batch );
@@ -62,9 +79,9 @@ void test_batch_trsm_work( Params& params, bool run )
     std::vector<TB*> Brefarray( batch );
 
     for (size_t i = 0; i < batch; ++i) {
-         Aarray[i]   =  A   + i * size_A;
-         Barray[i]   =  B   + i * size_B;
-        Brefarray[i] = Bref + i * size_B;
+         Aarray[i]   =  A   + offset_A[i];
+         Barray[i]   =  B   + offset_B[i];
+        Brefarray[i] = Bref + offset_B[i];
     }
 
     // info
@@ -75,41 +92,39 @@ void test_batch_trsm_work( Params& params, bool run )
     std::vector<blas::Uplo> uplo(1, uplo_);
     std::vector<blas::Op>   trans(1, trans_);
     std::vector<blas::Diag> diag(1, diag_);
-    std::vector<int64_t> m(1, m_);
-    std::vector<int64_t> n(1, n_);
-    std::vector<int64_t> vlda_(1, lda_);
-    std::vector<int64_t> vldb_(1, ldb_);
     std::vector<scalar_t> alpha(1, alpha_);
 
     int64_t idist = 1;
     int iseed[4] = { 0, 0, 0, 1 };
-    lapack_larnv( idist, iseed, batch * size_A, A );  // TODO: generate
-    lapack_larnv( idist, iseed, batch * size_B, B );  // TODO
-    lapack_lacpy( "g", Bm, batch * Bn, B, ldb_, Bref, ldb_ );
+    lapack_larnv( idist, iseed, offset_A[batch], A );  // TODO: generate
+    lapack_larnv( idist, iseed, offset_B[batch], B );  // TODO
+    std::copy( B, B + offset_B[batch], Bref );
 
     // set unused data to nan
-    if (uplo_ == Uplo::Lower) {
-        for (size_t s = 0; s < batch; ++s)
-            for (int64_t j = 0; j < Am; ++j)
+    for (size_t s = 0; s < batch; ++s) {
+        size_t t = (nsizes == 1 ? 0 : s);
+        for (int64_t j = 0; j < Am[t]; ++j) {
+            if (uplo_ == Uplo::Lower) {
                 for (int64_t i = 0; i < j; ++i)  // upper
-                    Aarray[s][ i + j*lda_ ] = nan("");
-    }
-    else {
-        for (size_t s = 0; s < batch; ++s)
-            for (int64_t j = 0; j < Am; ++j)
-                for (int64_t i = j+1; i < Am; ++i)  // lower
-                    Aarray[s][ i + j*lda_ ] = nan("");
+                    Aarray[s][ i + j*lda[t] ] = nan("");
+            }
+            else {
+                for (int64_t i = j+1; i < Am[t]; ++i)  // lower
+                    Aarray[s][ i + j*lda[t] ] = nan("");
+            }
+        }
     }
 
     // Factor A into L L^H or U U^H to get a well-conditioned triangular matrix.
     // If diag_ == Unit, the diagonal is replaced; this is still well-conditioned.
     // First, brute force positive definiteness.
     for (size_t s = 0; s < batch; ++s) {
-        for (int64_t i = 0; i < Am; ++i) {
-            Aarray[s][ i + i*lda_ ] += Am;
+        size_t t = (nsizes == 1 ? 0 : s);
+        for (int64_t i = 0; i < Am[t]; ++i) {
+            Aarray[s][ i + i*lda[t] ] += Am[t];
         }
         int64_t blas_info = 0;
-        lapack_potrf( uplo2str(uplo_), Am, Aarray[s], lda_, &blas_info );
+        lapack_potrf( uplo2str(uplo_), Am[t], Aarray[s], lda[t], &blas_info );
         require( blas_info == 0 );
     }
 
@@ -119,16 +134,18 @@ void test_batch_trsm_work( Params& params, bool run )
     real_t* Bnorm = new real_t[ batch ];
 
     for (size_t s = 0; s < batch; ++s) {
-        Anorm[s] = lapack_lantr( "f", uplo2str(uplo_), diag2str(diag_), Am, Am, Aarray[s], lda_, work );
-        Bnorm[s] = lapack_lange( "f", Bm, Bn, Barray[s], ldb_, work );
+        size_t t = (nsizes == 1 ? 0 : s);
+        Anorm[s] = lapack_lantr( "f", uplo2str(uplo_), diag2str(diag_), Am[t], Am[t], Aarray[s], lda[t], work );
+        Bnorm[s] = lapack_lange( "f", Bm[t], Bn[t], Barray[s], ldb[t], work );
     }
 
     // if row-major, transpose A
     if (layout == Layout::RowMajor) {
         for (size_t s = 0; s < batch; ++s) {
-            for (int64_t j = 0; j < Am; ++j) {
+            size_t t = (nsizes == 1 ? 0 : s);
+            for (int64_t j = 0; j < Am[t]; ++j) {
                 for (int64_t i = 0; i < j; ++i) {
-                    std::swap( Aarray[s][ i + j*lda_ ], Aarray[s][ j + i*lda_ ] );
+                    std::swap( Aarray[s][ i + j*lda[t] ], Aarray[s][ j + i*lda[t] ] );
                 }
             }
         }
@@ -138,13 +155,56 @@ void test_batch_trsm_work( Params& params, bool run )
     info.resize( 0 );
 
     // run test
-    testsweeper::flush_cache( params.cache() );
-    double time = get_wtime();
-    blas::batch::trsm( layout, side, uplo, trans, diag, m, n, alpha, Aarray, vlda_, Barray, vldb_,
-                       batch, info );
-    time = get_wtime() - time;
+    double time;
+    if (mode == 'c') {
+        // pack into compact format
+        std::vector<TA> Ac( blas::batch::compact_size<TA>( Am[0], Am[0], batch ) );
+        std::vector<TB> Bc( blas::batch::compact_size<TB>( m_, n_, batch ) );
+        blas::batch::pack_compact( layout, Am[0], Am[0], Aarray, lda[0], Ac.data(), batch );
+        blas::batch::pack_compact( layout, m_, n_, Barray, ldb[0], Bc.data(), batch );
+
+        // time excludes packing
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::trsm_compact( side_, uplo_, trans_, diag_, m_, n_,
+                                   alpha_, Ac.data(), Bc.data(), batch );
+        time = get_wtime() - time;
+
+        blas::batch::unpack_compact( layout, m_, n_, Bc.data(), Barray, ldb[0], batch );
+    }
+    else if (mode == 's') {
+        int64_t strideA = lda[0]*Am[0];
+        int64_t strideB = ldb[0]*Bn[0];
+
+        // test error exits: B of consecutive problems overlap, by one
+        // entry with the smallest valid stride, ldb*(cols - 1) + rows
+        if (batch > 1) {
+            int64_t strideB_min = ldb[0]*(Bn[0] - 1) + Bm[0];
+            assert_throw( blas::batch::trsm( layout, side_, uplo_, trans_, diag_, m_, n_,
+                                             alpha_, A, lda[0], strideA,
+                                             B, ldb[0], strideB_min - 1, batch ),
+                          blas::Error );
+        }
 
-    double gflop = batch * blas::Gflop< scalar_t >::trsm( side_, m_, n_ );
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::trsm( layout, side_, uplo_, trans_, diag_, m_, n_,
+                           alpha_, A, lda[0], strideA, B, ldb[0], strideB, batch );
+        time = get_wtime() - time;
+    }
+    else {
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::batch::trsm( layout, side, uplo, trans, diag, m, n, alpha, Aarray, lda, Barray, ldb,
+                           batch, info );
+        time = get_wtime() - time;
+    }
+
+    double gflop = 0;
+    for (size_t s = 0; s < batch; ++s) {
+        size_t t = (nsizes == 1 ? 0 : s);
+        gflop += blas::Gflop< scalar_t >::trsm( side_, m[t], n[t] );
+    }
     params.time()   = time;
     params.gflops() = gflop / time;
 
@@ -153,12 +213,13 @@ void test_batch_trsm_work( Params& params, bool run )
         testsweeper::flush_cache( params.cache() );
         time = get_wtime();
         for (size_t s = 0; s < batch; ++s) {
+            size_t t = (nsizes == 1 ? 0 : s);
             cblas_trsm( cblas_layout_const(layout),
                         cblas_side_const(side_),
                         cblas_uplo_const(uplo_),
                         cblas_trans_const(trans_),
                         cblas_diag_const(diag_),
-                        m_, n_, alpha_, Aarray[s], lda_, Brefarray[s], ldb_ );
+                        m[t], n[t], alpha_, Aarray[s], lda[t], Brefarray[s], ldb[t] );
         }
         time = get_wtime() - time;
 
@@ -171,8 +232,9 @@ void test_batch_trsm_work( Params& params, bool run )
         real_t err, error = 0.0;
         bool ok, okay = true;
         for (size_t s = 0; s < batch; ++s) {
-            check_gemm( Bm, Bn, Am, alpha_, scalar_t(0), Anorm[s], Bnorm[s], real_t(0),
-                        Brefarray[s], ldb_, Barray[s], ldb_, verbose, &err, &ok );
+            size_t t = (nsizes == 1 ? 0 : s);
+            check_gemm( Bm[t], Bn[t], Am[t], alpha_, scalar_t(0), Anorm[s], Bnorm[s], real_t(0),
+                        Brefarray[s], ldb[t], Barray[s], ldb[t], verbose, &err, &ok );
             error = std::max( error, err );
             okay &= ok;
         }
@@ -10,6 +10,21 @@
 #include "print_matrix.hh"
 #include "check_gemm.hh"
 
+// -----------------------------------------------------------------------------
+// Adds a*b to the compensated sum s + c, as in Dot2 (Ogita, Rump, Oishi,
+// 2005), so s + c is as accurate as if computed in twice the precision.
+template <typename real_t>
+void dot2_add( real_t a, real_t b, real_t& s, real_t& c )
+{
+    real_t p  = a * b;
+    real_t ep = std::fma( a, b, -p );
+    real_t t  = s + p;
+    real_t z  = t - s;
+    real_t es = (s - (t - z)) + (p - z);
+    s = t;
+    c += es + ep;
+}
+
 // -----------------------------------------------------------------------------
 template <typename TX, typename TY>
 void test_dot_work( Params& params, bool run )
@@ -25,6 +40,7 @@ void test_dot_work( Params& params, bool run )
     int64_t incx    = params.incx();
     int64_t incy    = params.incy();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -32,6 +48,9 @@ void test_dot_work( Params& params, bool run )
     params.ref_time();
     params.ref_gflops();
     params.ref_gbytes();
+    params.error2();
+    params.error2.name( "ill-cond error" );
+    params.error2.width( 14 );
 
     // adjust header to msec
     params.time.name( "time (ms)" );
@@ -41,25 +60,32 @@ void test_dot_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( dot, TX, TY );
+
     // setup
     size_t size_x = (n - 1) * std::abs(incx) + 1;
     size_t size_y = (n - 1) * std::abs(incy) + 1;
     TX* x = new TX[ size_x ];
     TY* y = new TY[ size_y ];
+    // same values in scalar_t, for reference
+    scalar_t* xref = new scalar_t[ size_x ];
+    scalar_t* yref = new scalar_t[ size_y ];
 
     int64_t idist = 1;
     int iseed[4] = { 0, 0, 0, 1 };
     lapack_larnv( idist, iseed, size_x, x );
     lapack_larnv( idist, iseed, size_y, y );
+    std::copy( x, x + size_x, xref );
+    std::copy( y, y + size_y, yref );
 
     // norms for error check
-    real_t Xnorm = cblas_nrm2( n, x, std::abs(incx) );
-    real_t Ynorm = cblas_nrm2( n, y, std::abs(incy) );
+    real_t Xnorm = cblas_nrm2( n, xref, std::abs(incx) );
+    real_t Ynorm = cblas_nrm2( n, yref, std::abs(incy) );
 
     // test error exits
-    assert_throw( blas::dot( -1, x, incx, y, incy ), blas::Error );
-    assert_throw( blas::dot(  n, x,    0, y, incy ), blas::Error );
-    assert_throw( blas::dot(  n, x, incx, y,    0 ), blas::Error );
+    assert_throw( dot( -1, x, incx, y, incy ), blas::Error );
+    assert_throw( dot(  n, x,    0, y, incy ), blas::Error );
+    assert_throw( dot(  n, x, incx, y,    0 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -69,14 +95,14 @@ void test_dot_work( Params& params, bool run )
                 llong( n ), llong( incy ), llong( size_y ), Ynorm );
     }
     if (verbose >= 2) {
-        printf( "x = " ); print_vector( n, x, incx );
-        printf( "y = " ); print_vector( n, y, incy );
+        printf( "x = " ); print_vector( n, xref, incx );
+        printf( "y = " ); print_vector( n, yref, incy );
     }
 
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    scalar_t result = blas::dot( n, x, incx, y, incy );
+    scalar_t result = dot( n, x, incx, y, incy );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::dot( n );
@@ -93,7 +119,7 @@ void test_dot_work( Params& params, bool run )
         // run reference
         testsweeper::flush_cache( params.cache() );
         time = get_wtime();
-        scalar_t ref = cblas_dot( n, x, incx, y, incy );
+        scalar_t ref = cblas_dot( n, xref, incx, yref, incy );
         time = get_wtime() - time;
 
         params.ref_time()   = time * 1000;  // msec
@@ -111,17 +137,83 @@ void test_dot_work( Params& params, bool run )
         bool okay;
         check_gemm( 1, 1, n, scalar_t(1), scalar_t(0), Xnorm, Ynorm, real_t(0),
                     &ref, 1, &result, 1, verbose, &error, &okay );
+
+        // Ill-conditioned sum: the second half of x and y repeats the
+        // first half with y negated, so the exact result is tiny compared
+        // to sum |x_i y_i|; entries span several binades. The reference is
+        // compensated (Dot2). The error relative to sum |x_i y_i| is bounded
+        // by k roundings: n for the vendor BLAS (serial summation), and
+        // dot_block/dot_lanes + log2(dot_lanes) + log2(n/dot_block) for
+        // the generic template, which sums lanes and blocks pairwise.
+        int64_t h = n / 2;
+        auto ix = [&]( int64_t i ) { return incx > 0 ? i*incx : (n - 1 - i)*(-incx); };
+        auto iy = [&]( int64_t i ) { return incy > 0 ? i*incy : (n - 1 - i)*(-incy); };
+        for (int64_t i = 0; i < h; ++i) {
+            x[ ix( i ) ] = x[ ix( i ) ] * std::ldexp( real_t( 1 ), int(i % 11) - 5 );
+            x[ ix( i + h ) ] = x[ ix( i ) ];
+            y[ iy( i + h ) ] = -y[ iy( i ) ];
+        }
+        scalar_t result2 = dot( n, x, incx, y, incy );
+
+        // compensated reference; sum of |products| for the bound
+        real_t re_s = 0, re_c = 0, im_s = 0, im_c = 0, abs_sum = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            real_t xr = real_t( real( x[ ix( i ) ] ) );
+            real_t xi = real_t( -imag( x[ ix( i ) ] ) );  // conj
+            real_t yr = real_t( real( y[ iy( i ) ] ) );
+            real_t yi = real_t( imag( y[ iy( i ) ] ) );
+            dot2_add(  xr, yr, re_s, re_c );
+            dot2_add( -xi, yi, re_s, re_c );
+            dot2_add(  xr, yi, im_s, im_c );
+            dot2_add(  xi, yr, im_s, im_c );
+            abs_sum += std::abs( xr*yr ) + std::abs( xi*yi )
+                     + std::abs( xr*yi ) + std::abs( xi*yr );
+        }
+        scalar_t ref2 = blas::make_scalar< scalar_t >( re_s + re_c, im_s + im_c );
+
+        double k = n;
+        if (generic) {
+            int64_t nb = blas::internal::dot_block;
+            int64_t nblocks = (n + nb - 1) / nb;
+            k = std::min( n, nb ) / blas::internal::dot_lanes
+              + std::log2( blas::internal::dot_lanes )
+              + std::ceil( std::log2( std::max( nblocks, int64_t( 1 ) ) ) );
+        }
+        k += 2;  // product, and complex add
+        real_t error2 = 0;
+        if (abs_sum > 0)
+            error2 = std::abs( result2 - ref2 ) / (k * abs_sum);
+        if (verbose >= 1) {
+            printf( "ill-conditioned dot = %.4e + %.4ei, ref = %.4e + %.4ei\n",
+                    real(result2), imag(result2), real(ref2), imag(ref2) );
+        }
+
+        real_t u = unit_roundoff< scalar_t >();
         params.error() = error;
-        params.okay() = okay;
+        params.error2() = error2;
+        params.okay() = okay && (error2 < u);
     }
 
     delete[] x;
     delete[] y;
+    delete[] xref;
+    delete[] yref;
 }
 
 // -----------------------------------------------------------------------------
+// With --storage h or b, x and y are stored in float16 or bfloat16
+// and computed in float, so it requires --type s.
 void test_dot( Params& params, bool run )
 {
+    if (params.storage() != Storage::Native) {
+        require( params.datatype() == testsweeper::DataType::Single );
+        if (params.storage() == Storage::Half)
+            test_dot_work< blas::float16, blas::float16 >( params, run );
+        else
+            test_dot_work< blas::bfloat16, blas::bfloat16 >( params, run );
+        return;
+    }
+
     switch (params.datatype()) {
         case testsweeper::DataType::Single:
             test_dot_work< float, float >( params, run );
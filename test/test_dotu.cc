@@ -25,6 +25,7 @@ void test_dotu_work( Params& params, bool run )
     int64_t incx    = params.incx();
     int64_t incy    = params.incy();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -41,6 +42,8 @@ void test_dotu_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( dotu, TX, TY );
+
     // setup
     size_t size_x = (n - 1) * std::abs(incx) + 1;
     size_t size_y = (n - 1) * std::abs(incy) + 1;
@@ -57,9 +60,9 @@ void test_dotu_work( Params& params, bool run )
     real_t Ynorm = cblas_nrm2( n, y, std::abs(incy) );
 
     // test error exits
-    assert_throw( blas::dotu( -1, x, incx, y, incy ), blas::Error );
-    assert_throw( blas::dotu(  n, x,    0, y, incy ), blas::Error );
-    assert_throw( blas::dotu(  n, x, incx, y,    0 ), blas::Error );
+    assert_throw( dotu( -1, x, incx, y, incy ), blas::Error );
+    assert_throw( dotu(  n, x,    0, y, incy ), blas::Error );
+    assert_throw( dotu(  n, x, incx, y,    0 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -76,7 +79,7 @@ void test_dotu_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    scalar_t result = blas::dotu( n, x, incx, y, incy );
+    scalar_t result = dotu( n, x, incx, y, incy );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::dot( n );
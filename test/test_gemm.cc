@@ -11,7 +11,13 @@
 #include "check_gemm.hh"
 
 // -----------------------------------------------------------------------------
-template <typename TA, typename TB, typename TC>
+// Tests gemm with A, B, C stored as TA, TB, TC. If compute_t isn't void,
+// tests gemm_mixed< compute_t > instead, computing op(A) op(B) in
+// compute_t, and times single-precision gemm for comparison (time2).
+// The reference is cblas gemm in scalar_type< TA, TB, TC >, on the same
+// values widened, so the error bound is the unit roundoff of the lowest
+// precision, C's storage or compute_t.
+template <typename TA, typename TB, typename TC, typename compute_t = void>
 void test_gemm_work( Params& params, bool run )
 {
     using namespace testsweeper;
@@ -21,6 +27,9 @@ void test_gemm_work( Params& params, bool run )
     using blas::Layout;
     using scalar_t = blas::scalar_type< TA, TB, TC >;
     using real_t   = blas::real_type< scalar_t >;
+    using single_t = std::conditional_t< blas::is_complex< scalar_t >::value,
+                                         std::complex<float>, float >;
+    const bool mixed = ! std::is_void< compute_t >::value;
 
     // get & mark input values
     blas::Layout layout = params.layout();
@@ -38,10 +47,26 @@ void test_gemm_work( Params& params, bool run )
     params.gflops();
     params.ref_time();
     params.ref_gflops();
+    if (mixed) {
+        params.time2();
+        params.gflops2();
+        params.time2.name( "single (s)" );
+        params.gflops2.name( "single gflop/s" );
+        params.ref_time.name( "double (s)" );
+        params.ref_gflops.name( "double gflop/s" );
+    }
 
     if (! run)
         return;
 
+    // gemm, or gemm_mixed if compute_t is given
+    auto gemm = [&]( auto... args ) {
+        if constexpr (std::is_void< compute_t >::value)
+            blas::gemm( args... );
+        else
+            blas::gemm_mixed< compute_t >( args... );
+    };
+
     // setup
     int64_t Am = (transA == Op::NoTrans ? m : k);
     int64_t An = (transA == Op::NoTrans ? k : m);
@@ -63,47 +88,52 @@ void test_gemm_work( Params& params, bool run )
     TA* A    = new TA[ size_A ];
     TB* B    = new TB[ size_B ];
     TC* C    = new TC[ size_C ];
-    TC* Cref = new TC[ size_C ];
+    // same values in scalar_t, for reference
+    scalar_t* Aref = new scalar_t[ size_A ];
+    scalar_t* Bref = new scalar_t[ size_B ];
+    scalar_t* Cref = new scalar_t[ size_C ];
 
     int64_t idist = 1;
     int iseed[4] = { 0, 0, 0, 1 };
     lapack_larnv( idist, iseed, size_A, A );
     lapack_larnv( idist, iseed, size_B, B );
     lapack_larnv( idist, iseed, size_C, C );
-    lapack_lacpy( "g", Cm, Cn, C, ldc, Cref, ldc );
+    std::copy( A, A + size_A, Aref );
+    std::copy( B, B + size_B, Bref );
+    std::copy( C, C + size_C, Cref );
 
     // norms for error check
     real_t work[1];
-    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
-    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
-    real_t Cnorm = lapack_lange( "f", Cm, Cn, C, ldc, work );
+    real_t Anorm = lapack_lange( "f", Am, An, Aref, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, Bref, ldb, work );
+    real_t Cnorm = lapack_lange( "f", Cm, Cn, Cref, ldc, work );
 
     // test error exits
-    assert_throw( blas::gemm( Layout(0), transA, transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( layout,    Op(0),  transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( layout,    transA, Op(0),   m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( layout,    transA, transB, -1,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( layout,    transA, transB,  m, -1,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( layout,    transA, transB,  m,  n, -1, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout(0), transA, transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( layout,    Op(0),  transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( layout,    transA, Op(0),   m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( layout,    transA, transB, -1,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( layout,    transA, transB,  m, -1,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( layout,    transA, transB,  m,  n, -1, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::gemm( Layout::ColMajor, Op::NoTrans,   Op::NoTrans, m, n, k, alpha, A, m-1, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( Layout::ColMajor, Op::Trans,     Op::NoTrans, m, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( Layout::ColMajor, Op::ConjTrans, Op::NoTrans, m, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::ColMajor, Op::NoTrans,   Op::NoTrans, m, n, k, alpha, A, m-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::ColMajor, Op::Trans,     Op::NoTrans, m, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::ColMajor, Op::ConjTrans, Op::NoTrans, m, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::gemm( Layout::RowMajor, Op::NoTrans,   Op::NoTrans, m, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( Layout::RowMajor, Op::Trans,     Op::NoTrans, m, n, k, alpha, A, m-1, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( Layout::RowMajor, Op::ConjTrans, Op::NoTrans, m, n, k, alpha, A, m-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::RowMajor, Op::NoTrans,   Op::NoTrans, m, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::RowMajor, Op::Trans,     Op::NoTrans, m, n, k, alpha, A, m-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::RowMajor, Op::ConjTrans, Op::NoTrans, m, n, k, alpha, A, m-1, B, ldb, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,   m, n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( Layout::ColMajor, Op::NoTrans, Op::Trans,     m, n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( Layout::ColMajor, Op::NoTrans, Op::ConjTrans, m, n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,   m, n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::ColMajor, Op::NoTrans, Op::Trans,     m, n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::ColMajor, Op::NoTrans, Op::ConjTrans, m, n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::gemm( Layout::RowMajor, Op::NoTrans, Op::NoTrans,   m, n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( Layout::RowMajor, Op::NoTrans, Op::Trans,     m, n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::gemm( Layout::RowMajor, Op::NoTrans, Op::ConjTrans, m, n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::RowMajor, Op::NoTrans, Op::NoTrans,   m, n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::RowMajor, Op::NoTrans, Op::Trans,     m, n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( gemm( Layout::RowMajor, Op::NoTrans, Op::ConjTrans, m, n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::gemm( Layout::ColMajor, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, m-1 ), blas::Error );
-    assert_throw( blas::gemm( Layout::RowMajor, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, n-1 ), blas::Error );
+    assert_throw( gemm( Layout::ColMajor, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, m-1 ), blas::Error );
+    assert_throw( gemm( Layout::RowMajor, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, n-1 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -118,24 +148,55 @@ void test_gemm_work( Params& params, bool run )
         printf( "alpha = %.4e + %.4ei; beta = %.4e + %.4ei;\n",
                 real(alpha), imag(alpha),
                 real(beta),  imag(beta) );
-        printf( "A = "    ); print_matrix( Am, An, A, lda );
-        printf( "B = "    ); print_matrix( Bm, Bn, B, ldb );
-        printf( "C = "    ); print_matrix( Cm, Cn, C, ldc );
+        printf( "A = "    ); print_matrix( Am, An, Aref, lda );
+        printf( "B = "    ); print_matrix( Bm, Bn, Bref, ldb );
+        printf( "C = "    ); print_matrix( Cm, Cn, Cref, ldc );
     }
 
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    blas::gemm( layout, transA, transB, m, n, k,
-                alpha, A, lda, B, ldb, beta, C, ldc );
+    gemm( layout, transA, transB, m, n, k,
+          alpha, A, lda, B, ldb, beta, C, ldc );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::gemm( m, n, k );
     params.time()   = time;
     params.gflops() = gflop / time;
 
+    // result widened to scalar_t
+    scalar_t* Cout = new scalar_t[ size_C ];
+    std::copy( C, C + size_C, Cout );
+
     if (verbose >= 2) {
-        printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
+        printf( "C2 = " ); print_matrix( Cm, Cn, Cout, ldc );
+    }
+
+    if (mixed) {
+        // run single-precision gemm for comparison
+        single_t* As = new single_t[ size_A ];
+        single_t* Bs = new single_t[ size_B ];
+        single_t* Cs = new single_t[ size_C ];
+        for (size_t i = 0; i < size_A; ++i)
+            As[ i ] = single_t( Aref[ i ] );
+        for (size_t i = 0; i < size_B; ++i)
+            Bs[ i ] = single_t( Bref[ i ] );
+        for (size_t i = 0; i < size_C; ++i)
+            Cs[ i ] = single_t( Cref[ i ] );
+
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        blas::gemm( layout, transA, transB, m, n, k,
+                    single_t( alpha ), As, lda, Bs, ldb,
+                    single_t( beta ),  Cs, ldc );
+        time = get_wtime() - time;
+
+        params.time2()   = time;
+        params.gflops2() = gflop / time;
+
+        delete[] As;
+        delete[] Bs;
+        delete[] Cs;
     }
 
     if (params.ref() == 'y' || params.check() == 'y') {
@@ -145,7 +206,7 @@ void test_gemm_work( Params& params, bool run )
         cblas_gemm( cblas_layout_const(layout),
                     cblas_trans_const(transA),
                     cblas_trans_const(transB),
-                    m, n, k, alpha, A, lda, B, ldb, beta, Cref, ldc );
+                    m, n, k, alpha, Aref, lda, Bref, ldb, beta, Cref, ldc );
         time = get_wtime() - time;
 
         params.ref_time()   = time;
@@ -155,24 +216,44 @@ void test_gemm_work( Params& params, bool run )
             printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
         }
 
-        // check error compared to reference
+        // check error compared to reference. check_gemm's okay uses the
+        // unit roundoff of scalar_t; reduced precision storage of C or
+        // compute_t loosens it to the larger of their unit roundoffs.
+        using compute_type = std::conditional_t< std::is_void< compute_t >::value,
+                                                 scalar_t, compute_t >;
         real_t error;
         bool okay;
         check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
-                    Cref, ldc, C, ldc, verbose, &error, &okay );
+                    Cref, ldc, Cout, ldc, verbose, &error, &okay );
+        real_t u = std::max( unit_roundoff< TC >(),
+                             unit_roundoff< compute_type >() );
         params.error() = error;
-        params.okay() = okay;
+        params.okay() = (okay || error < u);
     }
 
     delete[] A;
     delete[] B;
     delete[] C;
+    delete[] Aref;
+    delete[] Bref;
     delete[] Cref;
+    delete[] Cout;
 }
 
 // -----------------------------------------------------------------------------
+// With --storage h or b, A, B, C are stored in float16 or bfloat16
+// and computed in float, so it requires --type s.
 void test_gemm( Params& params, bool run )
 {
+    if (params.storage() != Storage::Native) {
+        require( params.datatype() == testsweeper::DataType::Single );
+        if (params.storage() == Storage::Half)
+            test_gemm_work< blas::float16, blas::float16, blas::float16 >( params, run );
+        else
+            test_gemm_work< blas::bfloat16, blas::bfloat16, blas::bfloat16 >( params, run );
+        return;
+    }
+
     switch (params.datatype()) {
         case testsweeper::DataType::Single:
             test_gemm_work< float, float, float >( params, run );
@@ -197,3 +278,33 @@ void test_gemm( Params& params, bool run )
             break;
     }
 }
+
+// -----------------------------------------------------------------------------
+// Single types: single-precision A and B, accumulated in double-precision C.
+// Double types: double-precision A, B, and C, computed in single precision.
+void test_gemm_mixed( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gemm_work< float, float, double, double >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gemm_work< double, double, double, float >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gemm_work< std::complex<float>, std::complex<float>,
+                            std::complex<double>, std::complex<double> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gemm_work< std::complex<double>, std::complex<double>,
+                            std::complex<double>, std::complex<float> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -33,6 +33,7 @@ void test_gemv_work( Params& params, bool run )
     int64_t incy    = params.incy();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -40,6 +41,7 @@ void test_gemv_work( Params& params, bool run )
     params.ref_time();
     params.ref_gflops();
     params.ref_gbytes();
+    params.allocs();
 
     // adjust header to msec
     params.time.name( "time (ms)" );
@@ -49,6 +51,8 @@ void test_gemv_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( gemv, TA, TX, TY );
+
     // setup
     int64_t Am = (layout == Layout::ColMajor ? m : n);
     int64_t An = (layout == Layout::ColMajor ? n : m);
@@ -61,32 +65,37 @@ void test_gemv_work( Params& params, bool run )
     TA* A    = new TA[ size_A ];
     TX* x    = new TX[ size_x ];
     TY* y    = new TY[ size_y ];
-    TY* yref = new TY[ size_y ];
+    // same values in scalar_t, for reference
+    scalar_t* Aref = new scalar_t[ size_A ];
+    scalar_t* xref = new scalar_t[ size_x ];
+    scalar_t* yref = new scalar_t[ size_y ];
 
     int64_t idist = 1;
     int iseed[4] = { 0, 0, 0, 1 };
     lapack_larnv( idist, iseed, size_A, A );
     lapack_larnv( idist, iseed, size_x, x );
     lapack_larnv( idist, iseed, size_y, y );
-    cblas_copy( Ym, y, incy, yref, incy );
+    std::copy( A, A + size_A, Aref );
+    std::copy( x, x + size_x, xref );
+    std::copy( y, y + size_y, yref );
 
     // norms for error check
     real_t work[1];
-    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
-    real_t Xnorm = cblas_nrm2( Xm, x, std::abs(incx) );
-    real_t Ynorm = cblas_nrm2( Ym, y, std::abs(incy) );
+    real_t Anorm = lapack_lange( "f", Am, An, Aref, lda, work );
+    real_t Xnorm = cblas_nrm2( Xm, xref, std::abs(incx) );
+    real_t Ynorm = cblas_nrm2( Ym, yref, std::abs(incy) );
 
     // test error exits
-    assert_throw( blas::gemv( Layout(0), trans,  m,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::gemv( layout,    Op(0),  m,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::gemv( layout,    trans, -1,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::gemv( layout,    trans,  m, -1, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( gemv( Layout(0), trans,  m,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( gemv( layout,    Op(0),  m,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( gemv( layout,    trans, -1,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( gemv( layout,    trans,  m, -1, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
 
-    assert_throw( blas::gemv( Layout::ColMajor, trans,  m,  n, alpha, A, m-1, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::gemv( Layout::RowMajor, trans,  m,  n, alpha, A, n-1, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( gemv( Layout::ColMajor, trans,  m,  n, alpha, A, m-1, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( gemv( Layout::RowMajor, trans,  m,  n, alpha, A, n-1, x, incx, beta, y, incy ), blas::Error );
 
-    assert_throw( blas::gemv( layout,    trans,  m,  n, alpha, A, lda, x, 0,    beta, y, incy ), blas::Error );
-    assert_throw( blas::gemv( layout,    trans,  m,  n, alpha, A, lda, x, incx, beta, y, 0    ), blas::Error );
+    assert_throw( gemv( layout,    trans,  m,  n, alpha, A, lda, x, 0,    beta, y, incy ), blas::Error );
+    assert_throw( gemv( layout,    trans,  m,  n, alpha, A, lda, x, incx, beta, y, 0    ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -101,16 +110,18 @@ void test_gemv_work( Params& params, bool run )
         printf( "alpha = %.4e + %.4ei; beta = %.4e + %.4ei;\n",
                 real(alpha), imag(alpha),
                 real(beta),  imag(beta) );
-        printf( "A = "    ); print_matrix( m, n, A, lda );
-        printf( "x    = " ); print_vector( Xm, x, incx );
-        printf( "y    = " ); print_vector( Ym, y, incy );
+        printf( "A = "    ); print_matrix( m, n, Aref, lda );
+        printf( "x    = " ); print_vector( Xm, xref, incx );
+        printf( "y    = " ); print_vector( Ym, yref, incy );
     }
 
     // run test
     testsweeper::flush_cache( params.cache() );
+    int64_t allocs = blas::host_workspace_allocs();
     double time = get_wtime();
-    blas::gemv( layout, trans, m, n, alpha, A, lda, x, incx, beta, y, incy );
+    gemv( layout, trans, m, n, alpha, A, lda, x, incx, beta, y, incy );
     time = get_wtime() - time;
+    params.allocs() = blas::host_workspace_allocs() - allocs;
 
     double gflop = blas::Gflop< scalar_t >::gemv( m, n );
     double gbyte = blas::Gbyte< scalar_t >::gemv( m, n );
@@ -118,8 +129,12 @@ void test_gemv_work( Params& params, bool run )
     params.gflops() = gflop / time;
     params.gbytes() = gbyte / time;
 
+    // result widened to scalar_t
+    scalar_t* yout = new scalar_t[ size_y ];
+    std::copy( y, y + size_y, yout );
+
     if (verbose >= 2) {
-        printf( "y2   = " ); print_vector( Ym, y, incy );
+        printf( "y2   = " ); print_vector( Ym, yout, incy );
     }
 
     if (params.ref() == 'y' || params.check() == 'y') {
@@ -127,7 +142,7 @@ void test_gemv_work( Params& params, bool run )
         testsweeper::flush_cache( params.cache() );
         time = get_wtime();
         cblas_gemv( cblas_layout_const(layout), cblas_trans_const(trans), m, n,
-                    alpha, A, lda, x, incx, beta, yref, incy );
+                    alpha, Aref, lda, xref, incx, beta, yref, incy );
         time = get_wtime() - time;
 
         params.ref_time()   = time; // * 1000;  // msec
@@ -139,24 +154,41 @@ void test_gemv_work( Params& params, bool run )
         }
 
         // check error compared to reference
-        // treat y as 1 x Ym matrix with ld = incy; k = Xm is reduction dimension
+        // treat y as 1 x Ym matrix with ld = incy; k = Xm is reduction dimension,
+        // with unit roundoff of y's storage or scalar_t, whichever is larger
         real_t error;
         bool okay;
         check_gemm( 1, Ym, Xm, alpha, beta, Anorm, Xnorm, Ynorm,
-                    yref, std::abs(incy), y, std::abs(incy), verbose, &error, &okay );
+                    yref, std::abs(incy), yout, std::abs(incy), verbose, &error, &okay );
+        real_t u = std::max( unit_roundoff< TY >(),
+                             unit_roundoff< scalar_t >() );
         params.error() = error;
-        params.okay() = okay;
+        params.okay() = (error < u);
     }
 
     delete[] A;
     delete[] x;
     delete[] y;
+    delete[] Aref;
+    delete[] xref;
     delete[] yref;
+    delete[] yout;
 }
 
 // -----------------------------------------------------------------------------
+// With --storage h or b, A, x, y are stored in float16 or bfloat16
+// and computed in float, so it requires --type s.
 void test_gemv( Params& params, bool run )
 {
+    if (params.storage() != Storage::Native) {
+        require( params.datatype() == testsweeper::DataType::Single );
+        if (params.storage() == Storage::Half)
+            test_gemv_work< blas::float16, blas::float16, blas::float16 >( params, run );
+        else
+            test_gemv_work< blas::bfloat16, blas::bfloat16, blas::bfloat16 >( params, run );
+        return;
+    }
+
     switch (params.datatype()) {
         case testsweeper::DataType::Single:
             test_gemv_work< float, float, float >( params, run );
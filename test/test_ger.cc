@@ -37,6 +37,7 @@ void test_ger_work( Params& params, bool run )
     params.ref_time();
     params.ref_gflops();
     params.ref_gbytes();
+    params.allocs();
 
     // adjust header to msec
     params.time.name( "time (ms)" );
@@ -101,9 +102,11 @@ void test_ger_work( Params& params, bool run )
 
     // run test
     testsweeper::flush_cache( params.cache() );
+    int64_t allocs = blas::host_workspace_allocs();
     double time = get_wtime();
     blas::ger( layout, m, n, alpha, x, incx, y, incy, A, lda );
     time = get_wtime() - time;
+    params.allocs() = blas::host_workspace_allocs() - allocs;
 
     double gflop = blas::Gflop< scalar_t >::ger( m, n );
     double gbyte = blas::Gbyte< scalar_t >::ger( m, n );
@@ -32,6 +32,7 @@ void test_hemv_work( Params& params, bool run )
     int64_t incy    = params.incy();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -39,6 +40,7 @@ void test_hemv_work( Params& params, bool run )
     params.ref_time();
     params.ref_gflops();
     params.ref_gbytes();
+    params.allocs();
 
     // adjust header to msec
     params.time.name( "time (ms)" );
@@ -48,6 +50,8 @@ void test_hemv_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( hemv, TA, TX, TY );
+
     // setup
     int64_t lda = roundup( n, align );
     size_t size_A = size_t(lda)*n;
@@ -72,12 +76,12 @@ void test_hemv_work( Params& params, bool run )
     real_t Ynorm = cblas_nrm2( n, y, std::abs(incy) );
 
     // test error exits
-    assert_throw( blas::hemv( Layout(0), uplo,     n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::hemv( layout,    Uplo(0),  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::hemv( layout,    uplo,    -1, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::hemv( layout,    uplo,     n, alpha, A, n-1, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::hemv( layout,    uplo,     n, alpha, A, lda, x,    0, beta, y, incy ), blas::Error );
-    assert_throw( blas::hemv( layout,    uplo,     n, alpha, A, lda, x, incx, beta, y,    0 ), blas::Error );
+    assert_throw( hemv( Layout(0), uplo,     n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( hemv( layout,    Uplo(0),  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( hemv( layout,    uplo,    -1, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( hemv( layout,    uplo,     n, alpha, A, n-1, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( hemv( layout,    uplo,     n, alpha, A, lda, x,    0, beta, y, incy ), blas::Error );
+    assert_throw( hemv( layout,    uplo,     n, alpha, A, lda, x, incx, beta, y,    0 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -99,9 +103,11 @@ void test_hemv_work( Params& params, bool run )
 
     // run test
     testsweeper::flush_cache( params.cache() );
+    int64_t allocs = blas::host_workspace_allocs();
     double time = get_wtime();
-    blas::hemv( layout, uplo, n, alpha, A, lda, x, incx, beta, y, incy );
+    hemv( layout, uplo, n, alpha, A, lda, x, incx, beta, y, incy );
     time = get_wtime() - time;
+    params.allocs() = blas::host_workspace_allocs() - allocs;
 
     double gflop = blas::Gflop< scalar_t >::hemv( n );
     double gbyte = blas::Gbyte< scalar_t >::hemv( n );
@@ -35,6 +35,7 @@ void test_her_work( Params& params, bool run )
     params.ref_time();
     params.ref_gflops();
     params.ref_gbytes();
+    params.allocs();
 
     // adjust header to msec
     params.time.name( "time (ms)" );
@@ -85,9 +86,11 @@ void test_her_work( Params& params, bool run )
 
     // run test
     testsweeper::flush_cache( params.cache() );
+    int64_t allocs = blas::host_workspace_allocs();
     double time = get_wtime();
     blas::her( layout, uplo, n, alpha, x, incx, A, lda );
     time = get_wtime() - time;
+    params.allocs() = blas::host_workspace_allocs() - allocs;
 
     double gflop = blas::Gflop< scalar_t >::her( n );
     double gbyte = blas::Gbyte< scalar_t >::her( n );
@@ -33,6 +33,7 @@ void test_her2k_work( Params& params, bool run )
     int64_t k       = params.dim.k();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -42,6 +43,8 @@ void test_her2k_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( her2k, TA, TB, TC );
+
     // setup
     int64_t Am = (trans == Op::NoTrans ? n : k);
     int64_t An = (trans == Op::NoTrans ? k : n);
@@ -72,33 +75,33 @@ void test_her2k_work( Params& params, bool run )
     real_t Cnorm = lapack_lansy( "f", uplo2str(uplo), n, C, ldc, work );
 
     // test error exits
-    assert_throw( blas::her2k( Layout(0), uplo,    trans,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( layout,    Uplo(0), trans,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( layout,    uplo,    Op(0),  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( layout,    uplo,    trans, -1,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( layout,    uplo,    trans,  n, -1, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout(0), uplo,    trans,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( layout,    Uplo(0), trans,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( layout,    uplo,    Op(0),  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( layout,    uplo,    trans, -1,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( layout,    uplo,    trans,  n, -1, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::her2k( Layout::ColMajor, uplo, Op::NoTrans,   n, k, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( Layout::ColMajor, uplo, Op::Trans,     n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( Layout::ColMajor, uplo, Op::ConjTrans, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::ColMajor, uplo, Op::NoTrans,   n, k, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::ColMajor, uplo, Op::Trans,     n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::ColMajor, uplo, Op::ConjTrans, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::her2k( Layout::RowMajor, uplo, Op::NoTrans,   n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( Layout::RowMajor, uplo, Op::Trans,     n, k, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( Layout::RowMajor, uplo, Op::ConjTrans, n, k, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::RowMajor, uplo, Op::NoTrans,   n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::RowMajor, uplo, Op::Trans,     n, k, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::RowMajor, uplo, Op::ConjTrans, n, k, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::her2k( Layout::ColMajor, uplo, Op::NoTrans,   n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( Layout::ColMajor, uplo, Op::Trans,     n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( Layout::ColMajor, uplo, Op::ConjTrans, n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::ColMajor, uplo, Op::NoTrans,   n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::ColMajor, uplo, Op::Trans,     n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::ColMajor, uplo, Op::ConjTrans, n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::her2k( Layout::RowMajor, uplo, Op::NoTrans,   n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( Layout::RowMajor, uplo, Op::Trans,     n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::her2k( Layout::RowMajor, uplo, Op::ConjTrans, n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::RowMajor, uplo, Op::NoTrans,   n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::RowMajor, uplo, Op::Trans,     n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( her2k( Layout::RowMajor, uplo, Op::ConjTrans, n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::her2k( layout,    uplo,    trans,  n,  k, alpha, A, lda, B, ldb, beta, C, n-1 ), blas::Error );
+    assert_throw( her2k( layout,    uplo,    trans,  n,  k, alpha, A, lda, B, ldb, beta, C, n-1 ), blas::Error );
 
     if (blas::is_complex<scalar_t>::value) {
         // complex her2k doesn't allow Trans, only ConjTrans
-        assert_throw( blas::her2k( layout, uplo, Op::Trans, n, k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+        assert_throw( her2k( layout, uplo, Op::Trans, n, k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
     }
 
     if (verbose >= 1) {
@@ -124,8 +127,8 @@ void test_her2k_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    blas::her2k( layout, uplo, trans, n, k,
-                 alpha, A, lda, B, ldb, beta, C, ldc );
+    her2k( layout, uplo, trans, n, k,
+           alpha, A, lda, B, ldb, beta, C, ldc );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::her2k( n, k );
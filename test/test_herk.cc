@@ -31,6 +31,7 @@ void test_herk_work( Params& params, bool run )
     int64_t k       = params.dim.k();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -40,6 +41,8 @@ void test_herk_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( herk, TA, TC );
+
     // setup
     int64_t Am = (trans == Op::NoTrans ? n : k);
     int64_t An = (trans == Op::NoTrans ? k : n);
@@ -65,25 +68,25 @@ void test_herk_work( Params& params, bool run )
     real_t Cnorm = lapack_lansy( "f", uplo2str(uplo), n, C, ldc, work );
 
     // test error exits
-    assert_throw( blas::herk( Layout(0), uplo,    trans,  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
-    assert_throw( blas::herk( layout,    Uplo(0), trans,  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
-    assert_throw( blas::herk( layout,    uplo,    Op(0),  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
-    assert_throw( blas::herk( layout,    uplo,    trans, -1,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
-    assert_throw( blas::herk( layout,    uplo,    trans,  n, -1, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( herk( Layout(0), uplo,    trans,  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( herk( layout,    Uplo(0), trans,  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( herk( layout,    uplo,    Op(0),  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( herk( layout,    uplo,    trans, -1,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( herk( layout,    uplo,    trans,  n, -1, alpha, A, lda, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::herk( Layout::ColMajor, uplo, Op::NoTrans,   n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::herk( Layout::ColMajor, uplo, Op::Trans,     n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::herk( Layout::ColMajor, uplo, Op::ConjTrans, n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( herk( Layout::ColMajor, uplo, Op::NoTrans,   n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( herk( Layout::ColMajor, uplo, Op::Trans,     n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( herk( Layout::ColMajor, uplo, Op::ConjTrans, n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::herk( Layout::RowMajor, uplo, Op::NoTrans,   n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::herk( Layout::RowMajor, uplo, Op::Trans,     n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::herk( Layout::RowMajor, uplo, Op::ConjTrans, n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( herk( Layout::RowMajor, uplo, Op::NoTrans,   n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( herk( Layout::RowMajor, uplo, Op::Trans,     n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( herk( Layout::RowMajor, uplo, Op::ConjTrans, n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::herk( layout,    uplo,    trans,  n,  k, alpha, A, lda, beta, C, n-1 ), blas::Error );
+    assert_throw( herk( layout,    uplo,    trans,  n,  k, alpha, A, lda, beta, C, n-1 ), blas::Error );
 
     if (blas::is_complex<scalar_t>::value) {
         // complex herk doesn't allow Trans, only ConjTrans
-        assert_throw( blas::herk( layout, uplo, Op::Trans, n, k, alpha, A, lda, beta, C, ldc ), blas::Error );
+        assert_throw( herk( layout, uplo, Op::Trans, n, k, alpha, A, lda, beta, C, ldc ), blas::Error );
     }
 
     if (verbose >= 1) {
@@ -104,8 +107,8 @@ void test_herk_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    blas::herk( layout, uplo, trans, n, k,
-                alpha, A, lda, beta, C, ldc );
+    herk( layout, uplo, trans, n, k,
+          alpha, A, lda, beta, C, ldc );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::herk( n, k );
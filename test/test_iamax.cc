@@ -9,6 +9,8 @@
 #include "blas/flops.hh"
 #include "print_matrix.hh"
 
+#include <algorithm>
+
 // -----------------------------------------------------------------------------
 template <typename T>
 void test_iamax_work( Params& params, bool run )
@@ -20,6 +22,7 @@ void test_iamax_work( Params& params, bool run )
     int64_t n       = params.dim.n();
     int64_t incx    = params.incx();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -36,6 +39,9 @@ void test_iamax_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( iamax, T );
+    generic_routine( amax, T );
+
     // setup
     size_t size_x = (n - 1) * std::abs(incx) + 1;
     T* x = new T[ size_x ];
@@ -45,9 +51,9 @@ void test_iamax_work( Params& params, bool run )
     lapack_larnv( idist, iseed, size_x, x );
 
     // test error exits
-    assert_throw( blas::iamax( -1, x, incx ), blas::Error );
-    assert_throw( blas::iamax(  n, x,    0 ), blas::Error );
-    assert_throw( blas::iamax(  n, x,   -1 ), blas::Error );
+    assert_throw( iamax( -1, x, incx ), blas::Error );
+    assert_throw( iamax(  n, x,    0 ), blas::Error );
+    assert_throw( iamax(  n, x,   -1 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -61,7 +67,7 @@ void test_iamax_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    int64_t result = blas::iamax( n, x, incx );
+    int64_t result = iamax( n, x, incx );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< T >::iamax( n );
@@ -93,8 +99,44 @@ void test_iamax_work( Params& params, bool run )
         real_t error = std::abs( ref - result );
         params.error() = error;
 
+        // amax must return the same index, and the entry there;
+        // with n = 0, index -1 and value 0
+        T value;
+        int64_t index = amax( n, x, incx, &value );
+        bool amax_okay = (index == result
+                          && (index < 0 || value == x[ index*incx ]));
+        index = amax( 0, x, incx, &value );
+        amax_okay = amax_okay && index == -1 && value == T( 0 );
+
+        // the template handles NaN as reference iamax does: a NaN x_0 is
+        // returned, later NaN are skipped; checked with all NaN, NaN x_0,
+        // and NaN in the middle against the reference loop. Vendor BLAS
+        // may differ, so only the template is checked.
+        bool nan_okay = true;
+        if (generic && n > 0) {
+            std::vector<T> xnan( size_x, T( nan("") ) );
+            nan_okay = iamax( n, xnan.data(), incx ) == 0
+                       && amax( n, xnan.data(), incx, &value ) == 0;
+
+            for (int64_t inan : { int64_t( 0 ), n/2 }) {
+                std::copy( x, x + size_x, xnan.begin() );
+                xnan[ inan*incx ] = T( nan("") );
+                int64_t expect = 0;
+                real_t amax_ref = blas::abs1( xnan[ 0 ] );
+                for (int64_t i = 1; i < n; ++i) {
+                    if (blas::abs1( xnan[ i*incx ] ) > amax_ref) {
+                        amax_ref = blas::abs1( xnan[ i*incx ] );
+                        expect = i;
+                    }
+                }
+                nan_okay = nan_okay
+                           && iamax( n, xnan.data(), incx ) == expect
+                           && amax( n, xnan.data(), incx, &value ) == expect;
+            }
+        }
+
         // iamax must be exact!
-        params.okay() = (error == 0);
+        params.okay() = (error == 0 && amax_okay && nan_okay);
     }
 
     delete[] x;
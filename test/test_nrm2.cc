@@ -14,6 +14,8 @@ template <typename T>
 void test_nrm2_work( Params& params, bool run )
 {
     using namespace testsweeper;
+    using std::real;
+    using std::imag;
     typedef T scalar_t;
     using real_t   = blas::real_type< T >;
 
@@ -21,6 +23,7 @@ void test_nrm2_work( Params& params, bool run )
     int64_t n       = params.dim.n();
     int64_t incx    = params.incx();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -28,6 +31,8 @@ void test_nrm2_work( Params& params, bool run )
     params.ref_time();
     params.ref_gflops();
     params.ref_gbytes();
+    params.error2();
+    params.error2.name( "scaled error" );
 
     // adjust header to msec
     params.time.name( "time (ms)" );
@@ -37,6 +42,8 @@ void test_nrm2_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( nrm2, T );
+
     // setup
     size_t size_x = (n - 1) * std::abs(incx) + 1;
     T* x = new T[ size_x ];
@@ -46,9 +53,9 @@ void test_nrm2_work( Params& params, bool run )
     lapack_larnv( idist, iseed, size_x, x );
 
     // test error exits
-    assert_throw( blas::nrm2( -1, x, incx ), blas::Error );
-    assert_throw( blas::nrm2(  n, x,    0 ), blas::Error );
-    assert_throw( blas::nrm2(  n, x,   -1 ), blas::Error );
+    assert_throw( nrm2( -1, x, incx ), blas::Error );
+    assert_throw( nrm2(  n, x,    0 ), blas::Error );
+    assert_throw( nrm2(  n, x,   -1 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -62,7 +69,7 @@ void test_nrm2_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    real_t result = blas::nrm2( n, x, incx );
+    real_t result = nrm2( n, x, incx );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< T >::nrm2( n );
@@ -98,9 +105,47 @@ void test_nrm2_work( Params& params, bool run )
             error /= 2*sqrt(2);
         }
 
+        // Entries near sqrt(max) and sqrt(min), whose squares overflow
+        // or underflow, and a mix of both. The reference is cblas nrm2 of x
+        // scaled by a power of 2 near max |x_i|, so scaling is exact.
+        real_t big  = 2 * std::sqrt( std::numeric_limits< real_t >::max() );
+        real_t tiny = std::sqrt( std::numeric_limits< real_t >::min() ) / 2;
+        T* xs = new T[ size_x ];
+        T* xr = new T[ size_x ];
+        real_t error2 = 0;
+        for (int icase = 0; icase < 3; ++icase) {
+            // 0: big, 1: tiny, 2: alternating big and tiny
+            real_t xmax = 0;
+            for (size_t i = 0; i < size_x; ++i) {
+                bool is_big = icase == 0 || (icase == 2 && i % 2 == 0);
+                xs[ i ] = x[ i ] * (is_big ? big : tiny);
+                xmax = std::max( xmax, std::max( std::abs( real( xs[ i ] ) ),
+                                                 std::abs( imag( xs[ i ] ) ) ) );
+            }
+            real_t scale = std::ldexp( real_t( 1 ), std::ilogb( xmax ) );
+            for (size_t i = 0; i < size_x; ++i)
+                xr[ i ] = xs[ i ] / scale;
+            real_t ref2    = scale * cblas_nrm2( n, xr, std::abs(incx) );
+            real_t result2 = nrm2( n, xs, incx );
+            if (verbose >= 1) {
+                printf( "case %d: result = %.4e, ref = %.4e\n",
+                        icase, result2, ref2 );
+            }
+            real_t err = std::abs( (ref2 - result2) / (sqrt(n+1) * ref2) );
+            error2 = std::max( error2, err );
+        }
+        delete[] xs;
+        delete[] xr;
+
+        // complex needs extra factor; see Higham, 2002, sec. 3.6.
+        if (blas::is_complex<scalar_t>::value) {
+            error2 /= 2*sqrt(2);
+        }
+
         real_t u = 0.5 * std::numeric_limits< real_t >::epsilon();
         params.error() = error;
-        params.okay() = (error < u);
+        params.error2() = error2;
+        params.okay() = (error < u && error2 < u);
     }
 
     delete[] x;
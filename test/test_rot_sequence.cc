@@ -0,0 +1,185 @@
+// Copyright (c) 2017-2022, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas_wrappers.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+// -----------------------------------------------------------------------------
+// TA is data A
+// TS is for sine, which can be real or complex
+// cosine is always real
+template <typename TA, typename TS>
+void test_rot_sequence_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using blas::Layout;
+    using blas::Side;
+    using real_t = blas::real_type< TA >;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Side side     = params.side();
+    Direction direction = params.direction();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.gbytes();
+    params.ref_time();
+    params.ref_gflops();
+    params.ref_gbytes();
+
+    // adjust header to msec
+    params.time.name( "time (ms)" );
+    params.ref_time.name( "ref time (ms)" );
+    params.ref_time.width( 13 );
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (layout == Layout::ColMajor ? m : n);
+    int64_t An = (layout == Layout::ColMajor ? n : m);
+    int64_t lda = roundup( Am, align );
+    size_t size_A = size_t(lda)*An;
+    TA* A    = new TA[ size_A ];
+    TA* Aref = new TA[ size_A ];
+
+    // k rotations, each on a pair of rows (left) or columns (right)
+    // of length len
+    int64_t dim = (side == Side::Left ? m : n);
+    int64_t len = (side == Side::Left ? n : m);
+    int64_t k = blas::max( dim - 1, int64_t( 0 ) );
+    real_t* c = new real_t[ blas::max( k, int64_t( 1 ) ) ];
+    TS*     s = new TS[ blas::max( k, int64_t( 1 ) ) ];
+
+    int64_t idist = 2;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_lacpy( "g", Am, An, A, lda, Aref, lda );
+
+    // Compute [c, s] to eliminate random data[1].
+    for (int64_t i = 0; i < k; ++i) {
+        TS data[ 2 ];
+        lapack_larnv( idist, iseed, 2, data );
+        blas::rotg( &data[0], &data[1], &c[ i ], &s[ i ] );
+    }
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+
+    // test error exits
+    assert_throw( blas::rot_sequence( Layout(0), side,    direction,      m,  n, c, s, A, lda ), blas::Error );
+    assert_throw( blas::rot_sequence( layout,    Side(0), direction,      m,  n, c, s, A, lda ), blas::Error );
+    assert_throw( blas::rot_sequence( layout,    side,    Direction(0),   m,  n, c, s, A, lda ), blas::Error );
+    assert_throw( blas::rot_sequence( layout,    side,    'x',            m,  n, c, s, A, lda ), blas::Error );
+    assert_throw( blas::rot_sequence( layout,    side,    direction,     -1,  n, c, s, A, lda ), blas::Error );
+    assert_throw( blas::rot_sequence( layout,    side,    direction,      m, -1, c, s, A, lda ), blas::Error );
+
+    assert_throw( blas::rot_sequence( Layout::ColMajor, side, direction, m, n, c, s, A, m-1 ), blas::Error );
+    assert_throw( blas::rot_sequence( Layout::RowMajor, side, direction, m, n, c, s, A, n-1 ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld, norm=%.2e\n"
+                "k=%5lld rotations\n",
+                llong( Am ), llong( An ), llong( lda ), llong( size_A ), Anorm,
+                llong( k ) );
+    }
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( Am, An, A, lda );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::rot_sequence( layout, side, direction, m, n, c, s, A, lda );
+    time = get_wtime() - time;
+
+    // each rotation is like a dot of length len; A is read and written once
+    double gflop = k * blas::Gflop< TA >::dot( len );
+    double gbyte = 2 * double( m ) * n * sizeof( TA ) * 1e-9;
+    params.time()   = time * 1000;  // msec
+    params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
+
+    if (verbose >= 2) {
+        printf( "A2 = " ); print_matrix( Am, An, A, lda );
+    }
+
+    if (params.check() == 'y') {
+        // run reference: k calls to rot, each a pass over 2 rows or columns
+        // Rows are stride lda in ColMajor; columns are stride lda in RowMajor.
+        bool strided = ((side == Side::Left) == (layout == Layout::ColMajor));
+        int64_t inc  = (strided ? lda : 1);
+        int64_t step = (strided ? 1 : lda);
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        for (int64_t q = 0; q < k; ++q) {
+            int64_t i = (direction == Direction::Forward ? q : k-1 - q);
+            cblas_rot( len, &Aref[ i*step ], inc, &Aref[ (i+1)*step ], inc,
+                       c[ i ], s[ i ] );
+        }
+        time = get_wtime() - time;
+
+        params.ref_time()   = time * 1000;  // msec
+        params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
+
+        if (verbose >= 2) {
+            printf( "Aref = " ); print_matrix( Am, An, Aref, lda );
+        }
+
+        // check error compared to reference
+        // A = P A or A P^T for dim-by-dim orthogonal P, ||P||_F = sqrt(dim).
+        // alpha=1, beta=0, C0norm=0
+        real_t Pnorm = sqrt( real_t( dim ) );
+        real_t error;
+        bool okay;
+        check_gemm( Am, An, dim, TA(1), TA(0), Anorm, Pnorm, real_t(0),
+                    Aref, lda, A, lda, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay;
+    }
+
+    delete[] A;
+    delete[] Aref;
+    delete[] c;
+    delete[] s;
+}
+
+// -----------------------------------------------------------------------------
+void test_rot_sequence( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_rot_sequence_work< float, float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_rot_sequence_work< double, double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_rot_sequence_work< std::complex<float>, std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_rot_sequence_work< std::complex<double>, std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
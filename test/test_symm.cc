@@ -33,6 +33,7 @@ void test_symm_work( Params& params, bool run )
     int64_t n       = params.dim.n();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -42,6 +43,8 @@ void test_symm_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( symm, TA, TB, TC );
+
     // setup
     int64_t An = (side == Side::Left ? m : n);
     int64_t Cm = m;
@@ -73,20 +76,20 @@ void test_symm_work( Params& params, bool run )
     real_t Cnorm = lapack_lange( "f", Cm, Cn, C, ldc, work );
 
     // test error exits
-    assert_throw( blas::symm( Layout(0), side,     uplo,     m,  n, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::symm( layout,    Side(0),  uplo,     m,  n, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::symm( layout,    side,     Uplo(0),  m,  n, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::symm( layout,    side,     uplo,    -1,  n, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::symm( layout,    side,     uplo,     m, -1, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( symm( Layout(0), side,     uplo,     m,  n, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( symm( layout,    Side(0),  uplo,     m,  n, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( symm( layout,    side,     Uplo(0),  m,  n, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( symm( layout,    side,     uplo,    -1,  n, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( symm( layout,    side,     uplo,     m, -1, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::symm( layout, Side::Left,  uplo,     m,  n, alpha, A, m-1, B, ldb, beta, C, ldc ), blas::Error );
-    assert_throw( blas::symm( layout, Side::Right, uplo,     m,  n, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( symm( layout, Side::Left,  uplo,     m,  n, alpha, A, m-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( symm( layout, Side::Right, uplo,     m,  n, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::symm( Layout::ColMajor, side, uplo,  m,  n, alpha, A, lda, B, m-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::symm( Layout::RowMajor, side, uplo,  m,  n, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( symm( Layout::ColMajor, side, uplo,  m,  n, alpha, A, lda, B, m-1, beta, C, ldc ), blas::Error );
+    assert_throw( symm( Layout::RowMajor, side, uplo,  m,  n, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::symm( Layout::ColMajor, side, uplo,  m,  n, alpha, A, lda, B, ldb, beta, C, m-1 ), blas::Error );
-    assert_throw( blas::symm( Layout::RowMajor, side, uplo,  m,  n, alpha, A, lda, B, ldb, beta, C, n-1 ), blas::Error );
+    assert_throw( symm( Layout::ColMajor, side, uplo,  m,  n, alpha, A, lda, B, ldb, beta, C, m-1 ), blas::Error );
+    assert_throw( symm( Layout::RowMajor, side, uplo,  m,  n, alpha, A, lda, B, ldb, beta, C, n-1 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -111,8 +114,8 @@ void test_symm_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    blas::symm( layout, side, uplo, m, n,
-                alpha, A, lda, B, ldb, beta, C, ldc );
+    symm( layout, side, uplo, m, n,
+          alpha, A, lda, B, ldb, beta, C, ldc );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::symm( side, m, n );
@@ -32,6 +32,7 @@ void test_symv_work( Params& params, bool run )
     int64_t incy    = params.incy();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -48,6 +49,8 @@ void test_symv_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( symv, TA, TX, TY );
+
     // setup
     int64_t lda = roundup( n, align );
     size_t size_A = size_t(lda)*n;
@@ -72,12 +75,12 @@ void test_symv_work( Params& params, bool run )
     real_t Ynorm = cblas_nrm2( n, y, std::abs(incy) );
 
     // test error exits
-    assert_throw( blas::symv( Layout(0), uplo,     n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::symv( layout,    Uplo(0),  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::symv( layout,    uplo,    -1, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::symv( layout,    uplo,     n, alpha, A, n-1, x, incx, beta, y, incy ), blas::Error );
-    assert_throw( blas::symv( layout,    uplo,     n, alpha, A, lda, x,    0, beta, y, incy ), blas::Error );
-    assert_throw( blas::symv( layout,    uplo,     n, alpha, A, lda, x, incx, beta, y,    0 ), blas::Error );
+    assert_throw( symv( Layout(0), uplo,     n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( symv( layout,    Uplo(0),  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( symv( layout,    uplo,    -1, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( symv( layout,    uplo,     n, alpha, A, n-1, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( symv( layout,    uplo,     n, alpha, A, lda, x,    0, beta, y, incy ), blas::Error );
+    assert_throw( symv( layout,    uplo,     n, alpha, A, lda, x, incx, beta, y,    0 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -100,7 +103,7 @@ void test_symv_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    blas::symv( layout, uplo, n, alpha, A, lda, x, incx, beta, y, incy );
+    symv( layout, uplo, n, alpha, A, lda, x, incx, beta, y, incy );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::symv( n );
@@ -33,6 +33,7 @@ void test_syrk_work( Params& params, bool run )
     int64_t k       = params.dim.k();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -42,6 +43,8 @@ void test_syrk_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( syrk, TA, TC );
+
     // setup
     int64_t Am = (trans == Op::NoTrans ? n : k);
     int64_t An = (trans == Op::NoTrans ? k : n);
@@ -67,25 +70,25 @@ void test_syrk_work( Params& params, bool run )
     real_t Cnorm = lapack_lansy( "f", uplo2str(uplo), n, C, ldc, work );
 
     // test error exits
-    assert_throw( blas::syrk( Layout(0), uplo,    trans,  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
-    assert_throw( blas::syrk( layout,    Uplo(0), trans,  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
-    assert_throw( blas::syrk( layout,    uplo,    Op(0),  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
-    assert_throw( blas::syrk( layout,    uplo,    trans, -1,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
-    assert_throw( blas::syrk( layout,    uplo,    trans,  n, -1, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( Layout(0), uplo,    trans,  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( layout,    Uplo(0), trans,  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( layout,    uplo,    Op(0),  n,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( layout,    uplo,    trans, -1,  k, alpha, A, lda, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( layout,    uplo,    trans,  n, -1, alpha, A, lda, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::syrk( Layout::ColMajor, uplo, Op::NoTrans,   n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::syrk( Layout::ColMajor, uplo, Op::Trans,     n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::syrk( Layout::ColMajor, uplo, Op::ConjTrans, n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( Layout::ColMajor, uplo, Op::NoTrans,   n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( Layout::ColMajor, uplo, Op::Trans,     n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( Layout::ColMajor, uplo, Op::ConjTrans, n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::syrk( Layout::RowMajor, uplo, Op::NoTrans,   n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::syrk( Layout::RowMajor, uplo, Op::Trans,     n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
-    assert_throw( blas::syrk( Layout::RowMajor, uplo, Op::ConjTrans, n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( Layout::RowMajor, uplo, Op::NoTrans,   n, k, alpha, A, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( Layout::RowMajor, uplo, Op::Trans,     n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( syrk( Layout::RowMajor, uplo, Op::ConjTrans, n, k, alpha, A, n-1, beta, C, ldc ), blas::Error );
 
-    assert_throw( blas::syrk( layout,    uplo,    trans,  n,  k, alpha, A, lda, beta, C, n-1 ), blas::Error );
+    assert_throw( syrk( layout,    uplo,    trans,  n,  k, alpha, A, lda, beta, C, n-1 ), blas::Error );
 
     if (blas::is_complex<scalar_t>::value) {
         // complex syrk doesn't allow ConjTrans, only Trans
-        assert_throw( blas::syrk( layout, uplo, Op::ConjTrans, n, k, alpha, A, lda, beta, C, ldc ), blas::Error );
+        assert_throw( syrk( layout, uplo, Op::ConjTrans, n, k, alpha, A, lda, beta, C, ldc ), blas::Error );
     }
 
     if (verbose >= 1) {
@@ -108,8 +111,8 @@ void test_syrk_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    blas::syrk( layout, uplo, trans, n, k,
-                alpha, A, lda, beta, C, ldc );
+    syrk( layout, uplo, trans, n, k,
+          alpha, A, lda, beta, C, ldc );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::syrk( n, k );
@@ -34,6 +34,7 @@ void test_trmm_work( Params& params, bool run )
     int64_t n       = params.dim.n();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -43,6 +44,8 @@ void test_trmm_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( trmm, TA, TB );
+
     // ----------
     // setup
     int64_t Am = (side == Side::Left ? m : n);
@@ -71,19 +74,19 @@ void test_trmm_work( Params& params, bool run )
     real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
 
     // test error exits
-    assert_throw( blas::trmm( Layout(0), side,    uplo,    trans, diag,     m,  n, alpha, A, lda, B, ldb ), blas::Error );
-    assert_throw( blas::trmm( layout,    Side(0), uplo,    trans, diag,     m,  n, alpha, A, lda, B, ldb ), blas::Error );
-    assert_throw( blas::trmm( layout,    side,    Uplo(0), trans, diag,     m,  n, alpha, A, lda, B, ldb ), blas::Error );
-    assert_throw( blas::trmm( layout,    side,    uplo,    Op(0), diag,     m,  n, alpha, A, lda, B, ldb ), blas::Error );
-    assert_throw( blas::trmm( layout,    side,    uplo,    trans, Diag(0),  m,  n, alpha, A, lda, B, ldb ), blas::Error );
-    assert_throw( blas::trmm( layout,    side,    uplo,    trans, diag,    -1,  n, alpha, A, lda, B, ldb ), blas::Error );
-    assert_throw( blas::trmm( layout,    side,    uplo,    trans, diag,     m, -1, alpha, A, lda, B, ldb ), blas::Error );
+    assert_throw( trmm( Layout(0), side,    uplo,    trans, diag,     m,  n, alpha, A, lda, B, ldb ), blas::Error );
+    assert_throw( trmm( layout,    Side(0), uplo,    trans, diag,     m,  n, alpha, A, lda, B, ldb ), blas::Error );
+    assert_throw( trmm( layout,    side,    Uplo(0), trans, diag,     m,  n, alpha, A, lda, B, ldb ), blas::Error );
+    assert_throw( trmm( layout,    side,    uplo,    Op(0), diag,     m,  n, alpha, A, lda, B, ldb ), blas::Error );
+    assert_throw( trmm( layout,    side,    uplo,    trans, Diag(0),  m,  n, alpha, A, lda, B, ldb ), blas::Error );
+    assert_throw( trmm( layout,    side,    uplo,    trans, diag,    -1,  n, alpha, A, lda, B, ldb ), blas::Error );
+    assert_throw( trmm( layout,    side,    uplo,    trans, diag,     m, -1, alpha, A, lda, B, ldb ), blas::Error );
 
-    assert_throw( blas::trmm( layout, Side::Left,  uplo,   trans, diag,     m,  n, alpha, A, m-1, B, ldb ), blas::Error );
-    assert_throw( blas::trmm( layout, Side::Right, uplo,   trans, diag,     m,  n, alpha, A, n-1, B, ldb ), blas::Error );
+    assert_throw( trmm( layout, Side::Left,  uplo,   trans, diag,     m,  n, alpha, A, m-1, B, ldb ), blas::Error );
+    assert_throw( trmm( layout, Side::Right, uplo,   trans, diag,     m,  n, alpha, A, n-1, B, ldb ), blas::Error );
 
-    assert_throw( blas::trmm( Layout::ColMajor, side, uplo, trans, diag,    m,  n, alpha, A, lda, B, m-1 ), blas::Error );
-    assert_throw( blas::trmm( Layout::RowMajor, side, uplo, trans, diag,    m,  n, alpha, A, lda, B, n-1 ), blas::Error );
+    assert_throw( trmm( Layout::ColMajor, side, uplo, trans, diag,    m,  n, alpha, A, lda, B, m-1 ), blas::Error );
+    assert_throw( trmm( Layout::RowMajor, side, uplo, trans, diag,    m,  n, alpha, A, lda, B, n-1 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -100,7 +103,7 @@ void test_trmm_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    blas::trmm( layout, side, uplo, trans, diag, m, n, alpha, A, lda, B, ldb );
+    trmm( layout, side, uplo, trans, diag, m, n, alpha, A, lda, B, ldb );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::trmm( side, m, n );
@@ -31,6 +31,7 @@ void test_trmv_work( Params& params, bool run )
     int64_t incx    = params.incx();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -47,6 +48,8 @@ void test_trmv_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( trmv, TA, TX );
+
     // ----------
     // setup
     int64_t lda = roundup( n, align );
@@ -69,13 +72,13 @@ void test_trmv_work( Params& params, bool run )
     real_t Xnorm = cblas_nrm2( n, x, std::abs(incx) );
 
     // test error exits
-    assert_throw( blas::trmv( Layout(0), uplo,    trans, diag,     n, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trmv( layout,    Uplo(0), trans, diag,     n, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trmv( layout,    uplo,    Op(0), diag,     n, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trmv( layout,    uplo,    trans, Diag(0),  n, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trmv( layout,    uplo,    trans, diag,    -1, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trmv( layout,    uplo,    trans, diag,     n, A, n-1, x, incx ), blas::Error );
-    assert_throw( blas::trmv( layout,    uplo,    trans, diag,     n, A, lda, x,    0 ), blas::Error );
+    assert_throw( trmv( Layout(0), uplo,    trans, diag,     n, A, lda, x, incx ), blas::Error );
+    assert_throw( trmv( layout,    Uplo(0), trans, diag,     n, A, lda, x, incx ), blas::Error );
+    assert_throw( trmv( layout,    uplo,    Op(0), diag,     n, A, lda, x, incx ), blas::Error );
+    assert_throw( trmv( layout,    uplo,    trans, Diag(0),  n, A, lda, x, incx ), blas::Error );
+    assert_throw( trmv( layout,    uplo,    trans, diag,    -1, A, lda, x, incx ), blas::Error );
+    assert_throw( trmv( layout,    uplo,    trans, diag,     n, A, n-1, x, incx ), blas::Error );
+    assert_throw( trmv( layout,    uplo,    trans, diag,     n, A, lda, x,    0 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -92,7 +95,7 @@ void test_trmv_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    blas::trmv( layout, uplo, trans, diag, n, A, lda, x, incx );
+    trmv( layout, uplo, trans, diag, n, A, lda, x, incx );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::trmv( n );
@@ -33,6 +33,7 @@ void test_trsv_work( Params& params, bool run )
     int64_t incx    = params.incx();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
+    bool generic    = params.generic() == 'y';
 
     // mark non-standard output values
     params.gflops();
@@ -49,6 +50,8 @@ void test_trsv_work( Params& params, bool run )
     if (! run)
         return;
 
+    generic_routine( trsv, TA, TX );
+
     // setup
     int64_t lda = roundup( n, align );
     size_t size_A = size_t(lda)*n;
@@ -101,13 +104,13 @@ void test_trsv_work( Params& params, bool run )
     }
 
     // test error exits
-    assert_throw( blas::trsv( Layout(0), uplo,    trans, diag,     n, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trsv( layout,    Uplo(0), trans, diag,     n, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trsv( layout,    uplo,    Op(0), diag,     n, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trsv( layout,    uplo,    trans, Diag(0),  n, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trsv( layout,    uplo,    trans, diag,    -1, A, lda, x, incx ), blas::Error );
-    assert_throw( blas::trsv( layout,    uplo,    trans, diag,     n, A, n-1, x, incx ), blas::Error );
-    assert_throw( blas::trsv( layout,    uplo,    trans, diag,     n, A, lda, x,    0 ), blas::Error );
+    assert_throw( trsv( Layout(0), uplo,    trans, diag,     n, A, lda, x, incx ), blas::Error );
+    assert_throw( trsv( layout,    Uplo(0), trans, diag,     n, A, lda, x, incx ), blas::Error );
+    assert_throw( trsv( layout,    uplo,    Op(0), diag,     n, A, lda, x, incx ), blas::Error );
+    assert_throw( trsv( layout,    uplo,    trans, Diag(0),  n, A, lda, x, incx ), blas::Error );
+    assert_throw( trsv( layout,    uplo,    trans, diag,    -1, A, lda, x, incx ), blas::Error );
+    assert_throw( trsv( layout,    uplo,    trans, diag,     n, A, n-1, x, incx ), blas::Error );
+    assert_throw( trsv( layout,    uplo,    trans, diag,     n, A, lda, x,    0 ), blas::Error );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -124,7 +127,7 @@ void test_trsv_work( Params& params, bool run )
     // run test
     testsweeper::flush_cache( params.cache() );
     double time = get_wtime();
-    blas::trsv( layout, uplo, trans, diag, n, A, lda, x, incx );
+    trsv( layout, uplo, trans, diag, n, A, lda, x, incx );
     time = get_wtime() - time;
 
     double gflop = blas::Gflop< scalar_t >::trsv( n );